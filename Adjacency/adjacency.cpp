@@ -30,6 +30,18 @@ Vertex *Adjacency::getVertex(int number)
     return this->v[number];
 }
 
+void Adjacency::replaceVertex(Vertex *oldVertex, Vertex *newVertex)
+{
+    if( this->v[ADJ_VERTEX_ONE] == oldVertex )
+        this->v[ADJ_VERTEX_ONE] = newVertex;
+    else if( this->v[ADJ_VERTEX_TWO] == oldVertex )
+        this->v[ADJ_VERTEX_TWO] = newVertex;
+    else {
+        cerr << "ERROR - Adjacency::replaceVertex" << endl;
+        exit(EXIT_FAILURE);        
+    }
+}
+
 Triangle *Adjacency::getTriangle(int number)
 {
     if(number != ADJ_TRIANGLE_ONE && number != ADJ_TRIANGLE_TWO)
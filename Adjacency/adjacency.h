@@ -20,7 +20,7 @@ public:
                    ADJ_SEG_NOT_TRI   (2) = is a segment, but not in the triangulation; */
     
     // Data members utilized in the Finite Volume Method and in Conjugate Gradiente Method.
-    mpfr::real<MPFR_BITS_PRECISION> coefficient; /**coeficient of conjugate gradient **/
+    realNumber coefficient; /**coeficient of conjugate gradient **/
     //
     // Methods
     //    
@@ -40,6 +40,12 @@ public:
      * @return Returns the vertex number (ADJ_VERTEX_ONE or ADJ_VERTEX_TWO).
      */
     Vertex *getVertex(int number);          
+    /**
+     * Replace the endpoint "oldVertex" for "newVertex", a copy of it at another address. The adjacency lists are not changed.
+     * @param oldVertex
+     * @param newVertex
+     */
+    void replaceVertex(Vertex *oldVertex, Vertex *newVertex);
     /**
      * Adds the triangle only if some pointer (attribute) is null.
      * @param triangle
@@ -1,29 +1,35 @@
 #include <cmath>
+#include <ctime>
+#include <pthread.h>
 #include "ConjugateGradient.h"
 #include "../Mesh/mesh.h"
+#include "../Real/reduction.h"
+#include "../Utils/performanceCounters.h"
+#include "sparseSystem.h"
 /*______________________________________________________________________________
                         FUNCTION conjugateGradient()
     Conjugate gradient method for symmetric positive definite matrix.
     The grid discretization matrix and all variables used in the conjugate gradient method are stored on the grid's Vertex, which improves performance.
 ______________________________________________________________________________*/
-int ConjugateGradient::solve( Vertex *firstVertex, int maxIterations, long double  *precision)
+int ConjugateGradient::solveClassic( Vertex *firstVertex, int maxIterations, long double  *precision, int criterion, ConjugateGradientHistory *history)
 {
     int numberOfIterations = 0;
-    mpfr::real<MPFR_BITS_PRECISION>  error = 0.0, // Norm of resídue b - Au after each iteration.
-                                     rTr,
-                                     r1Tr1,
-                                     dTAd,
-                                     alpha,
-                                     beta,
-		                     normError = 1.0;
+    realNumber  error = 0.0, // Norm of resídue b - Au after each iteration.
+                rTr,
+                r1Tr1,
+                dTAd,
+                alpha,
+                beta,
+		                     normError = 1.0,
+                tolerance;
     /* ========================================== Initial Computations ========================================== */
     /* Computes vector Ax
      * residue r = b - Au
      * scalar rTr = r^T * r
      * Sets initial search direction d
     */
+    Reduction<realNumber> sum, sumB; // Accurate sum of the dot products
     Vertex *iVertex = firstVertex;
-    rTr = 0.0;
     while ( iVertex != NULL )                      /* for all vertices */
     {
         if(iVertex->isBorder == false) // is not at the border 
@@ -47,18 +53,24 @@ int ConjugateGradient::solve( Vertex *firstVertex, int maxIterations, long doubl
             /* ========== d_0 = r_0 ========== */
             iVertex->d = iVertex->r;
             /* ======== rTr = r^T * r ======== */
-            rTr += iVertex->r * iVertex->r;
+            sum.add(iVertex->r * iVertex->r);
             if( fabs( iVertex->r ) > error )
                 error = fabs( iVertex->r );
+            if (criterion == CG_CRITERION_RELATIVE_RESIDUAL)
+                sumB.add(iVertex->b * iVertex->b);
         }
         iVertex = iVertex->next;
     }
+    rTr = sum.result();
+    tolerance = convergenceTolerance(criterion, precision, sumB.result());
+    recordResidual(history, rTr);
     /* ============================ Conjugate gradient iterations ============================ */
-    if( error >= (*precision) ) // Maximum precision which error must not exceed.
+    normError = error; // The update criterion starts with the infinit norm of the residue
+    if( !hasConverged(criterion, normError, rTr, tolerance) ) // Maximum precision which error must not exceed.
     {
-        while( ( normError >= (*precision) )   && ( numberOfIterations < maxIterations ) )  
+        while( !hasConverged(criterion, normError, rTr, tolerance) && ( numberOfIterations < maxIterations ) )  
         {
-            dTAd = 0.0;
+            sum.clear();
             iVertex = firstVertex;
             /* ================= CALCULATES THE PRODUCT Ad AND dTAd ================= */
             while ( iVertex != NULL )                   /* for all vertices */
@@ -78,10 +90,11 @@ int ConjugateGradient::solve( Vertex *firstVertex, int maxIterations, long doubl
                     }
                     /* ___________________________________________ */
                     /* ===== dTAd = d^T * Ad ===== */
-                    dTAd += iVertex->d * iVertex->Ad;
+                    sum.add(iVertex->d * iVertex->Ad);
                 }
                 iVertex = iVertex->next;
             }
+            dTAd = sum.result();
             /* ========== ALPHA = ( r^T*r )/( d^T * Ad) ========== */	    
             alpha = rTr/dTAd;
             /** **************** CALCULATES THE NEXT APROXIMATION OF SOLUTION ***************** **/
@@ -91,27 +104,32 @@ int ConjugateGradient::solve( Vertex *firstVertex, int maxIterations, long doubl
             {
                 if(iVertex->isBorder == false) // is not at the border 
 		{
-		    // Calculates infinit norm of error
-		    mpfr::real<MPFR_BITS_PRECISION>  normErrorTmp = abs( ( (iVertex->u + alpha * iVertex->d) - iVertex->u ) / (iVertex->u + alpha * iVertex->d) );
-		    if (  normErrorTmp > normError)
-		      normError = normErrorTmp; 
+		    if (criterion == CG_CRITERION_UPDATE)
+		    {
+		        // Calculates infinit norm of error
+		        realNumber  normErrorTmp = abs( ( (iVertex->u + alpha * iVertex->d) - iVertex->u ) / (iVertex->u + alpha * iVertex->d) );
+		        if (  normErrorTmp > normError)
+		          normError = normErrorTmp; 
+		    }
 		    // Calculates new aproximation of solution
                     iVertex->u += alpha * iVertex->d; // u = u + alpha . d
 		}
                 iVertex = iVertex->next;
             }
             iVertex = firstVertex;
-            r1Tr1 = 0.0;
+            sum.clear();
             /* ==============  CALCULATES THE NEXT RESIDUAL AND r1Tr1 = (r,r) ============== */
             while( iVertex != NULL )                       /* for all vertices */
             {
                 if(iVertex->isBorder == false) // is not at the border 
                 {
                     iVertex->r -= alpha * iVertex->Ad;        /* r(i+1) = r(i) - alpha * Ad */
-                    r1Tr1 += iVertex->r * iVertex->r;         /* r1Tr1T = r(i+1)^T * r(i+1) */
+                    sum.add(iVertex->r * iVertex->r);         /* r1Tr1T = r(i+1)^T * r(i+1) */
                 }
                 iVertex = iVertex->next;
             }
+            r1Tr1 = sum.result();
+            recordResidual(history, r1Tr1);
             /* ========== BETA = ( r(i+1)^T*r(i+1) )/( r(i)^T * r(i) ) ========== */
             beta = r1Tr1/rTr;
             rTr = r1Tr1;
@@ -121,7 +139,7 @@ int ConjugateGradient::solve( Vertex *firstVertex, int maxIterations, long doubl
             {
                 if(iVertex->isBorder == false) // is not at the border 
                 {
-                    mpfr::real<MPFR_BITS_PRECISION> d1 = iVertex->r + beta * iVertex->d; 
+                    realNumber d1 = iVertex->r + beta * iVertex->d; 
                     iVertex->d = d1;
                 }
                 iVertex = iVertex->next;
@@ -129,5 +147,1308 @@ int ConjugateGradient::solve( Vertex *firstVertex, int maxIterations, long doubl
             numberOfIterations++;                      
         }    
     }
+    recordIterations(history, numberOfIterations, hasConverged(criterion, normError, rTr, tolerance));
     return numberOfIterations;
-}
\ No newline at end of file
+}
+
+/*______________________________________________________________________________
+                        FUNCTION solveFused()
+    Conjugate gradient in the form of Chronopoulos and Gear: the product w = Ar and the two dot products
+    gamma = (r,r) and delta = (r,w) are computed in one sweep, and the updates of d, s = Ad, u and r in
+    a second sweep, instead of the four sweeps of conjugateGradient(). The vector s is updated by the
+    recurrence s = w + beta * s. On the grid's Vertex, w is stored in Au and s in Ad.
+______________________________________________________________________________*/
+int ConjugateGradient::solveFused( Vertex *firstVertex, int maxIterations, long double *precision, int criterion, ConjugateGradientHistory *history)
+{
+    int numberOfIterations = 0;
+    realNumber  error = 0.0, // Norm of resídue b - Au after each iteration.
+                gamma,
+                gammaOld = 0.0,
+                delta,
+                alpha = 0.0,
+                beta = 0.0,
+                normError = 1.0,
+                tolerance;
+    Reduction<realNumber> sumGamma, sumDelta, sumB; // Accurate sum of the dot products
+    /* ======== r_0 = b - Au_0 ======== */
+    Vertex *iVertex;
+    for (iVertex = firstVertex; iVertex != NULL; iVertex = iVertex->next)
+    {
+        if(iVertex->isBorder == false) // is not at the border 
+        {
+            iVertex->Au = iVertex->coefficient * iVertex->u;            
+            for(list<Adjacency *>::iterator it = iVertex->adjList.begin(); it != iVertex->adjList.end(); it++)  /* for all adjacent vertices */
+            {
+                Vertex *adjVertex = (*it)->getVertex(ADJ_VERTEX_ONE);
+                if(adjVertex == iVertex)
+                    adjVertex = (*it)->getVertex(ADJ_VERTEX_TWO);
+                if ( adjVertex->isBorder == false )  // is not at the border 
+                    iVertex->Au += (*it)->coefficient * adjVertex->u;
+            }
+            iVertex->r = iVertex->b - iVertex->Au;
+            sumGamma.add(iVertex->r * iVertex->r);
+            if( fabs( iVertex->r ) > error )
+                error = fabs( iVertex->r );
+            if (criterion == CG_CRITERION_RELATIVE_RESIDUAL)
+                sumB.add(iVertex->b * iVertex->b);
+        }
+    }
+    gamma = sumGamma.result();
+    tolerance = convergenceTolerance(criterion, precision, sumB.result());
+    normError = error; // The update criterion starts with the infinit norm of the residue
+    bool converged = hasConverged(criterion, normError, gamma, tolerance);
+    while( !converged && ( numberOfIterations < maxIterations ) )  
+    {
+        /* ============ First sweep: w = Ar, gamma = (r,r) and delta = (r,w) ============ */
+        sumGamma.clear();
+        sumDelta.clear();
+        for (iVertex = firstVertex; iVertex != NULL; iVertex = iVertex->next)
+        {
+            if(iVertex->isBorder == false) // is not at the border 
+            {
+                iVertex->Au = iVertex->coefficient * iVertex->r;
+                for(list<Adjacency *>::iterator it = iVertex->adjList.begin(); it != iVertex->adjList.end(); it++)  /* for all adjacent vertices */
+                {
+                    Vertex *adjVertex = (*it)->getVertex(ADJ_VERTEX_ONE);
+                    if( adjVertex == iVertex )
+                        adjVertex = (*it)->getVertex(ADJ_VERTEX_TWO);
+                    if(adjVertex->isBorder == false)   // is not at the border 
+                        iVertex->Au += (*it)->coefficient * adjVertex->r;
+                }
+                sumGamma.add(iVertex->r * iVertex->r);
+                sumDelta.add(iVertex->r * iVertex->Au);
+            }
+        }
+        gamma = sumGamma.result();
+        delta = sumDelta.result();
+        recordResidual(history, gamma);
+        // The residual criteria are tested as soon as gamma = (r,r) is known
+        if ( (criterion != CG_CRITERION_UPDATE) && hasConverged(criterion, normError, gamma, tolerance) )
+        {
+            converged = true;
+            break;
+        }
+        /* ============ alpha = gamma / (delta - beta * gamma / alpha_old), beta = gamma / gamma_old ============ */
+        if (numberOfIterations == 0)
+        {
+            beta = 0.0;
+            alpha = gamma / delta;
+        }
+        else
+        {
+            beta = gamma / gammaOld;
+            alpha = gamma / (delta - beta * gamma / alpha);
+        }
+        gammaOld = gamma;
+        /* ============ Second sweep: d = r + beta * d, s = w + beta * s, u = u + alpha * d, r = r - alpha * s ============ */
+        normError = 0.0;
+        for (iVertex = firstVertex; iVertex != NULL; iVertex = iVertex->next)
+        {
+            if(iVertex->isBorder == false) // is not at the border 
+            {
+                if (numberOfIterations == 0)
+                {
+                    iVertex->d = iVertex->r;
+                    iVertex->Ad = iVertex->Au;
+                }
+                else
+                {
+                    iVertex->d = iVertex->r + beta * iVertex->d;
+                    iVertex->Ad = iVertex->Au + beta * iVertex->Ad;
+                }
+                if (criterion == CG_CRITERION_UPDATE)
+                {
+                    // Calculates infinit norm of error
+                    realNumber  normErrorTmp = abs( ( (iVertex->u + alpha * iVertex->d) - iVertex->u ) / (iVertex->u + alpha * iVertex->d) );
+                    if (  normErrorTmp > normError)
+                        normError = normErrorTmp; 
+                }
+                iVertex->u += alpha * iVertex->d;
+                iVertex->r -= alpha * iVertex->Ad;
+            }
+        }
+        numberOfIterations++;                      
+        if (criterion == CG_CRITERION_UPDATE)
+            converged = hasConverged(criterion, normError, gamma, tolerance);
+    }
+    if ( (history != NULL) && ( (int) history->residualNorm.size() <= numberOfIterations ) )
+    {
+        // The residue of the last update was not computed by the iterations
+        sumGamma.clear();
+        for (iVertex = firstVertex; iVertex != NULL; iVertex = iVertex->next)
+        {
+            if(iVertex->isBorder == false) // is not at the border 
+                sumGamma.add(iVertex->r * iVertex->r);
+        }
+        recordResidual(history, sumGamma.result());
+    }
+    recordIterations(history, numberOfIterations, converged);
+    return numberOfIterations;
+}
+
+/*______________________________________________________________________________
+                        FUNCTION conjugateGradient() with runtime precision and method
+    Solves with selectSolver(), measuring the elapsed time, the CPU time of the calling thread and, if
+    history->countHardwareEvents, the hardware events.
+______________________________________________________________________________*/
+int ConjugateGradient::solve( Vertex *firstVertex, int maxIterations, long double *precision, ConjugateGradientParameters *parameters, ConjugateGradientHistory *history)
+{
+    struct timespec wallStart, wallEnd, cpuStart, cpuEnd;
+    PerformanceCounters *counters = NULL;
+    if (history != NULL)
+    {
+        history->clear();
+        if (history->countHardwareEvents)
+        {
+            counters = new PerformanceCounters();
+            counters->start();
+        }
+        clock_gettime(CLOCK_MONOTONIC, &wallStart);
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpuStart);
+    }
+    int numberOfIterations = selectSolver(firstVertex, maxIterations, precision, parameters, history);
+    if (history != NULL)
+    {
+        if (counters != NULL)
+        {
+            counters->stop();
+            history->cycles          = counters->getValue(PERFORMANCE_COUNTER_CYCLES);
+            history->instructions    = counters->getValue(PERFORMANCE_COUNTER_INSTRUCTIONS);
+            history->cacheReferences = counters->getValue(PERFORMANCE_COUNTER_CACHE_REFERENCES);
+            history->cacheMisses     = counters->getValue(PERFORMANCE_COUNTER_CACHE_MISSES);
+            delete counters;
+        }
+        clock_gettime(CLOCK_MONOTONIC, &wallEnd);
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpuEnd);
+        history->wallTime = (wallEnd.tv_sec - wallStart.tv_sec) + 1e-9 * (wallEnd.tv_nsec - wallStart.tv_nsec);
+        history->cpuTime  = (cpuEnd.tv_sec - cpuStart.tv_sec) + 1e-9 * (cpuEnd.tv_nsec - cpuStart.tv_nsec);
+    }
+    return numberOfIterations;
+}
+
+/*______________________________________________________________________________
+                        FUNCTION selectSolver()
+    Selects the working type of the conjugate gradient method by the number of bits of precision.
+______________________________________________________________________________*/
+int ConjugateGradient::selectSolver( Vertex *firstVertex, int maxIterations, long double *precision, ConjugateGradientParameters *parameters, ConjugateGradientHistory *history)
+{
+    int bitsPrecision = parameters->bitsPrecision;
+    if (bitsPrecision > 0 && bitsPrecision <= 53)
+    {
+        if (history != NULL)
+            history->bitsPrecision = 53;
+        return solveInPrecision<double>(firstVertex, maxIterations, precision, parameters, history);
+    }
+#if REAL_NUMBER_TYPE == REAL_NUMBER_MPFR
+    int bits = (bitsPrecision <= 128) ? 128 : (bitsPrecision <= 256) ? 256 : (bitsPrecision <= 512) ? 512 : 1024;
+    if (bitsPrecision > 1024)
+    {
+        cerr << "ERROR - ConjugateGradient::solve - precision of " << bitsPrecision << " bits is not supported (maximum 1024 bits)." << endl;
+        exit(EXIT_FAILURE);
+    }
+    if (bitsPrecision > 0 && bits != MPFR_BITS_PRECISION) // Other type than the mesh
+    {
+        if (history != NULL)
+            history->bitsPrecision = bits;
+        switch (bits)
+        {
+            case 128: return solveInPrecision< mpfr::real<128> >(firstVertex, maxIterations, precision, parameters, history);
+            case 256: return solveInPrecision< mpfr::real<256> >(firstVertex, maxIterations, precision, parameters, history);
+            case 512: return solveInPrecision< mpfr::real<512> >(firstVertex, maxIterations, precision, parameters, history);
+            default:  return solveInPrecision< mpfr::real<1024> >(firstVertex, maxIterations, precision, parameters, history);
+        }
+    }
+#else
+    if (bitsPrecision > REAL_NUMBER_BITS)
+    {
+        cerr << "ERROR - ConjugateGradient::solve - precision of " << bitsPrecision << " bits is not supported by the multiple-double backend (maximum "
+             << REAL_NUMBER_BITS << " bits, the precision of realNumber)." << endl;
+        exit(EXIT_FAILURE);
+    }
+#endif
+    if (history != NULL)
+        history->bitsPrecision = REAL_NUMBER_BITS;
+    // The pipelined, multigrid, Cholesky, deflated and Chebyshev methods need more vectors than the grid's Vertex stores
+    if (parameters->method != CG_METHOD_CLASSIC && parameters->method != CG_METHOD_FUSED)
+        return solveInPrecision<realNumber>(firstVertex, maxIterations, precision, parameters, history);
+    // In place on the grid's Vertex with realNumber (the multiple-double backends only support double or realNumber)
+    int numberOfIterations;
+    if (parameters->method == CG_METHOD_FUSED)
+        numberOfIterations = solveFused(firstVertex, maxIterations, precision, parameters->criterion, history);
+    else
+        numberOfIterations = solveClassic(firstVertex, maxIterations, precision, parameters->criterion, history);
+    if (history != NULL)
+    {
+        long n = 0, nonzeros = 0;
+        for (Vertex *iVertex = firstVertex; iVertex != NULL; iVertex = iVertex->next)
+        {
+            if(iVertex->isBorder == false) // is not at the border
+            {
+                n++;
+                for(list<Adjacency *>::iterator it = iVertex->adjList.begin(); it != iVertex->adjList.end(); it++)
+                {
+                    Vertex *adjVertex = (*it)->getVertex(ADJ_VERTEX_ONE);
+                    if(adjVertex == iVertex)
+                        adjVertex = (*it)->getVertex(ADJ_VERTEX_TWO);
+                    if ( adjVertex->isBorder == false )
+                        nonzeros++;
+                }
+            }
+        }
+        recordWork(history, parameters, n, nonzeros, 0.0, bytesOfReal(realNumber(0.0)));
+    }
+    return numberOfIterations;
+}
+
+/*______________________________________________________________________________
+                        FUNCTION convergenceTolerance()
+    Tolerance compared by hasConverged(): the precision itself for the update criterion, and the square of
+    the maximum residual norm for the residual criteria (so no square root is computed in the iterations).
+______________________________________________________________________________*/
+template <class T> T ConjugateGradient::convergenceTolerance( int criterion, long double *precision, const T &bTb)
+{
+    T epsilon = *precision;
+    if (criterion == CG_CRITERION_RELATIVE_RESIDUAL)
+        return epsilon * epsilon * bTb;
+    if (criterion == CG_CRITERION_ABSOLUTE_RESIDUAL)
+        return epsilon * epsilon;
+    return epsilon;
+}
+
+/*______________________________________________________________________________
+                        FUNCTION hasConverged()
+    Convergence test with quantities already computed by the iterations: the infinit norm of the relative
+    update (CG_CRITERION_UPDATE) or rTr = ||r||^2 (CG_CRITERION_RELATIVE_RESIDUAL, CG_CRITERION_ABSOLUTE_RESIDUAL).
+______________________________________________________________________________*/
+template <class T> bool ConjugateGradient::hasConverged( int criterion, const T &normError, const T &rTr, const T &tolerance)
+{
+    if (criterion == CG_CRITERION_UPDATE)
+        return normError < tolerance;
+    return rTr < tolerance;
+}
+
+/*______________________________________________________________________________
+                        FUNCTION recordResidual() and recordIterations()
+    Fill the history of the solve, if the caller asked for it.
+______________________________________________________________________________*/
+template <class T> void ConjugateGradient::recordResidual( ConjugateGradientHistory *history, const T &rTr)
+{
+    if (history != NULL)
+        history->residualNorm.push_back( sqrtl( toLongDouble(rTr) ) );
+}
+
+void ConjugateGradient::recordIterations( ConjugateGradientHistory *history, int numberOfIterations, bool converged)
+{
+    if (history != NULL)
+    {
+        history->numberOfIterations = numberOfIterations;
+        history->converged = converged;
+    }
+}
+
+/*______________________________________________________________________________
+                        FUNCTION recordWork()
+    Estimated cost of the iterations: a product by the matrix is n + nonzeros multiply-adds, reading the values,
+    the columns, the row starts and the vector and writing the result; a vector operation (dot product or update)
+    is n multiply-adds reading two vectors and writing one. The cost of one iteration of each method is counted
+    in these units; the setups (multigrid levels, factorizations, eigenvalue estimates) are not counted.
+______________________________________________________________________________*/
+void ConjugateGradient::recordWork( ConjugateGradientHistory *history, ConjugateGradientParameters *parameters, long n, long nonzeros, double preconditionerWork, int bytesPerReal)
+{
+    if (history == NULL)
+        return;
+    double products, vectorOperations, preconditioners = 0.0;
+    switch (parameters->method)
+    {
+        case CG_METHOD_FUSED:         products = 1.0; vectorOperations = 6.0; break;
+        case CG_METHOD_PIPELINED:     products = 1.0; vectorOperations = 8.0; break;
+        case CG_METHOD_MULTIGRID_PCG: products = 1.0; vectorOperations = 6.0; preconditioners = 1.0; break;
+        case CG_METHOD_MULTIGRID:     products = 1.0; vectorOperations = 1.0; preconditioners = 1.0; break;
+        case CG_METHOD_CHOLESKY:      products = 2.0; vectorOperations = 2.0; preconditioners = 1.0; break;
+        case CG_METHOD_DEFLATED:      products = 1.0; vectorOperations = 5.0 + 4.0 * parameters->deflationVectors; break;
+        case CG_METHOD_CHEBYSHEV:     products = 1.0; vectorOperations = 3.0; break;
+        case CG_METHOD_CHEBYSHEV_PCG: products = 1.0 + CHEBYSHEV_PRECONDITIONER_DEGREE; vectorOperations = 6.0 + 3.0 * CHEBYSHEV_PRECONDITIONER_DEGREE; break;
+        default:                      products = 1.0; vectorOperations = 5.0; break;
+    }
+    double iterations = history->numberOfIterations,
+           productWork = (double) n + nonzeros,
+           productBytes = productWork * bytesPerReal + (nonzeros + n + 1) * 4.0 + n * (double) bytesPerReal;
+    history->numberOfUnknowns = (int) n;
+    history->numberOfNonzeros = nonzeros;
+    history->flops = 2.0 * iterations * ( products * productWork + vectorOperations * n + preconditioners * preconditionerWork );
+    history->bytes = iterations * ( products * productBytes + vectorOperations * 3.0 * n * bytesPerReal
+                                    + preconditioners * preconditionerWork * (bytesPerReal + 4.0) );
+}
+
+/*______________________________________________________________________________
+                        FUNCTION solveInPrecision()
+    Same iterations of solveClassic(), solveFused(), the pipelined conjugate gradient, the multigrid methods,
+    the Cholesky factorization, the deflated conjugate gradient or the Chebyshev method, on a copy of the system in compressed sparse rows with the working type T.
+______________________________________________________________________________*/
+template <class T> int ConjugateGradient::solveInPrecision( Vertex *firstVertex, int maxIterations, long double *precision, ConjugateGradientParameters *parameters, ConjugateGradientHistory *history)
+{
+    SparseSystem<T> A(firstVertex);
+    int numberOfIterations;
+    if (parameters->method == CG_METHOD_PIPELINED)
+        numberOfIterations = pipelinedIterations(A, maxIterations, precision, parameters, history);
+    else if (parameters->method == CG_METHOD_CHOLESKY)
+        numberOfIterations = choleskyIterations(A, maxIterations, precision, parameters, history);
+    else if (parameters->method == CG_METHOD_DEFLATED)
+        numberOfIterations = deflatedIterations(A, maxIterations, precision, parameters, history);
+    else if (parameters->method == CG_METHOD_CHEBYSHEV || parameters->method == CG_METHOD_CHEBYSHEV_PCG)
+        numberOfIterations = chebyshevIterations(A, maxIterations, precision, parameters, history);
+    else if (parameters->method == CG_METHOD_MULTIGRID_PCG || parameters->method == CG_METHOD_MULTIGRID)
+    {
+        Multigrid<T> &multigrid = *getMultigrid(A, parameters, history);
+        if (parameters->method == CG_METHOD_MULTIGRID)
+            numberOfIterations = multigridIterations(A, maxIterations, precision, parameters->criterion, multigrid, history);
+        else
+            numberOfIterations = preconditionedIterations(A, maxIterations, precision, parameters->criterion, multigrid, history);
+    }
+    else if (parameters->method == CG_METHOD_FUSED)
+        numberOfIterations = fusedIterations(A, maxIterations, precision, parameters->criterion, history);
+    else
+        numberOfIterations = classicIterations(A, maxIterations, precision, parameters->criterion, history);
+    A.storeSolution();
+    if (history != NULL)
+    {
+        double preconditionerWork = 0.0;
+        Multigrid<T> *multigrid = dynamic_cast<Multigrid<T> *>(parameters->setup);
+        SparseCholesky<T> *cholesky = dynamic_cast<SparseCholesky<T> *>(parameters->setup);
+        if (multigrid != NULL && (parameters->method == CG_METHOD_MULTIGRID_PCG || parameters->method == CG_METHOD_MULTIGRID))
+            preconditionerWork = multigrid->getCycleWork();
+        else if (cholesky != NULL && parameters->method == CG_METHOD_CHOLESKY)
+            preconditionerWork = 2.0 * cholesky->getFactorSize() + A.n;
+        recordWork(history, parameters, A.n, (long) A.column.size(), preconditionerWork, bytesOfReal(A.diagonal.empty() ? T(0.0) : A.diagonal[0]));
+    }
+    return numberOfIterations;
+}
+
+/*______________________________________________________________________________
+                        FUNCTION classicIterations()
+    Iterations of solveClassic() on a system in compressed sparse rows.
+______________________________________________________________________________*/
+template <class T> int ConjugateGradient::classicIterations( SparseSystem<T> &A, int maxIterations, long double *precision, int criterion, ConjugateGradientHistory *history)
+{
+    int n = A.n, numberOfIterations = 0;
+    vector<T> &u = A.u, r(n), d(n), Ad(n);
+    T error = 0.0, rTr, r1Tr1, dTAd, alpha, beta, normError, tolerance;
+    Reduction<T> sum, sumB; // Accurate sum of the dot products
+    for (int i = 0; i < n; i++)
+    {
+        r[i] = A.b[i] - A.multiplyRow(u, i);  // r_0 = b - Au_0
+        d[i] = r[i];                          // d_0 = r_0
+        sum.add(r[i] * r[i]);
+        if( fabs( r[i] ) > error )
+            error = fabs( r[i] );
+        if (criterion == CG_CRITERION_RELATIVE_RESIDUAL)
+            sumB.add(A.b[i] * A.b[i]);
+    }
+    rTr = sum.result();
+    tolerance = convergenceTolerance(criterion, precision, sumB.result());
+    recordResidual(history, rTr);
+    normError = error; // The update criterion starts with the infinit norm of the residue
+    while( !hasConverged(criterion, normError, rTr, tolerance) && ( numberOfIterations < maxIterations ) )  
+    {
+        sum.clear();
+        for (int i = 0; i < n; i++)
+        {
+            Ad[i] = A.multiplyRow(d, i);
+            sum.add(d[i] * Ad[i]);
+        }
+        dTAd = sum.result();
+        alpha = rTr/dTAd;
+        normError = 0.0;
+        sum.clear();
+        for (int i = 0; i < n; i++)
+        {
+            if (criterion == CG_CRITERION_UPDATE)
+            {
+                // Calculates infinit norm of error
+                T normErrorTmp = fabs( ( (u[i] + alpha * d[i]) - u[i] ) / (u[i] + alpha * d[i]) );
+                if (  normErrorTmp > normError)
+                    normError = normErrorTmp; 
+            }
+            u[i] += alpha * d[i];       // u = u + alpha . d
+            r[i] -= alpha * Ad[i];      // r(i+1) = r(i) - alpha * Ad
+            sum.add(r[i] * r[i]);       // r1Tr1T = r(i+1)^T * r(i+1)
+        }
+        r1Tr1 = sum.result();
+        recordResidual(history, r1Tr1);
+        beta = r1Tr1/rTr;
+        rTr = r1Tr1;
+        for (int i = 0; i < n; i++)
+            d[i] = r[i] + beta * d[i];
+        numberOfIterations++;                      
+    }
+    recordIterations(history, numberOfIterations, hasConverged(criterion, normError, rTr, tolerance));
+    return numberOfIterations;
+}
+
+/*______________________________________________________________________________
+                        FUNCTION fusedIterations()
+    Iterations of solveFused() on a system in compressed sparse rows.
+______________________________________________________________________________*/
+template <class T> int ConjugateGradient::fusedIterations( SparseSystem<T> &A, int maxIterations, long double *precision, int criterion, ConjugateGradientHistory *history)
+{
+    int n = A.n, numberOfIterations = 0;
+    vector<T> &u = A.u, r(n), d(n), w(n), s(n);
+    T error = 0.0, gamma, gammaOld = 0.0, delta, alpha = 0.0, beta = 0.0, normError, tolerance;
+    Reduction<T> sumGamma, sumDelta, sumB; // Accurate sum of the dot products
+    for (int i = 0; i < n; i++)
+    {
+        r[i] = A.b[i] - A.multiplyRow(u, i);  // r_0 = b - Au_0
+        sumGamma.add(r[i] * r[i]);
+        if( fabs( r[i] ) > error )
+            error = fabs( r[i] );
+        if (criterion == CG_CRITERION_RELATIVE_RESIDUAL)
+            sumB.add(A.b[i] * A.b[i]);
+    }
+    gamma = sumGamma.result();
+    tolerance = convergenceTolerance(criterion, precision, sumB.result());
+    normError = error; // The update criterion starts with the infinit norm of the residue
+    bool converged = hasConverged(criterion, normError, gamma, tolerance);
+    while( !converged && ( numberOfIterations < maxIterations ) )  
+    {
+        // First sweep: w = Ar, gamma = (r,r) and delta = (r,w)
+        sumGamma.clear();
+        sumDelta.clear();
+        for (int i = 0; i < n; i++)
+        {
+            w[i] = A.multiplyRow(r, i);
+            sumGamma.add(r[i] * r[i]);
+            sumDelta.add(r[i] * w[i]);
+        }
+        gamma = sumGamma.result();
+        delta = sumDelta.result();
+        recordResidual(history, gamma);
+        // The residual criteria are tested as soon as gamma = (r,r) is known
+        if ( (criterion != CG_CRITERION_UPDATE) && hasConverged(criterion, normError, gamma, tolerance) )
+        {
+            converged = true;
+            break;
+        }
+        if (numberOfIterations == 0)
+        {
+            beta = 0.0;
+            alpha = gamma / delta;
+        }
+        else
+        {
+            beta = gamma / gammaOld;
+            alpha = gamma / (delta - beta * gamma / alpha);
+        }
+        gammaOld = gamma;
+        // Second sweep: d = r + beta * d, s = w + beta * s, u = u + alpha * d, r = r - alpha * s
+        normError = 0.0;
+        for (int i = 0; i < n; i++)
+        {
+            d[i] = (numberOfIterations == 0) ? r[i] : r[i] + beta * d[i];
+            s[i] = (numberOfIterations == 0) ? w[i] : w[i] + beta * s[i];
+            if (criterion == CG_CRITERION_UPDATE)
+            {
+                // Calculates infinit norm of error
+                T normErrorTmp = fabs( ( (u[i] + alpha * d[i]) - u[i] ) / (u[i] + alpha * d[i]) );
+                if (  normErrorTmp > normError)
+                    normError = normErrorTmp; 
+            }
+            u[i] += alpha * d[i];
+            r[i] -= alpha * s[i];
+        }
+        numberOfIterations++;                      
+        if (criterion == CG_CRITERION_UPDATE)
+            converged = hasConverged(criterion, normError, gamma, tolerance);
+    }
+    if ( (history != NULL) && ( (int) history->residualNorm.size() <= numberOfIterations ) )
+    {
+        // The residue of the last update was not computed by the iterations
+        sumGamma.clear();
+        for (int i = 0; i < n; i++)
+            sumGamma.add(r[i] * r[i]);
+        recordResidual(history, sumGamma.result());
+    }
+    recordIterations(history, numberOfIterations, converged);
+    return numberOfIterations;
+}
+
+/*______________________________________________________________________________
+                        CLASS PipelinedWorkspace
+    Vectors and scalars shared by the threads of pipelinedIterations(). The rows of the system are split in
+    contiguous blocks of whole chunks of REDUCTION_CHUNK_SIZE rows, one per thread; each thread keeps the partial
+    dot products and the partial error norm of its block, combined in the order of the blocks, so the dot
+    products are the same with any number of threads.
+______________________________________________________________________________*/
+template <class T> class PipelinedWorkspace
+{
+public:
+    SparseSystem<T> *A;
+    int numberOfThreads, maxIterations, numberOfIterations, criterion;
+    ConjugateGradientHistory *history;
+    bool stop, converged;
+    vector<T> r, w, q, z, s, p;
+    vector<T> normErrorPartial;                  /**< Infinit norm of error of each block */
+    vector< Reduction<T> > gammaPartial, deltaPartial; /**< Dot products (r,r) and (w,r) of each block */
+    T alpha, beta, gammaOld, gammaFloor, tolerance;
+    pthread_barrier_t barrier;
+};
+
+/**
+ * Argument of pipelinedWorker(): workspace and number of the thread.
+ */
+template <class T> class PipelinedWorkerArgument
+{
+public:
+    PipelinedWorkspace<T> *workspace;
+    int thread;
+};
+
+/*______________________________________________________________________________
+                        FUNCTION pipelinedWorker()
+    Iterations of the pipelined conjugate gradient on the block of rows of a thread.
+______________________________________________________________________________*/
+template <class T> void *ConjugateGradient::pipelinedWorker(void *argument)
+{
+    PipelinedWorkerArgument<T> *arg = (PipelinedWorkerArgument<T> *) argument;
+    PipelinedWorkspace<T> &ws = *(arg->workspace);
+    SparseSystem<T> &A = *(ws.A);
+    int t = arg->thread,
+        first = reductionBlockBoundary(A.n, t, ws.numberOfThreads),    // Blocks of whole chunks of the reductions:
+        last  = reductionBlockBoundary(A.n, t + 1, ws.numberOfThreads); // the sums do not depend on the threads
+    vector<T> &u = A.u, &r = ws.r, &w = ws.w, &q = ws.q, &z = ws.z, &s = ws.s, &p = ws.p;
+    for (int iteration = 0; ; iteration++)
+    {
+        // Single reduction gamma = (r,r), delta = (w,r), overlapped with the product q = Aw
+        ws.gammaPartial[t].clear();
+        ws.deltaPartial[t].clear();
+        for (int i = first; i < last; i++)
+        {
+            ws.gammaPartial[t].add(r[i] * r[i]);
+            ws.deltaPartial[t].add(w[i] * r[i]);
+            q[i] = A.multiplyRow(w, i);
+        }
+        ws.gammaPartial[t].reduce(); // Partial sums of the block, in parallel
+        ws.deltaPartial[t].reduce();
+        pthread_barrier_wait(&ws.barrier);
+        if (t == 0)
+        {
+            T normError = 0.0;
+            for (int k = 0; k < ws.numberOfThreads; k++)
+            {
+                if (ws.normErrorPartial[k] > normError)
+                    normError = ws.normErrorPartial[k];
+            }
+            Reduction<T> sumGamma, sumDelta;
+            for (int k = 0; k < ws.numberOfThreads; k++)
+            {
+                sumGamma.merge(ws.gammaPartial[k]);
+                sumDelta.merge(ws.deltaPartial[k]);
+            }
+            T gamma = sumGamma.result(), delta = sumDelta.result();
+            recordResidual(ws.history, gamma);
+            if (iteration == 0)
+                ws.gammaFloor = gamma * (100 * machineEpsilon(gamma)) * (100 * machineEpsilon(gamma));
+            ws.converged = ( (iteration > 0) || (ws.criterion != CG_CRITERION_UPDATE) ) && 
+                           hasConverged(ws.criterion, normError, gamma, ws.tolerance);
+            // Stops also, not converged, when the residual reaches the attainable accuracy of the working type, after
+            // that the recurrences of the pipelined method only amplify rounding errors
+            bool stagnated = (iteration > 0) && (gamma <= ws.gammaFloor);
+            ws.stop = ws.converged || stagnated || (iteration >= ws.maxIterations);
+            if (!ws.stop)
+            {
+                if (iteration == 0)
+                {
+                    ws.beta = 0.0;
+                    ws.alpha = gamma / delta;
+                }
+                else
+                {
+                    ws.beta = gamma / ws.gammaOld;
+                    ws.alpha = gamma / (delta - ws.beta * gamma / ws.alpha);
+                }
+                ws.gammaOld = gamma;
+                ws.numberOfIterations = iteration + 1;
+            }
+        }
+        pthread_barrier_wait(&ws.barrier);
+        if (ws.stop)
+            break;
+        // Updates z = q + beta * z, s = w + beta * s, p = r + beta * p, u, r = r - alpha * s and w = w - alpha * z
+        T alpha = ws.alpha, beta = ws.beta, normError = 0.0;
+        for (int i = first; i < last; i++)
+        {
+            z[i] = (iteration == 0) ? q[i] : q[i] + beta * z[i];
+            s[i] = (iteration == 0) ? w[i] : w[i] + beta * s[i];
+            p[i] = (iteration == 0) ? r[i] : r[i] + beta * p[i];
+            if (ws.criterion == CG_CRITERION_UPDATE)
+            {
+                // Calculates infinit norm of error
+                T normErrorTmp = fabs( ( (u[i] + alpha * p[i]) - u[i] ) / (u[i] + alpha * p[i]) );
+                if (  normErrorTmp > normError)
+                    normError = normErrorTmp; 
+            }
+            u[i] += alpha * p[i];
+            r[i] -= alpha * s[i];
+            w[i] -= alpha * z[i];
+        }
+        ws.normErrorPartial[t] = normError;
+        pthread_barrier_wait(&ws.barrier);
+        // Residual replacement: the recurrences of r, w, s and z drift from their definitions in low precision
+        if ( (iteration + 1) % CG_PIPELINED_REPLACEMENT_PERIOD == 0 )
+        {
+            for (int i = first; i < last; i++)
+            {
+                r[i] = A.b[i] - A.multiplyRow(u, i);
+                s[i] = A.multiplyRow(p, i);
+            }
+            pthread_barrier_wait(&ws.barrier);
+            for (int i = first; i < last; i++)
+            {
+                w[i] = A.multiplyRow(r, i);
+                z[i] = A.multiplyRow(s, i);
+            }
+            pthread_barrier_wait(&ws.barrier);
+        }
+    }
+    return NULL;
+}
+
+/*______________________________________________________________________________
+                        FUNCTION pipelinedIterations()
+    Pipelined conjugate gradient of Ghysels and Vanroose on a system in compressed sparse rows. The two dot
+    products of an iteration are computed in one reduction, in the same sweep of the product q = Aw (which does
+    not depend on them), so a thread waits only once per iteration for the others. The rows are split among
+    numberOfThreads threads.
+______________________________________________________________________________*/
+template <class T> int ConjugateGradient::pipelinedIterations( SparseSystem<T> &A, int maxIterations, long double *precision, ConjugateGradientParameters *parameters, ConjugateGradientHistory *history)
+{
+    int n = A.n, numberOfThreads = parameters->numberOfThreads;
+    PipelinedWorkspace<T> ws;
+    Reduction<T> sumB;
+    T error = 0.0;
+    ws.r.resize(n);
+    for (int i = 0; i < n; i++)
+    {
+        ws.r[i] = A.b[i] - A.multiplyRow(A.u, i);  // r_0 = b - Au_0
+        if( fabs( ws.r[i] ) > error )
+            error = fabs( ws.r[i] );
+        if (parameters->criterion == CG_CRITERION_RELATIVE_RESIDUAL)
+            sumB.add(A.b[i] * A.b[i]);
+    }
+    ws.tolerance = convergenceTolerance(parameters->criterion, precision, sumB.result());
+    if( (parameters->criterion == CG_CRITERION_UPDATE) && (error < ws.tolerance) ) // Maximum precision which error must not exceed.
+    {
+        Reduction<T> sum;
+        for (int i = 0; i < n; i++)
+            sum.add(ws.r[i] * ws.r[i]);
+        recordResidual(history, sum.result());
+        recordIterations(history, 0, true);
+        return 0;
+    }
+    if (numberOfThreads < 1)
+        numberOfThreads = 1;
+    if (numberOfThreads > n)
+        numberOfThreads = (n > 0) ? n : 1;
+    ws.A = &A;
+    ws.numberOfThreads = numberOfThreads;
+    ws.maxIterations = maxIterations;
+    ws.numberOfIterations = 0;
+    ws.criterion = parameters->criterion;
+    ws.history = history;
+    ws.stop = false;
+    ws.converged = false;
+    ws.w.resize(n);
+    ws.q.resize(n);
+    ws.z.resize(n);
+    ws.s.resize(n);
+    ws.p.resize(n);
+    for (int i = 0; i < n; i++)
+        ws.w[i] = A.multiplyRow(ws.r, i);        // w_0 = Ar_0
+    ws.normErrorPartial.assign(numberOfThreads, T(0.0));
+    ws.gammaPartial.resize(numberOfThreads);
+    ws.deltaPartial.resize(numberOfThreads);
+    pthread_barrier_init(&ws.barrier, NULL, numberOfThreads);
+    vector< PipelinedWorkerArgument<T> > arguments(numberOfThreads);
+    vector<pthread_t> threads(numberOfThreads);
+    for (int t = 0; t < numberOfThreads; t++)
+    {
+        arguments[t].workspace = &ws;
+        arguments[t].thread = t;
+    }
+    for (int t = 1; t < numberOfThreads; t++)
+    {
+        if (pthread_create(&threads[t], NULL, &ConjugateGradient::pipelinedWorker<T>, (void *) &arguments[t]) != 0)
+        {
+            cerr << "ERROR - ConjugateGradient::pipelinedIterations - could not create thread " << t << "." << endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+    pipelinedWorker<T>( (void *) &arguments[0] );
+    for (int t = 1; t < numberOfThreads; t++)
+        pthread_join(threads[t], NULL);
+    pthread_barrier_destroy(&ws.barrier);
+    recordIterations(history, ws.numberOfIterations, ws.converged);
+    return ws.numberOfIterations;
+}
+
+/*______________________________________________________________________________
+                        CLASS ChebyshevWorkspace
+    Vectors and scalars shared by the threads of chebyshevIterations(). As in pipelinedIterations(), the rows
+    are split in contiguous blocks, one per thread, but the threads only combine their partial sums every
+    CHEBYSHEV_CHECK_PERIOD iterations, for the convergence test.
+______________________________________________________________________________*/
+template <class T> class ChebyshevWorkspace
+{
+public:
+    SparseSystem<T> *A;
+    Chebyshev< T, SparseSystem<T> > *chebyshev;
+    int numberOfThreads, maxIterations, numberOfIterations, criterion;
+    ConjugateGradientHistory *history;
+    bool stop, converged;
+    vector<T> normErrorPartial;             /**< Infinit norm of error of each block */
+    vector< Reduction<T> > residualPartial; /**< Dot product (r,r) of each block */
+    T rho, tolerance;
+    pthread_barrier_t barrier;
+};
+
+/**
+ * Argument of chebyshevWorker(): workspace and number of the thread.
+ */
+template <class T> class ChebyshevWorkerArgument
+{
+public:
+    ChebyshevWorkspace<T> *workspace;
+    int thread;
+};
+
+/*______________________________________________________________________________
+                        FUNCTION chebyshevWorker()
+    Chebyshev iterations on the block of rows of a thread: one barrier per iteration, and the residual
+    of the block (replaced by b - Au) is reduced only every CHEBYSHEV_CHECK_PERIOD iterations.
+______________________________________________________________________________*/
+template <class T> void *ConjugateGradient::chebyshevWorker(void *argument)
+{
+    ChebyshevWorkerArgument<T> *arg = (ChebyshevWorkerArgument<T> *) argument;
+    ChebyshevWorkspace<T> &ws = *(arg->workspace);
+    SparseSystem<T> &A = *(ws.A);
+    Chebyshev< T, SparseSystem<T> > &chebyshev = *(ws.chebyshev);
+    int t = arg->thread,
+        first = reductionBlockBoundary(A.n, t, ws.numberOfThreads),    // Blocks of whole chunks of the reductions:
+        last  = reductionBlockBoundary(A.n, t + 1, ws.numberOfThreads); // the sums do not depend on the threads
+    vector<T> &u = A.u, &r = chebyshev.getResidual();
+    T rho = ws.rho; // Each thread follows the same sequence of coefficients
+    for (int iteration = 0; ; iteration++)
+    {
+        bool check = ( (iteration + 1) % CHEBYSHEV_CHECK_PERIOD == 0 ) || ( iteration + 1 >= ws.maxIterations );
+        if (check && ws.criterion == CG_CRITERION_UPDATE)
+        {
+            const vector<T> &d = chebyshev.getDirection(iteration);
+            T normError = 0.0;
+            for (int i = first; i < last; i++)
+            {
+                // Calculates infinit norm of error
+                T normErrorTmp = fabs( ( (u[i] + d[i]) - u[i] ) / (u[i] + d[i]) );
+                if (  normErrorTmp > normError)
+                    normError = normErrorTmp;
+            }
+            ws.normErrorPartial[t] = normError;
+        }
+        chebyshev.step(u, first, last, iteration, rho);
+        pthread_barrier_wait(&ws.barrier);
+        if (!check)
+            continue;
+        chebyshev.replaceResidual(u, A.b, first, last);
+        ws.residualPartial[t].clear();
+        for (int i = first; i < last; i++)
+            ws.residualPartial[t].add(r[i] * r[i]);
+        ws.residualPartial[t].reduce(); // Partial sum of the block, in parallel
+        pthread_barrier_wait(&ws.barrier);
+        if (t == 0)
+        {
+            T normError = 0.0;
+            Reduction<T> sum;
+            for (int k = 0; k < ws.numberOfThreads; k++)
+            {
+                if (ws.normErrorPartial[k] > normError)
+                    normError = ws.normErrorPartial[k];
+                sum.merge(ws.residualPartial[k]);
+            }
+            T rTr = sum.result();
+            recordResidual(ws.history, rTr);
+            ws.numberOfIterations = iteration + 1;
+            ws.converged = hasConverged(ws.criterion, normError, rTr, ws.tolerance);
+            ws.stop = ws.converged || (iteration + 1 >= ws.maxIterations);
+        }
+        pthread_barrier_wait(&ws.barrier);
+        if (ws.stop)
+            break;
+    }
+    return NULL;
+}
+
+/*______________________________________________________________________________
+                        FUNCTION chebyshevIterations()
+    Chebyshev method preconditioned by the diagonal. The interval of the eigenvalues of D^-1 A comes from the
+    Gershgorin discs and CHEBYSHEV_LANCZOS_STEPS steps of the conjugate gradient from the initial residual;
+    after that the iterations compute no inner products, except the residual norm of the convergence test
+    every CHEBYSHEV_CHECK_PERIOD iterations (the history has one residual per test). The rows are split
+    among parameters->numberOfThreads threads. With CG_METHOD_CHEBYSHEV_PCG, the Chebyshev polynomial
+    preconditions the conjugate gradient instead.
+______________________________________________________________________________*/
+template <class T> int ConjugateGradient::chebyshevIterations( SparseSystem<T> &A, int maxIterations, long double *precision, ConjugateGradientParameters *parameters, ConjugateGradientHistory *history)
+{
+    int n = A.n, numberOfThreads = parameters->numberOfThreads;
+    Chebyshev< T, SparseSystem<T> > chebyshev(&A);
+    vector<T> r(n);
+    T error = 0.0;
+    Reduction<T> sum, sumB;
+    for (int i = 0; i < n; i++)
+    {
+        r[i] = A.b[i] - A.multiplyRow(A.u, i);  // r_0 = b - Au_0
+        sum.add(r[i] * r[i]);
+        if( fabs( r[i] ) > error )
+            error = fabs( r[i] );
+        if (parameters->criterion == CG_CRITERION_RELATIVE_RESIDUAL)
+            sumB.add(A.b[i] * A.b[i]);
+    }
+    T rTr = sum.result(), tolerance = convergenceTolerance(parameters->criterion, precision, sumB.result());
+    if (hasConverged(parameters->criterion, error, rTr, tolerance) || maxIterations <= 0)
+    {
+        recordResidual(history, rTr);
+        recordIterations(history, 0, hasConverged(parameters->criterion, error, rTr, tolerance));
+        return 0;
+    }
+    chebyshev.estimateMinimum(r, CHEBYSHEV_LANCZOS_STEPS);
+    if (parameters->method == CG_METHOD_CHEBYSHEV_PCG)
+        return preconditionedIterations(A, maxIterations, precision, parameters->criterion, chebyshev, history);
+    recordResidual(history, rTr);
+    if (numberOfThreads < 1)
+        numberOfThreads = 1;
+    if (numberOfThreads > n)
+        numberOfThreads = (n > 0) ? n : 1;
+    ChebyshevWorkspace<T> ws;
+    ws.A = &A;
+    ws.chebyshev = &chebyshev;
+    ws.numberOfThreads = numberOfThreads;
+    ws.maxIterations = maxIterations;
+    ws.numberOfIterations = 0;
+    ws.criterion = parameters->criterion;
+    ws.history = history;
+    ws.stop = false;
+    ws.converged = false;
+    ws.tolerance = tolerance;
+    ws.rho = chebyshev.start(A.u, A.b);
+    ws.normErrorPartial.assign(numberOfThreads, T(0.0));
+    ws.residualPartial.resize(numberOfThreads);
+    pthread_barrier_init(&ws.barrier, NULL, numberOfThreads);
+    vector< ChebyshevWorkerArgument<T> > arguments(numberOfThreads);
+    vector<pthread_t> threads(numberOfThreads);
+    for (int t = 0; t < numberOfThreads; t++)
+    {
+        arguments[t].workspace = &ws;
+        arguments[t].thread = t;
+    }
+    for (int t = 1; t < numberOfThreads; t++)
+    {
+        if (pthread_create(&threads[t], NULL, &ConjugateGradient::chebyshevWorker<T>, (void *) &arguments[t]) != 0)
+        {
+            cerr << "ERROR - ConjugateGradient::chebyshevIterations - could not create thread " << t << "." << endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+    chebyshevWorker<T>( (void *) &arguments[0] );
+    for (int t = 1; t < numberOfThreads; t++)
+        pthread_join(threads[t], NULL);
+    pthread_barrier_destroy(&ws.barrier);
+    recordIterations(history, ws.numberOfIterations, ws.converged);
+    return ws.numberOfIterations;
+}
+
+/*______________________________________________________________________________
+                        FUNCTION getMultigrid()
+    The levels of the previous solve are kept in parameters->setup. While the vertices and the edges
+    of the system are the same (for instance between time steps without refinement or flips), only the
+    values of the levels are recomputed.
+______________________________________________________________________________*/
+template <class T> Multigrid<T> *ConjugateGradient::getMultigrid( SparseSystem<T> &A, ConjugateGradientParameters *parameters, ConjugateGradientHistory *history)
+{
+    Multigrid<T> *multigrid = dynamic_cast<Multigrid<T> *>(parameters->setup);
+    if (multigrid != NULL && multigrid->hasOptions(parameters->multigridCycle, parameters->multigridCoarsening, parameters->multigridSmoother) && multigrid->update(A))
+    {
+        if (history != NULL)
+            history->setupReused = true;
+        return multigrid;
+    }
+    delete parameters->setup;
+    multigrid = new Multigrid<T>(A, parameters->multigridCycle, parameters->multigridCoarsening, parameters->multigridSmoother);
+    parameters->setup = multigrid;
+    return multigrid;
+}
+
+/*______________________________________________________________________________
+                        FUNCTION getCholesky()
+    The factor of the previous solve is kept in parameters->setup. While the vertices and the edges of the
+    system are the same, the symbolic analysis is reused and the coefficients are compared: the numeric
+    factorization is repeated by choleskyIterations() only if they changed.
+______________________________________________________________________________*/
+template <class T> SparseCholesky<T> *ConjugateGradient::getCholesky( SparseSystem<T> &A, ConjugateGradientParameters *parameters, ConjugateGradientHistory *history)
+{
+    SparseCholesky<T> *cholesky = dynamic_cast<SparseCholesky<T> *>(parameters->setup);
+    if (cholesky != NULL && cholesky->setValues(A))
+    {
+        if (history != NULL)
+            history->setupReused = true;
+        return cholesky;
+    }
+    delete parameters->setup;
+    cholesky = new SparseCholesky<T>(A);
+    parameters->setup = cholesky;
+    return cholesky;
+}
+
+/*______________________________________________________________________________
+                        FUNCTION choleskyIterations()
+    Direct solve with the factor of the current coefficients, counted as one iteration. With
+    parameters->keepFactor, an outdated factor (older coefficients, same sparsity) preconditions the
+    conjugate gradient instead, and it is refactored with the current coefficients when the conjugate
+    gradient needs more than CHOLESKY_REFACTOR_ITERATIONS iterations.
+______________________________________________________________________________*/
+template <class T> int ConjugateGradient::choleskyIterations( SparseSystem<T> &A, int maxIterations, long double *precision, ConjugateGradientParameters *parameters, ConjugateGradientHistory *history)
+{
+    SparseCholesky<T> *cholesky = getCholesky(A, parameters, history);
+    if (!cholesky->isCurrent() && parameters->keepFactor)
+    {
+        int numberOfIterations = preconditionedIterations(A, maxIterations, precision, parameters->criterion, *cholesky, history);
+        if (numberOfIterations > CHOLESKY_REFACTOR_ITERATIONS)
+            cholesky->factor();
+        return numberOfIterations;
+    }
+    if (!cholesky->isCurrent())
+        cholesky->factor();
+    int n = A.n;
+    T rTr;
+    Reduction<T> sum; // Accurate sum of the dot products
+    for (int i = 0; i < n; i++)
+    {
+        T r = A.b[i] - A.multiplyRow(A.u, i);
+        sum.add(r * r);
+    }
+    recordResidual(history, sum.result());
+    cholesky->solve(A.b, A.u);
+    sum.clear();
+    for (int i = 0; i < n; i++)
+    {
+        T r = A.b[i] - A.multiplyRow(A.u, i);
+        sum.add(r * r);
+    }
+    rTr = sum.result();
+    recordResidual(history, rTr);
+    recordIterations(history, 1, true);
+    return 1;
+}
+
+/*______________________________________________________________________________
+                        FUNCTION deflatedIterations()
+    Deflated conjugate gradient (Saad, Yeung, Erhel and Guyomarc'h) with the A-orthonormal deflation space W
+    of the previous solves: the initial guess is corrected by u = u + W W^T r, and the search directions are
+    kept A-orthogonal to W, d = r + beta * d - W (AW)^T r, so the components of the smallest eigenvalues,
+    which slow down the conjugate gradient, are solved in the deflation space. The first
+    CG_DEFLATION_RECYCLED_DIRECTIONS search directions update W for the next solve, which may be of another
+    mesh (moved, refined or the next time step).
+______________________________________________________________________________*/
+template <class T> int ConjugateGradient::deflatedIterations( SparseSystem<T> &A, int maxIterations, long double *precision, ConjugateGradientParameters *parameters, ConjugateGradientHistory *history)
+{
+    DeflationSpace<T> *space = dynamic_cast<DeflationSpace<T> *>(parameters->setup);
+    if (space == NULL)
+    {
+        delete parameters->setup;
+        space = new DeflationSpace<T>();
+        parameters->setup = space;
+    }
+    space->prepare(A);
+    const vector< vector<T> > &W = space->W, &AW = space->AW;
+    int n = A.n, k = (int) W.size(), criterion = parameters->criterion, numberOfIterations = 0;
+    if (history != NULL)
+        history->setupReused = (k > 0);
+    vector<T> &u = A.u, r(n), d(n), Ad(n), mu(k);
+    vector< vector<T> > P, AP; // Search directions recycled
+    T error = 0.0, rTr, r1Tr1, dTAd, alpha, beta, normError, tolerance;
+    Reduction<T> sum, sumB; // Accurate sum of the dot products
+    for (int i = 0; i < n; i++)
+        r[i] = A.b[i] - A.multiplyRow(u, i);  // r_-1 = b - Au_-1
+    for (int j = 0; j < k; j++)               // u_0 = u_-1 + W W^T r_-1, r_0 = r_-1 - AW W^T r_-1
+    {
+        sum.clear();
+        for (int i = 0; i < n; i++)
+            sum.add(W[j][i] * r[i]);
+        T c = sum.result();
+        for (int i = 0; i < n; i++)
+        {
+            u[i] += c * W[j][i];
+            r[i] -= c * AW[j][i];
+        }
+    }
+    sum.clear();
+    for (int i = 0; i < n; i++)
+    {
+        sum.add(r[i] * r[i]);
+        if( fabs( r[i] ) > error )
+            error = fabs( r[i] );
+        if (criterion == CG_CRITERION_RELATIVE_RESIDUAL)
+            sumB.add(A.b[i] * A.b[i]);
+    }
+    rTr = sum.result();
+    tolerance = convergenceTolerance(criterion, precision, sumB.result());
+    recordResidual(history, rTr);
+    normError = error; // The update criterion starts with the infinit norm of the residue
+    for (int i = 0; i < n; i++)
+        d[i] = r[i];                          // d_0 = r_0 - W (AW)^T r_0
+    for (int j = 0; j < k; j++)
+    {
+        sum.clear();
+        for (int i = 0; i < n; i++)
+            sum.add(AW[j][i] * r[i]);
+        mu[j] = sum.result();
+    }
+    for (int j = 0; j < k; j++)
+        for (int i = 0; i < n; i++)
+            d[i] -= mu[j] * W[j][i];
+    while( !hasConverged(criterion, normError, rTr, tolerance) && ( numberOfIterations < maxIterations ) )
+    {
+        sum.clear();
+        for (int i = 0; i < n; i++)
+        {
+            Ad[i] = A.multiplyRow(d, i);
+            sum.add(d[i] * Ad[i]);
+        }
+        dTAd = sum.result();
+        if (numberOfIterations < CG_DEFLATION_RECYCLED_DIRECTIONS)
+        {
+            P.push_back(d);
+            AP.push_back(Ad);
+        }
+        alpha = rTr/dTAd;
+        normError = 0.0;
+        sum.clear();
+        for (int i = 0; i < n; i++)
+        {
+            if (criterion == CG_CRITERION_UPDATE)
+            {
+                // Calculates infinit norm of error
+                T normErrorTmp = fabs( ( (u[i] + alpha * d[i]) - u[i] ) / (u[i] + alpha * d[i]) );
+                if (  normErrorTmp > normError)
+                    normError = normErrorTmp;
+            }
+            u[i] += alpha * d[i];       // u = u + alpha . d
+            r[i] -= alpha * Ad[i];      // r(i+1) = r(i) - alpha * Ad
+            sum.add(r[i] * r[i]);       // r1Tr1T = r(i+1)^T * r(i+1)
+        }
+        r1Tr1 = sum.result();
+        recordResidual(history, r1Tr1);
+        beta = r1Tr1/rTr;
+        rTr = r1Tr1;
+        for (int j = 0; j < k; j++)     // mu = (AW)^T r(i+1)
+        {
+            sum.clear();
+            for (int i = 0; i < n; i++)
+                sum.add(AW[j][i] * r[i]);
+            mu[j] = sum.result();
+        }
+        for (int i = 0; i < n; i++)
+        {
+            d[i] = r[i] + beta * d[i];
+            for (int j = 0; j < k; j++)
+                d[i] -= mu[j] * W[j][i];
+        }
+        numberOfIterations++;
+    }
+    recordIterations(history, numberOfIterations, hasConverged(criterion, normError, rTr, tolerance));
+    space->recycle(A, P, AP, parameters->deflationVectors);
+    return numberOfIterations;
+}
+
+/*______________________________________________________________________________
+                        FUNCTION preconditionedIterations()
+    Preconditioned conjugate gradient: the search directions are conjugated with z = M^-1 r instead of r.
+    The convergence criteria still use rTr = ||r||^2.
+______________________________________________________________________________*/
+template <class T, class Preconditioner> int ConjugateGradient::preconditionedIterations( SparseSystem<T> &A, int maxIterations, long double *precision, int criterion, Preconditioner &preconditioner, ConjugateGradientHistory *history)
+{
+    int n = A.n, numberOfIterations = 0;
+    vector<T> &u = A.u, r(n), z(n), d(n), Ad(n);
+    T error = 0.0, rTr, rTz, r1Tz1, dTAd, alpha, beta, normError, tolerance;
+    Reduction<T> sum, sumZ, sumB; // Accurate sum of the dot products
+    for (int i = 0; i < n; i++)
+    {
+        r[i] = A.b[i] - A.multiplyRow(u, i);  // r_0 = b - Au_0
+        sum.add(r[i] * r[i]);
+        if( fabs( r[i] ) > error )
+            error = fabs( r[i] );
+        if (criterion == CG_CRITERION_RELATIVE_RESIDUAL)
+            sumB.add(A.b[i] * A.b[i]);
+    }
+    rTr = sum.result();
+    tolerance = convergenceTolerance(criterion, precision, sumB.result());
+    recordResidual(history, rTr);
+    normError = error; // The update criterion starts with the infinit norm of the residue
+    if (hasConverged(criterion, normError, rTr, tolerance))
+    {
+        recordIterations(history, numberOfIterations, true);
+        return numberOfIterations;
+    }
+    preconditioner.precondition(r, z);        // z_0 = M^-1 r_0
+    for (int i = 0; i < n; i++)
+    {
+        d[i] = z[i];                          // d_0 = z_0
+        sumZ.add(r[i] * z[i]);
+    }
+    rTz = sumZ.result();
+    while( !hasConverged(criterion, normError, rTr, tolerance) && ( numberOfIterations < maxIterations ) )
+    {
+        sum.clear();
+        for (int i = 0; i < n; i++)
+        {
+            Ad[i] = A.multiplyRow(d, i);
+            sum.add(d[i] * Ad[i]);
+        }
+        dTAd = sum.result();
+        alpha = rTz/dTAd;
+        normError = 0.0;
+        sum.clear();
+        for (int i = 0; i < n; i++)
+        {
+            if (criterion == CG_CRITERION_UPDATE)
+            {
+                // Calculates infinit norm of error
+                T normErrorTmp = fabs( ( (u[i] + alpha * d[i]) - u[i] ) / (u[i] + alpha * d[i]) );
+                if (  normErrorTmp > normError)
+                    normError = normErrorTmp;
+            }
+            u[i] += alpha * d[i];       // u = u + alpha . d
+            r[i] -= alpha * Ad[i];      // r(i+1) = r(i) - alpha * Ad
+            sum.add(r[i] * r[i]);
+        }
+        rTr = sum.result();
+        recordResidual(history, rTr);
+        numberOfIterations++;
+        if (hasConverged(criterion, normError, rTr, tolerance))
+            break;
+        preconditioner.precondition(r, z);    // z(i+1) = M^-1 r(i+1)
+        sumZ.clear();
+        for (int i = 0; i < n; i++)
+            sumZ.add(r[i] * z[i]);
+        r1Tz1 = sumZ.result();
+        beta = r1Tz1/rTz;
+        rTz = r1Tz1;
+        for (int i = 0; i < n; i++)
+            d[i] = z[i] + beta * d[i];
+    }
+    recordIterations(history, numberOfIterations, hasConverged(criterion, normError, rTr, tolerance));
+    return numberOfIterations;
+}
+
+/*______________________________________________________________________________
+                        FUNCTION multigridIterations()
+    Multigrid cycles until the convergence criterion. Each cycle is counted as one iteration.
+______________________________________________________________________________*/
+template <class T> int ConjugateGradient::multigridIterations( SparseSystem<T> &A, int maxIterations, long double *precision, int criterion, Multigrid<T> &multigrid, ConjugateGradientHistory *history)
+{
+    int n = A.n, numberOfIterations = 0;
+    vector<T> &u = A.u, previousU;
+    T error = 0.0, rTr, normError, tolerance;
+    Reduction<T> sum, sumB; // Accurate sum of the dot products
+    for (int i = 0; i < n; i++)
+    {
+        T r = A.b[i] - A.multiplyRow(u, i);
+        sum.add(r * r);
+        if( fabs( r ) > error )
+            error = fabs( r );
+        if (criterion == CG_CRITERION_RELATIVE_RESIDUAL)
+            sumB.add(A.b[i] * A.b[i]);
+    }
+    rTr = sum.result();
+    tolerance = convergenceTolerance(criterion, precision, sumB.result());
+    recordResidual(history, rTr);
+    normError = error; // The update criterion starts with the infinit norm of the residue
+    while( !hasConverged(criterion, normError, rTr, tolerance) && ( numberOfIterations < maxIterations ) )
+    {
+        if (criterion == CG_CRITERION_UPDATE)
+            previousU = u;
+        multigrid.cycle(u, A.b);
+        normError = 0.0;
+        sum.clear();
+        for (int i = 0; i < n; i++)
+        {
+            T r = A.b[i] - A.multiplyRow(u, i);
+            sum.add(r * r);
+            if (criterion == CG_CRITERION_UPDATE)
+            {
+                // Calculates infinit norm of error
+                T normErrorTmp = fabs( ( u[i] - previousU[i] ) / u[i] );
+                if (  normErrorTmp > normError)
+                    normError = normErrorTmp;
+            }
+        }
+        rTr = sum.result();
+        recordResidual(history, rTr);
+        numberOfIterations++;
+    }
+    recordIterations(history, numberOfIterations, hasConverged(criterion, normError, rTr, tolerance));
+    return numberOfIterations;
+}
+
+/*______________________________________________________________________________
+                        CLASS ConjugateGradientParameters and ConjugateGradientHistory
+______________________________________________________________________________*/
+ConjugateGradientParameters::ConjugateGradientParameters(int bitsPrecision, int method, int numberOfThreads, int criterion, int multigridCycle, int multigridCoarsening, int multigridSmoother, bool keepFactor, int deflationVectors)
+{
+    this->bitsPrecision = bitsPrecision;
+    this->method = method;
+    this->numberOfThreads = numberOfThreads;
+    this->criterion = criterion;
+    this->multigridCycle = multigridCycle;
+    this->multigridCoarsening = multigridCoarsening;
+    this->multigridSmoother = multigridSmoother;
+    this->keepFactor = keepFactor;
+    this->deflationVectors = deflationVectors;
+    this->setup = NULL;
+}
+
+ConjugateGradientParameters::~ConjugateGradientParameters()
+{
+    delete setup;
+}
+
+ConjugateGradientHistory::ConjugateGradientHistory()
+{
+    countHardwareEvents = false;
+    clear();
+}
+
+void ConjugateGradientHistory::clear()
+{
+    numberOfIterations = 0;
+    bitsPrecision = 0;
+    converged = false;
+    setupReused = false;
+    numberOfUnknowns = 0;
+    numberOfNonzeros = 0;
+    wallTime = 0.0;
+    cpuTime = 0.0;
+    flops = 0.0;
+    bytes = 0.0;
+    cycles = -1;
+    instructions = -1;
+    cacheReferences = -1;
+    cacheMisses = -1;
+    residualNorm.clear();
+}
+
+long double ConjugateGradientHistory::getInitialResidual()
+{
+    return residualNorm.empty() ? 0.0 : residualNorm.front();
+}
+
+long double ConjugateGradientHistory::getFinalResidual()
+{
+    return residualNorm.empty() ? 0.0 : residualNorm.back();
+}
@@ -2,7 +2,83 @@
 #define CONJUGATEGRADIENT_H_INCLUDED
 
 
+#include <vector>
 #include "../Vertex/vertex.h"
+#include "sparseSystem.h"
+#include "multigrid.h"
+#include "sparseCholesky.h"
+#include "deflation.h"
+#include "chebyshev.h"
+
+/**
+ * Options of the conjugate gradient method.
+ */
+class ConjugateGradientParameters
+{
+public:
+    int bitsPrecision;   /**< Working precision in bits: 0 (or the precision of realNumber) solves in place with realNumber,
+                              53 solves in double and, with the MPFR backend, 128, 256, 512 and 1024 solve in mpfr::real.
+                              Other values are rounded up to the next supported precision; with the multiple-double backends,
+                              values above the precision of realNumber (REAL_NUMBER_BITS) are an error. */
+    int method;          /**< CG_METHOD_CLASSIC, CG_METHOD_FUSED, CG_METHOD_PIPELINED, CG_METHOD_MULTIGRID_PCG, CG_METHOD_MULTIGRID,
+                              CG_METHOD_CHOLESKY, CG_METHOD_DEFLATED, CG_METHOD_CHEBYSHEV or CG_METHOD_CHEBYSHEV_PCG */
+    int numberOfThreads; /**< Threads of CG_METHOD_PIPELINED and CG_METHOD_CHEBYSHEV */
+    int criterion;       /**< CG_CRITERION_UPDATE, CG_CRITERION_RELATIVE_RESIDUAL or CG_CRITERION_ABSOLUTE_RESIDUAL */
+    int multigridCycle;  /**< MULTIGRID_V_CYCLE or MULTIGRID_W_CYCLE, used by the multigrid methods */
+    int multigridCoarsening; /**< MULTIGRID_COARSENING_REFINEMENT or MULTIGRID_COARSENING_AGGREGATION */
+    int multigridSmoother; /**< MULTIGRID_SMOOTHER_GAUSS_SEIDEL or MULTIGRID_SMOOTHER_CHEBYSHEV */
+    bool keepFactor;     /**< CG_METHOD_CHOLESKY: an outdated factor of the same sparsity preconditions the conjugate gradient
+                              instead of being refactored (refactored after CHOLESKY_REFACTOR_ITERATIONS iterations) */
+    int deflationVectors; /**< CG_METHOD_DEFLATED: approximate eigenvectors recycled from one solve to the next */
+    SolverSetup *setup;  /**< Setup of the last solve (multigrid levels, factor, deflation space), reused while the sparsity of the
+                              system is the same (the deflation space is transferred to any system). Owned by the parameters, one
+                              object of parameters per thread. */
+    ConjugateGradientParameters(int bitsPrecision, int method, int numberOfThreads, int criterion, int multigridCycle, int multigridCoarsening, int multigridSmoother, bool keepFactor, int deflationVectors);
+    /**
+     * Destructor. Deletes the setup.
+     */
+    ~ConjugateGradientParameters();
+};
+
+/**
+ * Convergence history of a solve, filled by ConjugateGradient::solve.
+ */
+class ConjugateGradientHistory
+{
+public:
+    int numberOfIterations;          /**< Iterations done */
+    int bitsPrecision;               /**< Bits of precision of the working type used (parameters->bitsPrecision rounded up to a supported
+                                          precision, or the precision of realNumber) */
+    bool converged;                  /**< The criterion was reached (false if the solve stopped at maxIterations, or at the attainable
+                                          accuracy of the working type with CG_METHOD_PIPELINED) */
+    bool setupReused;                /**< The setup of the previous solve was reused (same sparsity) */
+    int numberOfUnknowns;            /**< Internal vertices of the system */
+    long numberOfNonzeros;           /**< Off-diagonal entries of the matrix */
+    double wallTime;                 /**< Elapsed time of the solve (seconds) */
+    double cpuTime;                  /**< CPU time of the calling thread (seconds); the threads of the pipelined and Chebyshev methods are not included */
+    double flops;                    /**< Estimated floating point operations of the iterations, in the working precision */
+    double bytes;                    /**< Estimated bytes of matrix and vectors read and written by the iterations */
+    bool countHardwareEvents;        /**< Count the hardware events of the solves (set by the caller, kept by clear()) */
+    long long cycles;                /**< Cycles of the solve (-1 if not counted or not available) */
+    long long instructions;          /**< Instructions of the solve (-1 if not counted or not available) */
+    long long cacheReferences;       /**< Last level cache references of the solve (-1 if not counted or not available) */
+    long long cacheMisses;           /**< Last level cache misses of the solve (-1 if not counted or not available) */
+    vector<long double> residualNorm; /**< residualNorm[i] = ||r_i||_2, the residual of the iteration i (0 = initial); CG_METHOD_CHEBYSHEV
+                                           only computes it every CHEBYSHEV_CHECK_PERIOD iterations */
+    ConjugateGradientHistory();
+    /**
+     * Clears the history.
+     */
+    void clear();
+    /**
+     * Get the norm of the initial residual.
+     */
+    long double getInitialResidual();
+    /**
+     * Get the norm of the last residual.
+     */
+    long double getFinalResidual();
+};
 
 class ConjugateGradient
 {
@@ -10,10 +86,116 @@ public:
 
     ConjugateGradient();
     /**
-     * Conjugate gradient method for symmetric positive definite matrix. The grid discretization matrix and all variables used in the conjugate gradient method are stored on the grid's Vertex, which improves performance.
-     * @param firstVertex 
+     * Conjugate gradient method for symmetric positive definite matrix. The grid discretization matrix and all variables
+       used in the conjugate gradient method are stored on the grid's Vertex, which improves performance. With a working
+       precision other than realNumber, the matrix and the vectors b and u are converted to the working type at the
+       beginning and the solution u is converted back at the end.
+     * @param firstVertex
      * @param maxIterations
+     * @param precision maximum error of the convergence criterion.
+     * @param parameters precision, method, threads and convergence criterion.
+     * @param history convergence history, times and estimated work, filled if not NULL.
+     * @return number of iterations.
+     */
+    static int solve(Vertex *firstVertex, int maxIterations, long double *precision, ConjugateGradientParameters *parameters, ConjugateGradientHistory *history);
+
+private:
+    /**
+     * Solve with the working type of parameters->bitsPrecision and the method of parameters->method.
+     */
+    static int selectSolver(Vertex *firstVertex, int maxIterations, long double *precision, ConjugateGradientParameters *parameters, ConjugateGradientHistory *history);
+    /**
+     * Classic conjugate gradient in place on the grid's Vertex, four sweeps of the vertices per iteration.
+     */
+    static int solveClassic(Vertex *firstVertex, int maxIterations, long double *precision, int criterion, ConjugateGradientHistory *history);
+    /**
+     * Conjugate gradient of Chronopoulos and Gear, two sweeps of the vertices per iteration. The vectors w = Ar and
+       s = Ad are stored in Vertex::Au and Vertex::Ad.
+     */
+    static int solveFused(Vertex *firstVertex, int maxIterations, long double *precision, int criterion, ConjugateGradientHistory *history);
+    /**
+     * Tolerance of the convergence criterion, compared by hasConverged().
+     * @param bTb b^T * b, used by CG_CRITERION_RELATIVE_RESIDUAL.
+     */
+    template <class T> static T convergenceTolerance(int criterion, long double *precision, const T &bTb);
+    /**
+     * Convergence test: normError (update criterion) or rTr (residual criteria) below the tolerance.
+     */
+    template <class T> static bool hasConverged(int criterion, const T &normError, const T &rTr, const T &tolerance);
+    /**
+     * Appends the norm of the residual sqrt(rTr) to the history.
+     */
+    template <class T> static void recordResidual(ConjugateGradientHistory *history, const T &rTr);
+    /**
+     * Stores the number of iterations in the history.
+     */
+    static void recordIterations(ConjugateGradientHistory *history, int numberOfIterations, bool converged);
+    /**
+     * Stores in the history the estimated operations and memory traffic of the iterations, from the cost of one iteration
+       of the method: products by the matrix, vector operations (dot products and updates of n entries) and applications
+       of the preconditioner.
+     * @param preconditionerWork multiply-adds of one application of the preconditioner (multigrid cycle, Cholesky solve).
+     * @param bytesPerReal bytes of a number of the working precision.
+     */
+    static void recordWork(ConjugateGradientHistory *history, ConjugateGradientParameters *parameters, long n, long nonzeros, double preconditionerWork, int bytesPerReal);
+    /**
+     * Conjugate gradient iterations on a copy of the matrix in the working type T (compressed sparse rows).
+     */
+    template <class T> static int solveInPrecision(Vertex *firstVertex, int maxIterations, long double *precision, ConjugateGradientParameters *parameters, ConjugateGradientHistory *history);
+    /**
+     * Iterations of the classic conjugate gradient on a system in compressed sparse rows.
+     */
+    template <class T> static int classicIterations(SparseSystem<T> &A, int maxIterations, long double *precision, int criterion, ConjugateGradientHistory *history);
+    /**
+     * Iterations of the conjugate gradient of Chronopoulos and Gear on a system in compressed sparse rows.
+     */
+    template <class T> static int fusedIterations(SparseSystem<T> &A, int maxIterations, long double *precision, int criterion, ConjugateGradientHistory *history);
+    /**
+     * Iterations of the pipelined conjugate gradient of Ghysels and Vanroose on a system in compressed sparse rows,
+       with one reduction per iteration. The rows are split among parameters->numberOfThreads threads.
+     */
+    template <class T> static int pipelinedIterations(SparseSystem<T> &A, int maxIterations, long double *precision, ConjugateGradientParameters *parameters, ConjugateGradientHistory *history);
+    /**
+     * Thread of pipelinedIterations().
+     */
+    template <class T> static void *pipelinedWorker(void *argument);
+    /**
+     * Multigrid of the parameters, reusing the levels of the previous solve while the sparsity of the system is
+       the same (only the values are recomputed).
+     */
+    template <class T> static Multigrid<T> *getMultigrid(SparseSystem<T> &A, ConjugateGradientParameters *parameters, ConjugateGradientHistory *history);
+    /**
+     * Cholesky factor of the parameters, reusing the symbolic analysis (and the factor, if the coefficients are the same)
+       of the previous solve while the sparsity of the system is the same.
+     */
+    template <class T> static SparseCholesky<T> *getCholesky(SparseSystem<T> &A, ConjugateGradientParameters *parameters, ConjugateGradientHistory *history);
+    /**
+     * Solve with the sparse Cholesky factorization (one iteration), or conjugate gradient preconditioned by an outdated
+       factor if parameters->keepFactor.
+     */
+    template <class T> static int choleskyIterations(SparseSystem<T> &A, int maxIterations, long double *precision, ConjugateGradientParameters *parameters, ConjugateGradientHistory *history);
+    /**
+     * Iterations of the deflated conjugate gradient on a system in compressed sparse rows, with the deflation space
+       of the previous solves kept in parameters->setup.
+     */
+    template <class T> static int deflatedIterations(SparseSystem<T> &A, int maxIterations, long double *precision, ConjugateGradientParameters *parameters, ConjugateGradientHistory *history);
+    /**
+     * Iterations of the Chebyshev method (without inner products, the rows split among parameters->numberOfThreads threads)
+       or of the conjugate gradient preconditioned by a Chebyshev polynomial (CG_METHOD_CHEBYSHEV_PCG).
+     */
+    template <class T> static int chebyshevIterations(SparseSystem<T> &A, int maxIterations, long double *precision, ConjugateGradientParameters *parameters, ConjugateGradientHistory *history);
+    /**
+     * Thread of chebyshevIterations().
+     */
+    template <class T> static void *chebyshevWorker(void *argument);
+    /**
+     * Iterations of the preconditioned conjugate gradient on a system in compressed sparse rows. The preconditioner
+       is any class with the method precondition(r, z), z = M^-1 r, for a symmetric positive definite M.
+     */
+    template <class T, class Preconditioner> static int preconditionedIterations(SparseSystem<T> &A, int maxIterations, long double *precision, int criterion, Preconditioner &preconditioner, ConjugateGradientHistory *history);
+    /**
+     * Multigrid cycles on a system in compressed sparse rows, until the convergence criterion.
      */
-    static int solve(Vertex *firstVertex, int maxIterations, long double *precision);
+    template <class T> static int multigridIterations(SparseSystem<T> &A, int maxIterations, long double *precision, int criterion, Multigrid<T> &multigrid, ConjugateGradientHistory *history);
 };
 #endif // CONJUGATEGRADIENT_H_INCLUDED
@@ -0,0 +1,260 @@
+/****** Declaration and implementation of the class Chebyshev ******/
+/* Chebyshev semi-iterative method for Ax = b, preconditioned by the diagonal (Jacobi), on the interval
+   [minimum, maximum] of the eigenvalues of D^-1 A. The iterations compute no inner products: with the
+   interval known, the coefficients of the three-term recurrence are fixed, so the method needs only the
+   products by A and is not limited by the reductions of the conjugate gradient in parallel runs.
+   The interval starts from the Gershgorin discs of D^-1 A (an upper bound of the eigenvalues and, for the
+   diagonally dominant matrices of the Finite Volume Method, a positive lower bound). A few steps of Lanczos
+   (conjugate gradient) improve the lower bound; a lower bound too high only slows the convergence of the
+   smallest eigenvalues, while the upper bound must not be too low, so it is always the Gershgorin one.
+   Matrix is any class with n, rowStart, value, diagonal and multiplyRow(v, i), like SparseSystem and
+   MultigridLevel. The iterations work on a range of rows, so they can be split among threads: the next
+   search direction is written in a second vector, and a step only needs the previous step of all the rows.
+   Header only. */
+
+#ifndef CHEBYSHEV_H_INCLUDED
+#define CHEBYSHEV_H_INCLUDED
+
+#include <cmath>
+#include <vector>
+#include "../Real/reduction.h"
+#include "../Utils/constants.h"
+#include "sparseSystem.h"
+using namespace std;
+
+template <class T, class Matrix> class Chebyshev
+{
+public:
+    /**
+     * Constructor. Interval of the Gershgorin discs of D^-1 A.
+     * @param A matrix, not copied (it must exist while the object is used).
+     */
+    Chebyshev(const Matrix *A)
+    {
+        this->A = A;
+        n = A->n;
+        inverseDiagonal.resize(n);
+        r.assign(n, T(0.0));
+        direction[0].assign(n, T(0.0));
+        direction[1].assign(n, T(0.0));
+        steps = 0;
+        gershgorinBounds();
+    }
+    /**
+     * Recomputes the inverse of the diagonal and the Gershgorin interval with the current values of the matrix.
+     */
+    void gershgorinBounds()
+    {
+        maximum = 0.0;
+        minimum = 1.0;
+        for (int i = 0; i < n; i++)
+        {
+            inverseDiagonal[i] = T(1.0) / A->diagonal[i];
+            T radius = 0.0;
+            for (int k = A->rowStart[i]; k < A->rowStart[i + 1]; k++)
+                radius += fabs(A->value[k]);
+            radius *= fabs(inverseDiagonal[i]);
+            if (T(1.0) + radius > maximum)
+                maximum = T(1.0) + radius;
+            if (T(1.0) - radius < minimum)
+                minimum = T(1.0) - radius;
+        }
+        if (minimum <= 0.0) // Not diagonally dominant: the lower bound must come from estimateMinimum() or setInterval()
+            minimum = maximum * CHEBYSHEV_MINIMUM_RATIO;
+        setInterval(minimum, maximum);
+    }
+    /**
+     * Improves the lower bound with the smallest Ritz value of steps iterations of the conjugate gradient preconditioned by
+       the diagonal for Ae = residual (Lanczos). The Ritz value is above the smallest eigenvalue, by less as steps grows.
+     */
+    void estimateMinimum(const vector<T> &residual, int steps)
+    {
+        vector<T> rr = residual, z(n), p(n), Ap(n), alphas, betas;
+        Reduction<T> sum;
+        for (int i = 0; i < n; i++)
+        {
+            z[i] = inverseDiagonal[i] * rr[i];
+            p[i] = z[i];
+            sum.add(rr[i] * z[i]);
+        }
+        T rz = sum.result();
+        for (int j = 0; j < steps && rz > 0.0; j++)
+        {
+            sum.clear();
+            for (int i = 0; i < n; i++)
+            {
+                Ap[i] = A->multiplyRow(p, i);
+                sum.add(p[i] * Ap[i]);
+            }
+            T pAp = sum.result();
+            if (pAp <= 0.0)
+                break;
+            T alpha = rz / pAp;
+            sum.clear();
+            for (int i = 0; i < n; i++)
+            {
+                rr[i] -= alpha * Ap[i];
+                z[i] = inverseDiagonal[i] * rr[i];
+                sum.add(rr[i] * z[i]);
+            }
+            T rzNew = sum.result(), beta = rzNew / rz;
+            alphas.push_back(alpha);
+            betas.push_back(beta);
+            for (int i = 0; i < n; i++)
+                p[i] = z[i] + beta * p[i];
+            rz = rzNew;
+        }
+        if (alphas.empty())
+            return;
+        // Tridiagonal matrix of Lanczos: diagonal 1/alpha_j + beta_j-1/alpha_j-1, off-diagonal squared beta_j/alpha_j^2
+        int m = (int) alphas.size();
+        vector<T> d(m), e2(m);
+        for (int j = 0; j < m; j++)
+        {
+            d[j] = T(1.0) / alphas[j];
+            if (j > 0)
+                d[j] += betas[j - 1] / alphas[j - 1];
+            e2[j] = betas[j] / (alphas[j] * alphas[j]);
+        }
+        // Smallest eigenvalue by bisection with the Sturm sequence
+        T low = 0.0, high = maximum;
+        for (int s = 0; s < CHEBYSHEV_BISECTION_STEPS; s++)
+        {
+            T middle = (low + high) / 2.0, q = 1.0;
+            int below = 0;
+            for (int j = 0; j < m; j++)
+            {
+                q = d[j] - middle - ( (j > 0) ? e2[j - 1] / q : T(0.0) );
+                if (q == 0.0)
+                    q = machineEpsilon(middle) * maximum;
+                if (q < 0.0)
+                    below++;
+            }
+            if (below > 0)
+                high = middle;
+            else
+                low = middle;
+        }
+        if (high > minimum && high < maximum)
+            setInterval(high, maximum);
+    }
+    /**
+     * Sets the interval of the eigenvalues of D^-1 A where the residual is reduced.
+     */
+    void setInterval(const T &minimum, const T &maximum)
+    {
+        this->minimum = minimum;
+        this->maximum = maximum;
+        theta = (maximum + minimum) / 2.0;
+        delta = (maximum - minimum) / 2.0;
+        sigma = theta / delta;
+    }
+    T getMinimum() const
+    {
+        return minimum;
+    }
+    T getMaximum() const
+    {
+        return maximum;
+    }
+    /**
+     * Starts the iterations for Ax = b from x: r = b - Ax and the first search direction.
+     * @return coefficient rho of the first step.
+     */
+    T start(const vector<T> &x, const vector<T> &b)
+    {
+        steps = 0;
+        for (int i = 0; i < n; i++)
+        {
+            r[i] = b[i] - A->multiplyRow(x, i);
+            direction[0][i] = inverseDiagonal[i] * r[i] / theta;
+        }
+        rho = T(1.0) / sigma;
+        return rho;
+    }
+    /**
+     * Step k on the rows [first, last): x = x + d_k, r = r - A d_k and d_k+1 = rho_k+1 rho_k d_k + 2 rho_k+1 / delta D^-1 r.
+       All the rows of the step k must be done before the step k + 1 of any row.
+     * @param rho coefficient of the step, replaced by the coefficient of the next step.
+     */
+    void step(vector<T> &x, int first, int last, int k, T &rho)
+    {
+        const vector<T> &d = direction[k % 2];
+        vector<T> &dNext = direction[(k + 1) % 2];
+        T rhoNext = T(1.0) / (2.0 * sigma - rho),
+          factorD = rhoNext * rho,
+          factorZ = 2.0 * rhoNext / delta;
+        for (int i = first; i < last; i++)
+        {
+            x[i] += d[i];
+            r[i] -= A->multiplyRow(d, i);
+            dNext[i] = factorD * d[i] + factorZ * inverseDiagonal[i] * r[i];
+        }
+        rho = rhoNext;
+    }
+    /**
+     * Next step on all the rows.
+     */
+    void step(vector<T> &x)
+    {
+        step(x, 0, n, steps, rho);
+        steps++;
+    }
+    /**
+     * Residual r = b - Ax of the iterations (updated by the recurrence).
+     */
+    vector<T> &getResidual()
+    {
+        return r;
+    }
+    /**
+     * Search direction of the step k, the update of x of the step.
+     */
+    const vector<T> &getDirection(int k) const
+    {
+        return direction[k % 2];
+    }
+    /**
+     * Replaces the residual of the recurrence by b - Ax on the rows [first, last) (it drifts in low precision).
+     */
+    void replaceResidual(const vector<T> &x, const vector<T> &b, int first, int last)
+    {
+        for (int i = first; i < last; i++)
+            r[i] = b[i] - A->multiplyRow(x, i);
+    }
+    /**
+     * degree steps for Ax = b starting from x (smoother of the multigrid).
+     */
+    void smooth(vector<T> &x, const vector<T> &b, int degree)
+    {
+        start(x, b);
+        for (int k = 0; k < degree; k++)
+            step(x);
+    }
+    /**
+     * Preconditioner z = M^-1 r: CHEBYSHEV_PRECONDITIONER_DEGREE steps for Az = r starting from z = 0. M^-1 is a fixed
+       polynomial of D^-1 A, positive on the eigenvalues, so it is symmetric positive definite.
+     */
+    void precondition(const vector<T> &residual, vector<T> &z)
+    {
+        for (int i = 0; i < n; i++)
+            z[i] = 0.0;
+        smooth(z, residual, CHEBYSHEV_PRECONDITIONER_DEGREE);
+    }
+
+private:
+    //
+    // Attributes
+    //
+    const Matrix *A;          /**< Matrix of the system */
+    int n;                    /**< Number of unknowns */
+    vector<T> inverseDiagonal; /**< D^-1 */
+    vector<T> r;              /**< Residual b - Ax */
+    vector<T> direction[2];   /**< Search directions of the even and odd steps */
+    T minimum, maximum;       /**< Interval of the eigenvalues of D^-1 A */
+    T theta, delta, sigma;    /**< Center and half width of the interval, sigma = theta / delta */
+    T rho;                    /**< Coefficient of the next step of step(x) */
+    int steps;                /**< Steps done by step(x) since start() */
+};
+
+#endif // CHEBYSHEV_H_INCLUDED
@@ -0,0 +1,262 @@
+/****** Declaration and implementation of the class DeflationSpace ******/
+/* Deflation space of the deflated conjugate gradient (Saad, Yeung, Erhel and Guyomarc'h): a few approximate
+   eigenvectors W of the smallest eigenvalues of A, recycled from one solve to the next. The vectors are
+   stored with the vertices (Vertex::id) of the system where they were computed, so they are transferred to a
+   later system by the vertices, also after Mesh::renumberVertices() (after a refinement, a new vertex takes the mean of its known neighbours).
+   At the beginning of a solve W is A-orthonormalized (W^T A W = I) and the dependent vectors are dropped.
+   At the end, the harmonic Ritz vectors of span{W, p_0, ..., p_m-1} (the first search directions of the
+   solve) replace W. Header only. */
+
+#ifndef DEFLATION_H_INCLUDED
+#define DEFLATION_H_INCLUDED
+
+#include <cmath>
+#include <map>
+#include <vector>
+#include "../Real/reduction.h"
+#include "../Utils/constants.h"
+#include "sparseSystem.h"
+using namespace std;
+
+template <class T> class DeflationSpace : public SolverSetup
+{
+public:
+    //
+    // Attributes
+    //
+    vector< vector<T> > W;  /**< A-orthonormal vectors of the deflation space, in the order of the system of prepare() */
+    vector< vector<T> > AW; /**< Products A * W */
+    //
+    // Methods
+    //
+    /**
+     * Transfers the vectors of the previous solve to the system A and A-orthonormalizes them.
+     * @param A system of the solve.
+     */
+    void prepare(const SparseSystem<T> &A)
+    {
+        int n = A.n;
+        vector< vector<T> > previous;
+        previous.swap(W);
+        AW.clear();
+        if (previous.empty())
+        {
+            setVertices(A.vertices);
+            return;
+        }
+        // Transfer by the vertices (Vertex::id)
+        map<int, int> index;
+        for (size_t i = 0; i < vertexIds.size(); i++)
+            index[vertexIds[i]] = (int) i;
+        vector<int> oldIndex(n, -1);
+        for (int i = 0; i < n; i++)
+        {
+            map<int, int>::iterator it = index.find(A.vertices[i]->id);
+            if (it != index.end())
+                oldIndex[i] = it->second;
+        }
+        setVertices(A.vertices);
+        for (size_t j = 0; j < previous.size(); j++)
+        {
+            vector<T> w(n, T(0.0));
+            for (int i = 0; i < n; i++)
+                if (oldIndex[i] >= 0)
+                    w[i] = previous[j][oldIndex[i]];
+            for (int i = 0; i < n; i++) // New vertices: mean of the known neighbours
+            {
+                if (oldIndex[i] >= 0)
+                    continue;
+                int count = 0;
+                for (int k = A.rowStart[i]; k < A.rowStart[i + 1]; k++)
+                {
+                    if (oldIndex[A.column[k]] >= 0)
+                    {
+                        w[i] += w[A.column[k]];
+                        count++;
+                    }
+                }
+                if (count > 0)
+                    w[i] /= count;
+            }
+            addVector(A, w);
+        }
+    }
+    /**
+     * Replaces W by the k harmonic Ritz vectors of the smallest harmonic Ritz values of Z = [W, P], with P the search
+       directions of the solve: G y = theta F y, G = (AZ)^T (AZ), F = Z^T A Z. The search directions are A-orthogonal
+       to each other and to W, so F is diagonal.
+     * @param A system of the solve.
+     * @param P search directions of the solve.
+     * @param AP products A * P.
+     * @param k maximum number of vectors.
+     */
+    void recycle(const SparseSystem<T> &A, const vector< vector<T> > &P, const vector< vector<T> > &AP, int k)
+    {
+        int n = A.n, kw = (int) W.size(), s = kw + (int) P.size();
+        if (s == 0 || k <= 0)
+            return;
+        vector<const vector<T> *> Z(s), AZ(s);
+        for (int j = 0; j < s; j++)
+        {
+            Z[j]  = (j < kw) ? &W[j]  : &P[j - kw];
+            AZ[j] = (j < kw) ? &AW[j] : &AP[j - kw];
+        }
+        // F^-1/2 G F^-1/2
+        vector<T> scale(s), C( (size_t) s * s );
+        Reduction<T> sum;
+        for (int j = 0; j < s; j++)
+        {
+            if (j < kw)
+                scale[j] = 1.0;
+            else
+            {
+                sum.clear();
+                for (int i = 0; i < n; i++)
+                    sum.add( (*Z[j])[i] * (*AZ[j])[i] );
+                scale[j] = T(1.0) / sqrt( sum.result() );
+            }
+        }
+        for (int a = 0; a < s; a++)
+        {
+            for (int b = a; b < s; b++)
+            {
+                sum.clear();
+                for (int i = 0; i < n; i++)
+                    sum.add( (*AZ[a])[i] * (*AZ[b])[i] );
+                C[(size_t) a * s + b] = C[(size_t) b * s + a] = sum.result() * scale[a] * scale[b];
+            }
+        }
+        vector<T> eigenvalues, eigenvectors;
+        jacobiEigen(C, s, eigenvalues, eigenvectors);
+        // Smallest harmonic Ritz values
+        vector<int> smallest;
+        vector<bool> taken(s, false);
+        for (int j = 0; j < k && j < s; j++)
+        {
+            int m = -1;
+            for (int a = 0; a < s; a++)
+                if (!taken[a] && (m < 0 || eigenvalues[a] < eigenvalues[m]))
+                    m = a;
+            taken[m] = true;
+            smallest.push_back(m);
+        }
+        vector< vector<T> > ritz( smallest.size(), vector<T>(n, T(0.0)) );
+        for (size_t j = 0; j < smallest.size(); j++)
+        {
+            for (int a = 0; a < s; a++)
+            {
+                T y = eigenvectors[(size_t) a * s + smallest[j]] * scale[a];
+                for (int i = 0; i < n; i++)
+                    ritz[j][i] += y * (*Z[a])[i];
+            }
+        }
+        W.swap(ritz);
+        setVertices(A.vertices);
+    }
+
+private:
+    /**
+     * Adds w to W, A-orthogonalized against W (modified Gram-Schmidt) and A-normalized. It is dropped if it is
+       (nearly) dependent of W.
+     */
+    void addVector(const SparseSystem<T> &A, vector<T> &w)
+    {
+        int n = A.n;
+        vector<T> Aw(n);
+        Reduction<T> sum;
+        for (int i = 0; i < n; i++)
+        {
+            Aw[i] = A.multiplyRow(w, i);
+            sum.add(w[i] * Aw[i]);
+        }
+        T normBefore = sum.result();
+        if (normBefore <= 0.0)
+            return;
+        for (size_t j = 0; j < W.size(); j++)
+        {
+            sum.clear();
+            for (int i = 0; i < n; i++)
+                sum.add(AW[j][i] * w[i]);
+            T c = sum.result();
+            for (int i = 0; i < n; i++)
+            {
+                w[i] -= c * W[j][i];
+                Aw[i] -= c * AW[j][i];
+            }
+        }
+        sum.clear();
+        for (int i = 0; i < n; i++)
+            sum.add(w[i] * Aw[i]);
+        T norm = sum.result();
+        if (norm <= CG_DEFLATION_DEPENDENCE_TOLERANCE * normBefore)
+            return;
+        T factor = T(1.0) / sqrt(norm);
+        for (int i = 0; i < n; i++)
+        {
+            w[i] *= factor;
+            Aw[i] *= factor;
+        }
+        W.push_back(w);
+        AW.push_back(Aw);
+    }
+    /**
+     * Eigenvalues and eigenvectors of the symmetric matrix C (s x s, row-major) by the cyclic Jacobi method.
+     * @param eigenvectors the column j is the eigenvector of eigenvalues[j].
+     */
+    static void jacobiEigen(vector<T> C, int s, vector<T> &eigenvalues, vector<T> &eigenvectors)
+    {
+        eigenvectors.assign( (size_t) s * s, T(0.0) );
+        for (int a = 0; a < s; a++)
+            eigenvectors[(size_t) a * s + a] = 1.0;
+        T epsilon = machineEpsilon(C[0]);
+        for (int sweep = 0; sweep < 100; sweep++)
+        {
+            T off = 0.0, diagonal = 0.0;
+            for (int a = 0; a < s; a++)
+            {
+                diagonal += C[(size_t) a * s + a] * C[(size_t) a * s + a];
+                for (int b = a + 1; b < s; b++)
+                    off += C[(size_t) a * s + b] * C[(size_t) a * s + b];
+            }
+            if (off <= epsilon * epsilon * diagonal)
+                break;
+            for (int p = 0; p < s; p++)
+            {
+                for (int q = p + 1; q < s; q++)
+                {
+                    T cpq = C[(size_t) p * s + q];
+                    if (cpq == 0.0)
+                        continue;
+                    T theta = (C[(size_t) q * s + q] - C[(size_t) p * s + p]) / (2.0 * cpq);
+                    T t = T(1.0) / (fabs(theta) + sqrt(theta * theta + 1.0));
+                    if (theta < 0.0)
+                        t = -t;
+                    T c = T(1.0) / sqrt(t * t + 1.0), sn = t * c;
+                    for (int m = 0; m < s; m++) // Columns p and q
+                    {
+                        T cmp = C[(size_t) m * s + p], cmq = C[(size_t) m * s + q];
+                        C[(size_t) m * s + p] = c * cmp - sn * cmq;
+                        C[(size_t) m * s + q] = sn * cmp + c * cmq;
+                    }
+                    for (int m = 0; m < s; m++) // Rows p and q
+                    {
+                        T cpm = C[(size_t) p * s + m], cqm = C[(size_t) q * s + m];
+                        C[(size_t) p * s + m] = c * cpm - sn * cqm;
+                        C[(size_t) q * s + m] = sn * cpm + c * cqm;
+                    }
+                    for (int m = 0; m < s; m++)
+                    {
+                        T vmp = eigenvectors[(size_t) m * s + p], vmq = eigenvectors[(size_t) m * s + q];
+                        eigenvectors[(size_t) m * s + p] = c * vmp - sn * vmq;
+                        eigenvectors[(size_t) m * s + q] = sn * vmp + c * vmq;
+                    }
+                }
+            }
+        }
+        eigenvalues.resize(s);
+        for (int a = 0; a < s; a++)
+            eigenvalues[a] = C[(size_t) a * s + a];
+    }
+};
+
+#endif // DEFLATION_H_INCLUDED
@@ -0,0 +1,711 @@
+/****** Declaration and implementation of the classes MultigridLevel and Multigrid ******/
+/* Multigrid (V or W cycles) for the system of a SparseSystem, with two coarsenings:
+   - MULTIGRID_COARSENING_REFINEMENT (geometric): the levels follow the refinement stages of createAdaptiveMesh.
+     The unknowns of a coarse level are the vertices created up to an earlier stage (Vertex::refinementLevel),
+     so the meshes of the stages are nested. Each fine unknown is interpolated from its coarse neighbours with
+     the weights of its row of the matrix (direct interpolation). When the stages are exhausted, the coarsening
+     continues with maximal independent sets of the matrix graph.
+   - MULTIGRID_COARSENING_AGGREGATION (smoothed aggregation): the unknowns are grouped in aggregates of strongly
+     connected neighbours, and the piecewise constant prolongation of the aggregates is smoothed by one damped
+     Jacobi step. Only the matrix is used, so it works for any mesh, including deformed ones.
+   The restriction is the transpose of the prolongation and the coarse matrices are the Galerkin products
+   R * A * P. The coarsest system (at most MULTIGRID_COARSEST_SIZE unknowns) is factored (LDL^T); if the matrix
+   has only weak connections and cannot be coarsened so far, the coarsest level is smoothed instead.
+   The smoother is Gauss-Seidel, forward before and backward after the coarse correction, or Chebyshev
+   (MULTIGRID_SMOOTHER_CHEBYSHEV), the same polynomial of D^-1 A before and after, which damps the upper
+   part of the spectrum without inner products and without the sequential order of Gauss-Seidel. Either
+   way one cycle is a symmetric positive definite preconditioner of the conjugate gradient method.
+   The levels can be kept between solves: while the sparsity of the system does not change (same vertices
+   and edges, in any order), update() recomputes only the values of the hierarchy. Header only. */
+
+#ifndef MULTIGRID_H_INCLUDED
+#define MULTIGRID_H_INCLUDED
+
+#include <vector>
+#include "../Utils/constants.h"
+#include "sparseSystem.h"
+#include "chebyshev.h"
+using namespace std;
+
+template <class T> class MultigridLevel
+{
+public:
+    //
+    // Attributes
+    //
+    int n;                          /**< Number of unknowns of the level */
+    vector<int> rowStart;           /**< Off-diagonal entries of the row i are in [rowStart[i], rowStart[i + 1]) */
+    vector<int> column;             /**< Column of the off-diagonal entries */
+    vector<T> value;                /**< Value of the off-diagonal entries */
+    vector<T> diagonal;             /**< Diagonal of the matrix */
+    vector<int> coarseIndex;        /**< Unknown of the next level of each unknown: the kept unknown (-1 if interpolated)
+                                         in the geometric coarsening, the aggregate in the smoothed aggregation */
+    vector<int> prolongationStart;  /**< Weights of the row i of the prolongation from the next level are in [prolongationStart[i], prolongationStart[i + 1]) */
+    vector<int> prolongationColumn; /**< Unknown of the next level of the weights */
+    vector<T> prolongationWeight;   /**< Interpolation weights */
+    vector<T> x;                    /**< Solution (correction) of the cycle */
+    vector<T> b;                    /**< Right-hand side of the cycle */
+    vector<T> r;                    /**< Residual b - Ax */
+    //
+    // Methods
+    //
+    /**
+     * Row i of the product y = Av.
+     */
+    T multiplyRow(const vector<T> &v, int i) const
+    {
+        T y = diagonal[i] * v[i];
+        for (int k = rowStart[i]; k < rowStart[i + 1]; k++)
+            y += value[k] * v[column[k]];
+        return y;
+    }
+    /**
+     * Gauss-Seidel sweep on x, from the first to the last unknown (forward) or the opposite.
+     */
+    void smooth(bool forward)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            int i = forward ? j : n - 1 - j;
+            T s = b[i];
+            for (int k = rowStart[i]; k < rowStart[i + 1]; k++)
+                s -= value[k] * x[column[k]];
+            x[i] = s / diagonal[i];
+        }
+    }
+};
+
+template <class T> class Multigrid : public SolverSetup
+{
+public:
+    /**
+     * Constructor. Builds the levels and factors the coarsest matrix.
+     * @param A system of the finest level.
+     * @param cycleType MULTIGRID_V_CYCLE or MULTIGRID_W_CYCLE.
+     * @param coarsening MULTIGRID_COARSENING_REFINEMENT or MULTIGRID_COARSENING_AGGREGATION.
+     * @param smoother MULTIGRID_SMOOTHER_GAUSS_SEIDEL or MULTIGRID_SMOOTHER_CHEBYSHEV.
+     */
+    Multigrid(const SparseSystem<T> &A, int cycleType, int coarsening, int smoother)
+    {
+        this->cycleType  = cycleType;
+        this->coarsening = coarsening;
+        this->smoother   = smoother;
+        setStructure(A.vertices, A.rowStart, A.column);
+        levels.push_back( MultigridLevel<T>() );
+        MultigridLevel<T> &fine = levels[0];
+        fine.n        = A.n;
+        fine.rowStart = A.rowStart;
+        fine.column   = A.column;
+        fine.value    = A.value;
+        fine.diagonal = A.diagonal;
+        allocate(fine);
+        if (coarsening == MULTIGRID_COARSENING_AGGREGATION)
+        {
+            while (levels.back().n > MULTIGRID_COARSEST_SIZE)
+            {
+                int n = levels.back().n;
+                int numberOfAggregates = aggregate(levels.back());
+                if (numberOfAggregates > MULTIGRID_MAX_COARSENING_RATIO * n)
+                    break;
+                addCoarseLevel(numberOfAggregates);
+            }
+        }
+        else
+            coarsenByRefinement(A);
+        factorCoarsest();
+        buildSmoothers();
+    }
+    /**
+     * Recomputes the values of the levels for a system with the same sparsity: the same vertices with the same
+       adjacent vertices, maybe in other order (Cuthill-McKee). The fine matrix, the prolongations, the coarse
+       matrices and the factorization of the coarsest one are recomputed; the coarse unknowns (or aggregates)
+       of the constructor are kept.
+     * @return false, without changing the levels, if the sparsity is not the same.
+     */
+    bool update(const SparseSystem<T> &A)
+    {
+        vector<int> newOrder, position;
+        if (!matchStructure(A.vertices, A.rowStart, A.column, newOrder, position))
+            return false;
+        order.swap(newOrder);
+        MultigridLevel<T> &fine = levels[0];
+        for (int i = 0; i < A.n; i++)
+        {
+            fine.diagonal[order[i]] = A.diagonal[i];
+            for (int k = A.rowStart[i]; k < A.rowStart[i + 1]; k++)
+                fine.value[position[k]] = A.value[k];
+        }
+        for (int l = 0; l + 1 < (int) levels.size(); l++)
+        {
+            buildProlongation(l);
+            galerkinProduct(l);
+        }
+        factorCoarsest();
+        buildSmoothers();
+        return true;
+    }
+    /**
+     * Checks the cycle type (MULTIGRID_V_CYCLE or MULTIGRID_W_CYCLE), the coarsening of the levels and the smoother.
+     */
+    bool hasOptions(int cycleType, int coarsening, int smoother) const
+    {
+        return (this->cycleType == cycleType) && (this->coarsening == coarsening) && (this->smoother == smoother);
+    }
+    /**
+     * Number of levels, including the finest.
+     */
+    int getNumberOfLevels() const
+    {
+        return (int) levels.size();
+    }
+    /**
+     * Number of unknowns of the level (0 = finest).
+     */
+    int getSize(int level) const
+    {
+        return levels[level].n;
+    }
+    /**
+     * Multiply-adds of one cycle (smoothing, residuals, transfers between the levels and the coarsest solve), counting
+       the two coarse cycles of each level of the W cycle.
+     */
+    double getCycleWork() const
+    {
+        double work = 0.0, visits = 1.0;
+        for (int l = 0; l < (int) levels.size(); l++)
+        {
+            const MultigridLevel<T> &level = levels[l];
+            double product = level.n + (double) level.column.size();
+            if (l == (int) levels.size() - 1)
+                work += visits * ( coarseFactor.empty() ? 2.0 * MULTIGRID_COARSEST_SWEEPS * product : (double) level.n * level.n );
+            else
+            {
+                double smoothing = (smoother == MULTIGRID_SMOOTHER_CHEBYSHEV) ? 2.0 * MULTIGRID_CHEBYSHEV_DEGREE * (product + 2.0 * level.n)
+                                                                             : 2.0 * MULTIGRID_SMOOTHING_SWEEPS * product;
+                work += visits * ( smoothing + product + 2.0 * level.prolongationColumn.size() );
+                if (cycleType == MULTIGRID_W_CYCLE && l + 1 < (int) levels.size() - 1)
+                    visits *= 2.0;
+            }
+        }
+        return work;
+    }
+    /**
+     * One cycle for Au = b starting from u; u is overwritten by the improved solution.
+     */
+    void cycle(vector<T> &u, const vector<T> &b)
+    {
+        MultigridLevel<T> &fine = levels[0];
+        for (int i = 0; i < fine.n; i++)
+        {
+            fine.x[order[i]] = u[i];
+            fine.b[order[i]] = b[i];
+        }
+        cycleLevel(0);
+        for (int i = 0; i < fine.n; i++)
+            u[i] = fine.x[order[i]];
+    }
+    /**
+     * Preconditioner z = M^-1 r: one cycle for Az = r starting from z = 0.
+     */
+    void precondition(const vector<T> &r, vector<T> &z)
+    {
+        MultigridLevel<T> &fine = levels[0];
+        for (int i = 0; i < fine.n; i++)
+        {
+            fine.x[i] = 0.0;
+            fine.b[order[i]] = r[i];
+        }
+        cycleLevel(0);
+        for (int i = 0; i < fine.n; i++)
+            z[i] = fine.x[order[i]];
+    }
+
+private:
+    //
+    // Attributes
+    //
+    int cycleType;                      /**< MULTIGRID_V_CYCLE or MULTIGRID_W_CYCLE (number of coarse cycles per cycle) */
+    int coarsening;                     /**< MULTIGRID_COARSENING_REFINEMENT or MULTIGRID_COARSENING_AGGREGATION */
+    int smoother;                       /**< MULTIGRID_SMOOTHER_GAUSS_SEIDEL or MULTIGRID_SMOOTHER_CHEBYSHEV */
+    vector< MultigridLevel<T> > levels; /**< levels[0] is the finest level */
+    vector< Chebyshev< T, MultigridLevel<T> > > smoothers; /**< Chebyshev smoothers of the levels above the coarsest */
+    vector<T> coarseFactor;             /**< LDL^T of the coarsest matrix: L below the diagonal and D on the diagonal (row-major) */
+    //
+    // Methods
+    //
+    /**
+     * Allocates the vectors of the cycle of the level.
+     */
+    static void allocate(MultigridLevel<T> &level)
+    {
+        level.x.assign(level.n, T(0.0));
+        level.b.assign(level.n, T(0.0));
+        level.r.assign(level.n, T(0.0));
+    }
+    /**
+     * Geometric coarsening: the levels of the refinement stages, then maximal independent sets.
+     */
+    void coarsenByRefinement(const SparseSystem<T> &A)
+    {
+        // Refinement stages: the unknowns of the stage s are the vertices created up to the stage s
+        vector<int> stage(A.n);
+        int minStage = 0, maxStage = 0;
+        for (int i = 0; i < A.n; i++)
+        {
+            stage[i] = A.vertices[i]->refinementLevel;
+            if (i == 0 || stage[i] < minStage)
+                minStage = stage[i];
+            if (i == 0 || stage[i] > maxStage)
+                maxStage = stage[i];
+        }
+        for (int s = maxStage - 1; s >= minStage && levels.back().n > MULTIGRID_COARSEST_SIZE; s--)
+        {
+            int n = levels.back().n, numberOfCoarse = 0;
+            vector<bool> isCoarse(n);
+            for (int i = 0; i < n; i++)
+            {
+                isCoarse[i] = (stage[i] <= s);
+                if (isCoarse[i])
+                    numberOfCoarse++;
+            }
+            if (numberOfCoarse == 0)
+                break;
+            if (numberOfCoarse > MULTIGRID_MAX_COARSENING_RATIO * n) // Few vertices created by the stage s + 1, joins it to the stage s
+                continue;
+            addCoarseLevel( selectCoarse(levels.back(), isCoarse) );
+            const MultigridLevel<T> &fine = levels[levels.size() - 2];
+            vector<int> coarseStage(levels.back().n);
+            for (int i = 0; i < n; i++)
+                if (fine.coarseIndex[i] >= 0)
+                    coarseStage[fine.coarseIndex[i]] = stage[i];
+            stage.swap(coarseStage);
+        }
+        // Algebraic coarsening of the coarsest stage
+        while (levels.back().n > MULTIGRID_COARSEST_SIZE)
+        {
+            int n = levels.back().n, numberOfCoarse = 0;
+            vector<bool> isCoarse = independentSet(levels.back(), numberOfCoarse);
+            if (numberOfCoarse > MULTIGRID_MAX_COARSENING_RATIO * n)
+                break;
+            addCoarseLevel( selectCoarse(levels.back(), isCoarse) );
+        }
+    }
+    /**
+     * Maximal independent set of the graph of the matrix of the level, chosen in the order of the unknowns.
+     */
+    static vector<bool> independentSet(const MultigridLevel<T> &level, int &numberOfCoarse)
+    {
+        vector<bool> isCoarse(level.n, false), decided(level.n, false);
+        numberOfCoarse = 0;
+        for (int i = 0; i < level.n; i++)
+        {
+            if (decided[i])
+                continue;
+            isCoarse[i] = decided[i] = true;
+            numberOfCoarse++;
+            for (int k = level.rowStart[i]; k < level.rowStart[i + 1]; k++)
+                decided[level.column[k]] = true;
+        }
+        return isCoarse;
+    }
+    /**
+     * Numbers the coarse unknowns of the geometric coarsening (level.coarseIndex). The unknowns marked by isCoarse
+       are kept, the other ones without a coarse neighbour are kept too.
+     * @return number of coarse unknowns.
+     */
+    static int selectCoarse(MultigridLevel<T> &level, vector<bool> &isCoarse)
+    {
+        int nc = 0;
+        level.coarseIndex.assign(level.n, -1);
+        for (int i = 0; i < level.n; i++)
+        {
+            if (!isCoarse[i])
+            {
+                bool hasCoarseNeighbour = false;
+                for (int k = level.rowStart[i]; k < level.rowStart[i + 1] && !hasCoarseNeighbour; k++)
+                    hasCoarseNeighbour = isCoarse[level.column[k]] && level.value[k] != 0.0;
+                isCoarse[i] = !hasCoarseNeighbour;
+            }
+            if (isCoarse[i])
+                level.coarseIndex[i] = nc++;
+        }
+        return nc;
+    }
+    /**
+     * Aggregation of the unknowns of the level by the strong connections |a_ij| >= theta * sqrt(a_ii * a_jj)
+       (Vanek, Mandel and Brezina): aggregates of an unknown and all its strong neighbours not yet aggregated,
+       then the remaining unknowns join a neighbour aggregate, then the last ones form new aggregates.
+       The aggregate of each unknown is stored in level.coarseIndex.
+     * @return number of aggregates.
+     */
+    static int aggregate(MultigridLevel<T> &level)
+    {
+        int n = level.n, numberOfAggregates = 0;
+        T theta = MULTIGRID_STRENGTH_THRESHOLD * MULTIGRID_STRENGTH_THRESHOLD;
+        vector<bool> strong(level.column.size());
+        for (int i = 0; i < n; i++)
+            for (int k = level.rowStart[i]; k < level.rowStart[i + 1]; k++)
+                strong[k] = ( level.value[k] * level.value[k] >= theta * level.diagonal[i] * level.diagonal[level.column[k]] );
+        vector<int> &index = level.coarseIndex;
+        index.assign(n, -1);
+        // Unknowns with all their strong neighbours free
+        for (int i = 0; i < n; i++)
+        {
+            bool isFree = (index[i] < 0);
+            for (int k = level.rowStart[i]; k < level.rowStart[i + 1] && isFree; k++)
+                if (strong[k] && index[level.column[k]] >= 0)
+                    isFree = false;
+            if (!isFree)
+                continue;
+            index[i] = numberOfAggregates;
+            for (int k = level.rowStart[i]; k < level.rowStart[i + 1]; k++)
+                if (strong[k])
+                    index[level.column[k]] = numberOfAggregates;
+            numberOfAggregates++;
+        }
+        // The remaining unknowns join the aggregate of a strong neighbour of the first pass
+        vector<int> firstPass(index);
+        for (int i = 0; i < n; i++)
+        {
+            if (index[i] >= 0)
+                continue;
+            for (int k = level.rowStart[i]; k < level.rowStart[i + 1] && index[i] < 0; k++)
+                if (strong[k] && firstPass[level.column[k]] >= 0)
+                    index[i] = firstPass[level.column[k]];
+        }
+        // New aggregates of the unknowns still free
+        for (int i = 0; i < n; i++)
+        {
+            if (index[i] >= 0)
+                continue;
+            index[i] = numberOfAggregates;
+            for (int k = level.rowStart[i]; k < level.rowStart[i + 1]; k++)
+                if (strong[k] && index[level.column[k]] < 0)
+                    index[level.column[k]] = numberOfAggregates;
+            numberOfAggregates++;
+        }
+        return numberOfAggregates;
+    }
+    /**
+     * Adds the level below the current coarsest one, with the unknowns numbered in coarseIndex of the coarsest level.
+     * @param numberOfCoarse number of unknowns of the new level.
+     */
+    void addCoarseLevel(int numberOfCoarse)
+    {
+        levels.push_back( MultigridLevel<T>() );
+        levels.back().n = numberOfCoarse;
+        int l = (int) levels.size() - 2;
+        buildProlongation(l);
+        galerkinProduct(l);
+        allocate(levels.back());
+    }
+    /**
+     * Prolongation from the level l + 1 to the level l with the current values of the matrix of the level l.
+     */
+    void buildProlongation(int l)
+    {
+        MultigridLevel<T> &fine = levels[l];
+        int n = fine.n;
+        fine.prolongationStart.assign(n + 1, 0);
+        fine.prolongationColumn.clear();
+        fine.prolongationWeight.clear();
+        if (coarsening == MULTIGRID_COARSENING_AGGREGATION)
+        {
+            // Damped Jacobi smoothing of the aggregates: P = (I - omega D^-1 A) P_tentative,
+            // omega = 4 / (3 rho), rho = Gershgorin bound of the spectral radius of D^-1 A
+            T rho = 0.0;
+            for (int i = 0; i < n; i++)
+            {
+                T sum = fabs(fine.diagonal[i]);
+                for (int k = fine.rowStart[i]; k < fine.rowStart[i + 1]; k++)
+                    sum += fabs(fine.value[k]);
+                sum /= fine.diagonal[i];
+                if (sum > rho)
+                    rho = sum;
+            }
+            T omega = T(4.0) / (T(3.0) * rho);
+            vector<int> marker(levels[l + 1].n, -1);
+            for (int i = 0; i < n; i++)
+            {
+                int start = (int) fine.prolongationColumn.size();
+                T scale = omega / fine.diagonal[i];
+                for (int k = fine.rowStart[i] - 1; k < fine.rowStart[i + 1]; k++)
+                {
+                    int j = (k < fine.rowStart[i]) ? i : fine.column[k]; // The diagonal first
+                    T w = (k < fine.rowStart[i]) ? T(1.0 - omega) : T(-scale * fine.value[k]);
+                    int J = fine.coarseIndex[j];
+                    if (marker[J] < start)
+                    {
+                        marker[J] = (int) fine.prolongationColumn.size();
+                        fine.prolongationColumn.push_back(J);
+                        fine.prolongationWeight.push_back(w);
+                    }
+                    else
+                        fine.prolongationWeight[marker[J]] += w;
+                }
+                fine.prolongationStart[i + 1] = (int) fine.prolongationColumn.size();
+            }
+            return;
+        }
+        // Injection of the coarse unknowns, direct interpolation of the fine ones
+        for (int i = 0; i < n; i++)
+        {
+            if (fine.coarseIndex[i] >= 0)
+            {
+                fine.prolongationColumn.push_back(fine.coarseIndex[i]);
+                fine.prolongationWeight.push_back( T(1.0) );
+            }
+            else
+            {
+                T sumAll = 0.0, sumCoarse = 0.0;
+                for (int k = fine.rowStart[i]; k < fine.rowStart[i + 1]; k++)
+                {
+                    sumAll += fine.value[k];
+                    if (fine.coarseIndex[fine.column[k]] >= 0)
+                        sumCoarse += fine.value[k];
+                }
+                if (sumCoarse != 0.0) // The coarse neighbours can lose their weights after update(): only smoothing
+                {
+                    T scale = -(sumAll / sumCoarse) / fine.diagonal[i];
+                    for (int k = fine.rowStart[i]; k < fine.rowStart[i + 1]; k++)
+                    {
+                        if (fine.coarseIndex[fine.column[k]] >= 0)
+                        {
+                            fine.prolongationColumn.push_back(fine.coarseIndex[fine.column[k]]);
+                            fine.prolongationWeight.push_back(scale * fine.value[k]);
+                        }
+                    }
+                }
+            }
+            fine.prolongationStart[i + 1] = (int) fine.prolongationColumn.size();
+        }
+    }
+    /**
+     * Matrix of the level l + 1: Galerkin product R * A * P, R = P^T, with the prolongation of the level l.
+     */
+    void galerkinProduct(int l)
+    {
+        MultigridLevel<T> &fine = levels[l], &coarse = levels[l + 1];
+        int n = fine.n, nc = coarse.n;
+        // AP
+        vector<int> apStart(n + 1, 0), apColumn, marker(nc, -1);
+        vector<T> apValue, accumulator(nc, T(0.0));
+        vector<int> touched;
+        for (int i = 0; i < n; i++)
+        {
+            touched.clear();
+            for (int k = fine.rowStart[i] - 1; k < fine.rowStart[i + 1]; k++)
+            {
+                int j = (k < fine.rowStart[i]) ? i : fine.column[k]; // The diagonal first
+                const T &a = (k < fine.rowStart[i]) ? fine.diagonal[i] : fine.value[k];
+                for (int p = fine.prolongationStart[j]; p < fine.prolongationStart[j + 1]; p++)
+                {
+                    int J = fine.prolongationColumn[p];
+                    if (marker[J] != i)
+                    {
+                        marker[J] = i;
+                        accumulator[J] = 0.0;
+                        touched.push_back(J);
+                    }
+                    accumulator[J] += a * fine.prolongationWeight[p];
+                }
+            }
+            for (size_t t = 0; t < touched.size(); t++)
+            {
+                apColumn.push_back(touched[t]);
+                apValue.push_back(accumulator[touched[t]]);
+            }
+            apStart[i + 1] = (int) apColumn.size();
+        }
+        // Transpose of P (restriction)
+        vector<int> rStart(nc + 1, 0), rColumn(fine.prolongationColumn.size());
+        vector<T> rWeight(fine.prolongationColumn.size());
+        for (size_t p = 0; p < fine.prolongationColumn.size(); p++)
+            rStart[fine.prolongationColumn[p] + 1]++;
+        for (int J = 0; J < nc; J++)
+            rStart[J + 1] += rStart[J];
+        vector<int> position(rStart.begin(), rStart.end() - 1);
+        for (int i = 0; i < n; i++)
+        {
+            for (int p = fine.prolongationStart[i]; p < fine.prolongationStart[i + 1]; p++)
+            {
+                int J = fine.prolongationColumn[p];
+                rColumn[position[J]] = i;
+                rWeight[position[J]] = fine.prolongationWeight[p];
+                position[J]++;
+            }
+        }
+        // R * (AP)
+        coarse.rowStart.assign(nc + 1, 0);
+        coarse.column.clear();
+        coarse.value.clear();
+        coarse.diagonal.assign(nc, T(0.0));
+        marker.assign(nc, -1);
+        for (int I = 0; I < nc; I++)
+        {
+            touched.clear();
+            for (int p = rStart[I]; p < rStart[I + 1]; p++)
+            {
+                int i = rColumn[p];
+                for (int q = apStart[i]; q < apStart[i + 1]; q++)
+                {
+                    int J = apColumn[q];
+                    if (marker[J] != I)
+                    {
+                        marker[J] = I;
+                        accumulator[J] = 0.0;
+                        touched.push_back(J);
+                    }
+                    accumulator[J] += rWeight[p] * apValue[q];
+                }
+            }
+            for (size_t t = 0; t < touched.size(); t++)
+            {
+                int J = touched[t];
+                if (J == I)
+                    coarse.diagonal[I] = accumulator[J];
+                else
+                {
+                    coarse.column.push_back(J);
+                    coarse.value.push_back(accumulator[J]);
+                }
+            }
+            coarse.rowStart[I + 1] = (int) coarse.column.size();
+        }
+    }
+    /**
+     * LDL^T factorization of the matrix of the coarsest level (dense), if it has at most MULTIGRID_COARSEST_SIZE unknowns.
+     */
+    void factorCoarsest()
+    {
+        const MultigridLevel<T> &level = levels.back();
+        int n = level.n;
+        if (n > MULTIGRID_COARSEST_SIZE) // Not coarsened (weak connections): solved by smoothing
+        {
+            coarseFactor.clear();
+            return;
+        }
+        coarseFactor.assign( (size_t) n * n, T(0.0) );
+        for (int i = 0; i < n; i++)
+        {
+            coarseFactor[(size_t) i * n + i] = level.diagonal[i];
+            for (int k = level.rowStart[i]; k < level.rowStart[i + 1]; k++)
+                coarseFactor[(size_t) i * n + level.column[k]] = level.value[k];
+        }
+        vector<T> v(n);
+        for (int j = 0; j < n; j++)
+        {
+            T *rowJ = &coarseFactor[(size_t) j * n];
+            for (int k = 0; k < j; k++)
+                v[k] = rowJ[k] * coarseFactor[(size_t) k * n + k];
+            for (int k = 0; k < j; k++)
+                rowJ[j] -= rowJ[k] * v[k];
+            if (rowJ[j] <= 0.0)
+            {
+                cerr << "ERROR - Multigrid::factorCoarsest - the coarsest matrix is not positive definite." << endl;
+                exit(EXIT_FAILURE);
+            }
+            for (int i = j + 1; i < n; i++)
+            {
+                T *rowI = &coarseFactor[(size_t) i * n];
+                for (int k = 0; k < j; k++)
+                    rowI[j] -= rowI[k] * v[k];
+                rowI[j] /= rowJ[j];
+            }
+        }
+    }
+    /**
+     * Solves the system of the coarsest level with the factorization of factorCoarsest(). A coarsest level that
+       could not be coarsened is not factored: its matrix is dominated by the diagonal, and MULTIGRID_COARSEST_SWEEPS
+       pairs of forward and backward Gauss-Seidel sweeps are applied instead.
+     */
+    void solveCoarsest()
+    {
+        MultigridLevel<T> &level = levels.back();
+        int n = level.n;
+        vector<T> &x = level.x;
+        if (n > MULTIGRID_COARSEST_SIZE) // Starts from x: zero for a coarse level, the solution of the cycle for a single level
+        {
+            for (int s = 0; s < MULTIGRID_COARSEST_SWEEPS; s++)
+            {
+                level.smooth(true);
+                level.smooth(false);
+            }
+            return;
+        }
+        x = level.b;
+        for (int i = 0; i < n; i++)        // L y = b
+            for (int k = 0; k < i; k++)
+                x[i] -= coarseFactor[(size_t) i * n + k] * x[k];
+        for (int i = 0; i < n; i++)        // D z = y
+            x[i] /= coarseFactor[(size_t) i * n + i];
+        for (int i = n - 1; i >= 0; i--)   // L^T x = z
+            for (int k = i + 1; k < n; k++)
+                x[i] -= coarseFactor[(size_t) k * n + i] * x[k];
+    }
+    /**
+     * Chebyshev smoothers of the levels above the coarsest, on [MULTIGRID_CHEBYSHEV_RATIO * maximum, maximum] with the
+       Gershgorin bound of the eigenvalues of D^-1 A of each level (the lower part is left to the coarse correction).
+     */
+    void buildSmoothers()
+    {
+        smoothers.clear();
+        if (smoother != MULTIGRID_SMOOTHER_CHEBYSHEV)
+            return;
+        for (int l = 0; l + 1 < (int) levels.size(); l++)
+        {
+            smoothers.push_back( Chebyshev< T, MultigridLevel<T> >(&levels[l]) );
+            T maximum = smoothers[l].getMaximum();
+            smoothers[l].setInterval(maximum * MULTIGRID_CHEBYSHEV_RATIO, maximum);
+        }
+    }
+    /**
+     * Pre-smoothing (forward) or post-smoothing of the level l.
+     */
+    void smoothLevel(int l, bool forward)
+    {
+        MultigridLevel<T> &level = levels[l];
+        if (smoother == MULTIGRID_SMOOTHER_CHEBYSHEV)
+        {
+            smoothers[l].smooth(level.x, level.b, MULTIGRID_CHEBYSHEV_DEGREE);
+            return;
+        }
+        for (int s = 0; s < MULTIGRID_SMOOTHING_SWEEPS; s++)
+            level.smooth(forward);
+    }
+    /**
+     * Cycle on the level l for the system of the level (x and b): pre-smoothing, coarse correction
+       (one coarse cycle for the V cycle, two for the W cycle) and post-smoothing.
+     */
+    void cycleLevel(int l)
+    {
+        if (l == (int) levels.size() - 1)
+        {
+            solveCoarsest();
+            return;
+        }
+        MultigridLevel<T> &fine = levels[l], &coarse = levels[l + 1];
+        smoothLevel(l, true);
+        for (int i = 0; i < fine.n; i++)
+            fine.r[i] = fine.b[i] - fine.multiplyRow(fine.x, i);
+        // Restriction b_c = P^T r
+        for (int I = 0; I < coarse.n; I++)
+        {
+            coarse.b[I] = 0.0;
+            coarse.x[I] = 0.0;
+        }
+        for (int i = 0; i < fine.n; i++)
+            for (int p = fine.prolongationStart[i]; p < fine.prolongationStart[i + 1]; p++)
+                coarse.b[fine.prolongationColumn[p]] += fine.prolongationWeight[p] * fine.r[i];
+        int coarseCycles = (cycleType == MULTIGRID_W_CYCLE && l + 1 < (int) levels.size() - 1) ? 2 : 1;
+        for (int c = 0; c < coarseCycles; c++)
+            cycleLevel(l + 1);
+        // Prolongation x = x + P x_c
+        for (int i = 0; i < fine.n; i++)
+            for (int p = fine.prolongationStart[i]; p < fine.prolongationStart[i + 1]; p++)
+                fine.x[i] += fine.prolongationWeight[p] * coarse.x[fine.prolongationColumn[p]];
+        smoothLevel(l, false);
+    }
+};
+
+#endif // MULTIGRID_H_INCLUDED
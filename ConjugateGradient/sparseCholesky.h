@@ -0,0 +1,205 @@
+/****** Declaration and implementation of the class SparseCholesky ******/
+/* Sparse LDL^T factorization of the system of a SparseSystem (up-looking algorithm of the LDL package of
+   T. A. Davis). The unknowns are factored in the order of the system, which is the order of the list of
+   vertices: the reverse Cuthill-McKee order when Mesh::cuthillMcKee is executed. The symbolic analysis
+   (elimination tree and nonzeros of each column of L) is done once per sparsity; while the system keeps the
+   same vertices and edges, setValues() only copies the new coefficients and the numeric factorization is
+   repeated only if they changed. No square root is computed, so the factorization works with any working
+   type of the solvers. Header only. */
+
+#ifndef SPARSECHOLESKY_H_INCLUDED
+#define SPARSECHOLESKY_H_INCLUDED
+
+#include <vector>
+#include "sparseSystem.h"
+using namespace std;
+
+template <class T> class SparseCholesky : public SolverSetup
+{
+public:
+    /**
+     * Constructor. Symbolic analysis and numeric factorization of the system.
+     * @param A system in compressed sparse rows.
+     */
+    SparseCholesky(const SparseSystem<T> &A)
+    {
+        n = A.n;
+        setStructure(A.vertices, A.rowStart, A.column);
+        value    = A.value;
+        diagonal = A.diagonal;
+        analyze();
+        factor();
+    }
+    /**
+     * Copies the coefficients of a system with the same sparsity (the same vertices and edges, maybe in other order).
+       The factor is marked as outdated if any coefficient changed.
+     * @return false, without changing the coefficients, if the sparsity is not the same.
+     */
+    bool setValues(const SparseSystem<T> &A)
+    {
+        vector<int> newOrder, position;
+        if (!matchStructure(A.vertices, A.rowStart, A.column, newOrder, position))
+            return false;
+        order.swap(newOrder);
+        for (int i = 0; i < n; i++)
+        {
+            int si = order[i];
+            if (diagonal[si] != A.diagonal[i])
+            {
+                diagonal[si] = A.diagonal[i];
+                current = false;
+            }
+            for (int k = A.rowStart[i]; k < A.rowStart[i + 1]; k++)
+            {
+                if (value[position[k]] != A.value[k])
+                {
+                    value[position[k]] = A.value[k];
+                    current = false;
+                }
+            }
+        }
+        return true;
+    }
+    /**
+     * The factor is of the current coefficients.
+     */
+    bool isCurrent() const
+    {
+        return current;
+    }
+    /**
+     * Number of nonzeros of L, below the diagonal.
+     */
+    int getFactorSize() const
+    {
+        return lStart[n];
+    }
+    /**
+     * Numeric factorization A = L D L^T of the current coefficients, with the symbolic analysis of the constructor.
+     */
+    void factor()
+    {
+        vector<int> pattern(n), flag(n), lNonzeros(n);
+        vector<T> y(n, T(0.0));
+        for (int k = 0; k < n; k++)
+        {
+            // Nonzero pattern of the row k of L: the paths of the elimination tree from the nonzeros of the column k of A
+            int top = n;
+            flag[k] = k;
+            lNonzeros[k] = 0;
+            y[k] = diagonal[k];
+            for (int p = rowStart[k]; p < rowStart[k + 1]; p++)
+            {
+                int i = column[p];
+                if (i > k)
+                    continue;
+                y[i] += value[p];
+                int length = 0;
+                for ( ; flag[i] != k; i = parent[i])
+                {
+                    pattern[length++] = i;
+                    flag[i] = k;
+                }
+                while (length > 0)
+                    pattern[--top] = pattern[--length];
+            }
+            // Sparse triangular solve for the row k of L
+            d[k] = y[k];
+            y[k] = 0.0;
+            for ( ; top < n; top++)
+            {
+                int i = pattern[top];
+                T yi = y[i];
+                y[i] = 0.0;
+                int pEnd = lStart[i] + lNonzeros[i];
+                for (int p = lStart[i]; p < pEnd; p++)
+                    y[lIndex[p]] -= lValue[p] * yi;
+                T lki = yi / d[i];
+                d[k] -= lki * yi;
+                lIndex[pEnd] = k;
+                lValue[pEnd] = lki;
+                lNonzeros[i]++;
+            }
+            if (d[k] <= 0.0)
+            {
+                cerr << "ERROR - SparseCholesky::factor - the matrix is not positive definite (pivot " << k << ")." << endl;
+                exit(EXIT_FAILURE);
+            }
+        }
+        current = true;
+    }
+    /**
+     * Solves Ax = b with the factor (x and b in the order of the last system).
+     */
+    void solve(const vector<T> &b, vector<T> &x)
+    {
+        for (int i = 0; i < n; i++)
+            work[order[i]] = b[i];
+        for (int j = 0; j < n; j++)         // L y = b
+            for (int p = lStart[j]; p < lStart[j + 1]; p++)
+                work[lIndex[p]] -= lValue[p] * work[j];
+        for (int j = 0; j < n; j++)         // D z = y
+            work[j] /= d[j];
+        for (int j = n - 1; j >= 0; j--)    // L^T x = z
+            for (int p = lStart[j]; p < lStart[j + 1]; p++)
+                work[j] -= lValue[p] * work[lIndex[p]];
+        for (int i = 0; i < n; i++)
+            x[i] = work[order[i]];
+    }
+    /**
+     * Preconditioner z = M^-1 r with the factor, possibly of older coefficients.
+     */
+    void precondition(const vector<T> &r, vector<T> &z)
+    {
+        solve(r, z);
+    }
+
+private:
+    //
+    // Attributes
+    //
+    int n;                /**< Number of unknowns */
+    vector<T> value;      /**< Current off-diagonal coefficients (positions of SolverSetup::column) */
+    vector<T> diagonal;   /**< Current diagonal */
+    vector<int> parent;   /**< Elimination tree: parent[k] is the parent of the column k (-1 for a root) */
+    vector<int> lStart;   /**< Entries of the column j of L are in [lStart[j], lStart[j + 1]) */
+    vector<int> lIndex;   /**< Row of the entries of L */
+    vector<T> lValue;     /**< Value of the entries of L */
+    vector<T> d;          /**< Diagonal D */
+    vector<T> work;       /**< Vector of solve() */
+    bool current;         /**< The factor is of the current coefficients */
+    //
+    // Methods
+    //
+    /**
+     * Symbolic analysis: elimination tree and number of nonzeros of each column of L.
+     */
+    void analyze()
+    {
+        vector<int> flag(n), lNonzeros(n, 0);
+        parent.assign(n, -1);
+        for (int k = 0; k < n; k++)
+        {
+            flag[k] = k;
+            for (int p = rowStart[k]; p < rowStart[k + 1]; p++)
+            {
+                for (int i = column[p]; i < k && flag[i] != k; i = parent[i])
+                {
+                    if (parent[i] == -1)
+                        parent[i] = k;
+                    lNonzeros[i]++;
+                    flag[i] = k;
+                }
+            }
+        }
+        lStart.assign(n + 1, 0);
+        for (int k = 0; k < n; k++)
+            lStart[k + 1] = lStart[k] + lNonzeros[k];
+        lIndex.resize(lStart[n]);
+        lValue.assign(lStart[n], T(0.0));
+        d.assign(n, T(0.0));
+        work.assign(n, T(0.0));
+    }
+};
+
+#endif // SPARSECHOLESKY_H_INCLUDED
@@ -0,0 +1,269 @@
+/****** Declaration and implementation of the class SparseSystem ******/
+/* Copy of the linear system Au = b assembled by the Finite Volume Method on the grid's Vertex,
+   converted to the working type T and stored in compressed sparse rows. Only the internal vertices
+   are copied (the border vertices have fixed values). Header only. */
+
+#ifndef SPARSESYSTEM_H_INCLUDED
+#define SPARSESYSTEM_H_INCLUDED
+
+#include <limits>
+#include <map>
+#include <vector>
+#include "../Vertex/vertex.h"
+#include "../Adjacency/adjacency.h"
+using namespace std;
+
+/**
+ * Conversion of realNumber to the working type of the solvers.
+ */
+inline void convertReal(const realNumber &from, double &to)
+{
+    from.conv(to);
+}
+
+#if REAL_NUMBER_TYPE == REAL_NUMBER_MPFR
+template <mpfr::real_prec_t _prec, mpfr::real_rnd_t _rnd>
+inline void convertReal(const realNumber &from, mpfr::real<_prec, _rnd> &to)
+{
+    to = mpfr::real<_prec, _rnd>(from);
+}
+#else
+inline void convertReal(const realNumber &from, realNumber &to)
+{
+    to = from;
+}
+#endif
+
+/**
+ * Conversion of the working type of the solvers to long double (for reports).
+ */
+inline long double toLongDouble(const double &x)
+{
+    return x;
+}
+
+template <class T> inline long double toLongDouble(const T &x)
+{
+    long double y;
+    x.conv(y);
+    return y;
+}
+
+/**
+ * Machine epsilon of the working type of the solvers (the argument selects the type).
+ */
+inline double machineEpsilon(const double &)
+{
+    return numeric_limits<double>::epsilon();
+}
+
+#if REAL_NUMBER_TYPE == REAL_NUMBER_MPFR
+template <mpfr::real_prec_t _prec, mpfr::real_rnd_t _rnd>
+inline mpfr::real<_prec, _rnd> machineEpsilon(const mpfr::real<_prec, _rnd> &)
+{
+    mpfr::real<_prec, _rnd> epsilon;
+    mpfr_set_ui_2exp(epsilon._x, 1, 1 - (mpfr_exp_t) _prec, _rnd);
+    return epsilon;
+}
+#else
+inline realNumber machineEpsilon(const realNumber &)
+{
+    return realNumber::epsilon();
+}
+#endif
+
+/**
+ * Bytes of a number of the working type of the solvers (the significand of mpfr::real), for the reports of memory traffic.
+ */
+inline int bytesOfReal(const double &)
+{
+    return sizeof(double);
+}
+
+#if REAL_NUMBER_TYPE == REAL_NUMBER_MPFR
+template <mpfr::real_prec_t _prec, mpfr::real_rnd_t _rnd>
+inline int bytesOfReal(const mpfr::real<_prec, _rnd> &)
+{
+    return (int) (_prec / 8);
+}
+#else
+inline int bytesOfReal(const realNumber &)
+{
+    return sizeof(realNumber);
+}
+#endif
+
+/**
+ * Base class of the setups of the solvers (multigrid levels, factorizations) kept between solves. Stores the
+   sparsity of the system of the setup, so a later system with the same vertices and edges (maybe in other
+   order, after Cuthill-McKee) can reuse it.
+ */
+class SolverSetup
+{
+public:
+    virtual ~SolverSetup() {}
+
+protected:
+    //
+    // Attributes
+    //
+    vector<int> vertexIds;     /**< Vertex::id of the unknowns of the setup (the vertices may be moved in memory by
+                                    Mesh::renumberVertices(), so they are matched by id) */
+    vector<int> order;         /**< order[i] is the unknown of the setup of the unknown i of the last system */
+    vector<int> rowStart;      /**< Off-diagonal entries of the row i of the setup are in [rowStart[i], rowStart[i + 1]) */
+    vector<int> column;        /**< Column of the off-diagonal entries */
+    //
+    // Methods
+    //
+    /**
+     * Stores the sparsity of the system of the setup.
+     */
+    void setStructure(const vector<Vertex *> &vertices, const vector<int> &rowStart, const vector<int> &column)
+    {
+        setVertices(vertices);
+        this->rowStart = rowStart;
+        this->column   = column;
+        order.resize(vertices.size());
+        for (size_t i = 0; i < vertices.size(); i++)
+            order[i] = (int) i;
+    }
+    /**
+     * Stores the Vertex::id of the unknowns of the setup.
+     */
+    void setVertices(const vector<Vertex *> &vertices)
+    {
+        vertexIds.resize(vertices.size());
+        for (size_t i = 0; i < vertices.size(); i++)
+            vertexIds[i] = vertices[i]->id;
+    }
+    /**
+     * Compares the sparsity of a system with the sparsity of the setup.
+     * @param newOrder unknown of the setup of each unknown of the system.
+     * @param position position in the setup of each off-diagonal entry of the system.
+     * @return true if the system has the same vertices and edges.
+     */
+    bool matchStructure(const vector<Vertex *> &systemVertices, const vector<int> &systemRowStart, const vector<int> &systemColumn,
+                        vector<int> &newOrder, vector<int> &position) const
+    {
+        int n = (int) vertexIds.size();
+        if ((int) systemVertices.size() != n || systemColumn.size() != column.size())
+            return false;
+        bool sameOrder = true;
+        for (int i = 0; i < n && sameOrder; i++)
+            sameOrder = (systemVertices[i]->id == vertexIds[order[i]]);
+        if (sameOrder)
+            newOrder = order;
+        else
+        {
+            map<int, int> index;
+            for (int i = 0; i < n; i++)
+                index[vertexIds[i]] = i;
+            newOrder.resize(n);
+            for (int i = 0; i < n; i++)
+            {
+                map<int, int>::const_iterator it = index.find(systemVertices[i]->id);
+                if (it == index.end())
+                    return false;
+                newOrder[i] = it->second;
+            }
+        }
+        position.resize(systemColumn.size());
+        for (int i = 0; i < n; i++)
+        {
+            int si = newOrder[i];
+            if (systemRowStart[i + 1] - systemRowStart[i] != rowStart[si + 1] - rowStart[si])
+                return false;
+            for (int k = systemRowStart[i]; k < systemRowStart[i + 1]; k++)
+            {
+                int sj = newOrder[systemColumn[k]], kk = rowStart[si];
+                while (kk < rowStart[si + 1] && column[kk] != sj)
+                    kk++;
+                if (kk == rowStart[si + 1])
+                    return false;
+                position[k] = kk;
+            }
+        }
+        return true;
+    }
+};
+
+template <class T> class SparseSystem
+{
+public:
+    //
+    // Attributes
+    //
+    int n;                     /**< Number of unknowns (internal vertices) */
+    vector<Vertex *> vertices; /**< vertices[i] is the vertex of the unknown i */
+    vector<int> rowStart;      /**< Off-diagonal entries of the row i are in [rowStart[i], rowStart[i + 1]) */
+    vector<int> column;        /**< Column of the off-diagonal entries */
+    vector<T> value;           /**< Value of the off-diagonal entries */
+    vector<T> diagonal;        /**< Diagonal of the matrix */
+    vector<T> b;               /**< Right-hand side */
+    vector<T> u;               /**< Solution */
+    //
+    // Methods
+    //
+    /**
+     * Constructor. Copies the system of the vertices list.
+     * @param firstVertex first vertex of the mesh.
+     */
+    SparseSystem(Vertex *firstVertex)
+    {
+        map<Vertex *, int> index;
+        for (Vertex *iVertex = firstVertex; iVertex != NULL; iVertex = iVertex->next)
+        {
+            if(iVertex->isBorder == false) // is not at the border
+            {
+                index[iVertex] = (int) vertices.size();
+                vertices.push_back(iVertex);
+            }
+        }
+        n = (int) vertices.size();
+        rowStart.assign(n + 1, 0);
+        diagonal.resize(n);
+        b.resize(n);
+        u.resize(n);
+        for (int i = 0; i < n; i++)
+        {
+            Vertex *iVertex = vertices[i];
+            convertReal(iVertex->coefficient, diagonal[i]);
+            convertReal(iVertex->b, b[i]);
+            convertReal(iVertex->u, u[i]);
+            for(list<Adjacency *>::iterator it = iVertex->adjList.begin(); it != iVertex->adjList.end(); it++)  /* for all adjacent vertices */
+            {
+                Vertex *adjVertex = (*it)->getVertex(ADJ_VERTEX_ONE);
+                if(adjVertex == iVertex)
+                    adjVertex = (*it)->getVertex(ADJ_VERTEX_TWO);
+                if ( adjVertex->isBorder == false )  // is not at the border
+                {
+                    T a;
+                    convertReal((*it)->coefficient, a);
+                    column.push_back(index[adjVertex]);
+                    value.push_back(a);
+                }
+            }
+            rowStart[i + 1] = (int) column.size();
+        }
+    }
+    /**
+     * Row i of the product y = Ax.
+     */
+    T multiplyRow(const vector<T> &x, int i) const
+    {
+        T y = diagonal[i] * x[i];
+        for (int k = rowStart[i]; k < rowStart[i + 1]; k++)
+            y += value[k] * x[column[k]];
+        return y;
+    }
+    /**
+     * Copies the solution u to the vertices, converting it to realNumber.
+     */
+    void storeSolution() const
+    {
+        for (int i = 0; i < n; i++)
+            vertices[i]->u = realNumber(u[i]);
+    }
+};
+
+#endif // SPARSESYSTEM_H_INCLUDED
@@ -4,9 +4,9 @@
 
 #include <sstream>
 #include <vector>
-void FiniteVolume::solve(Vertex *firstVertex, mpfr::real<MPFR_BITS_PRECISION> &delta_t)
+void FiniteVolume::solve(Vertex *firstVertex, realNumber &delta_t)
 {                          
-    mpfr::real<MPFR_BITS_PRECISION> *k = NULL;
+    realNumber *k = NULL;
 
     Vertex *vertexIterator = firstVertex;    
     while( vertexIterator != 0 )
@@ -41,7 +41,7 @@ void FiniteVolume::solve(Vertex *firstVertex, mpfr::real<MPFR_BITS_PRECISION> &d
 void FiniteVolume::computeBorderV( Vertex *p, Vertex *v)
 {
     // Distance of circuncenter of triangles which shared edge (p, v) / Distance of p to v
-    mpfr::real<MPFR_BITS_PRECISION> *distance = NULL, *distanceInterfaceDivDistanceVertices = NULL;
+    realNumber *distance = NULL, *distanceInterfaceDivDistanceVertices = NULL;
     distance = Utils::distance(p, v);
     distanceInterfaceDivDistanceVertices = distCircuncenterTrianglesShareInterface(p, v);     
     *distanceInterfaceDivDistanceVertices = (*distanceInterfaceDivDistanceVertices) / (*distance);
@@ -54,7 +54,7 @@ void FiniteVolume::computeBorderV( Vertex *p, Vertex *v)
 
 void FiniteVolume::computeInternalV( Vertex *p, Adjacency *listV)
 {
-    mpfr::real<MPFR_BITS_PRECISION> *distance = NULL, *distanceInterfaceDivDistanceVertices = NULL;
+    realNumber *distance = NULL, *distanceInterfaceDivDistanceVertices = NULL;
     Vertex *adjVertex = listV->getVertex(ADJ_VERTEX_ONE);  
     if(adjVertex == p) // If true, get next vertice of edge
         adjVertex = listV->getVertex(ADJ_VERTEX_TWO);
@@ -70,9 +70,9 @@ void FiniteVolume::computeInternalV( Vertex *p, Adjacency *listV)
     delete distanceInterfaceDivDistanceVertices;   
 }
 
-mpfr::real<MPFR_BITS_PRECISION> *FiniteVolume::distCircuncenterTrianglesShareInterface( Vertex *v1, Vertex *v2 )
+realNumber *FiniteVolume::distCircuncenterTrianglesShareInterface( Vertex *v1, Vertex *v2 )
 {
-    mpfr::real<MPFR_BITS_PRECISION> *distanceCircuncenterTrianglesShareInterface = new mpfr::real<MPFR_BITS_PRECISION> (0);
+    realNumber *distanceCircuncenterTrianglesShareInterface = new realNumber (0);
     Adjacency *adj = v1->getAdjacency(v2); // Get the Adjacency with vertex v1 and v2. 
     Triangle *c1 = adj->getTriangle(ADJ_TRIANGLE_ONE);
     Triangle *c2 = adj->getTriangle(ADJ_TRIANGLE_TWO);  
@@ -82,9 +82,9 @@ mpfr::real<MPFR_BITS_PRECISION> *FiniteVolume::distCircuncenterTrianglesShareInt
     return distanceCircuncenterTrianglesShareInterface;
 }
 
-mpfr::real<MPFR_BITS_PRECISION> *FiniteVolume::areaDivDeltaT(Vertex *v, mpfr::real<MPFR_BITS_PRECISION> &delta_t)
+realNumber *FiniteVolume::areaDivDeltaT(Vertex *v, realNumber &delta_t)
 {    
-    mpfr::real<MPFR_BITS_PRECISION> *area = Utils::areaPolygon(v);      
+    realNumber *area = Utils::areaPolygon(v);      
     *area = *area / delta_t;
     return area;    
 }
\ No newline at end of file
@@ -13,7 +13,7 @@ public:
      * Solve the mesh by Method Finite Volume.
      * @param firstVertex first vertice of mesh.
      */    
-    static void solve(Vertex *firstVertex, mpfr::real<MPFR_BITS_PRECISION> &delta_t);
+    static void solve(Vertex *firstVertex, realNumber &delta_t);
 
 private:
     /**
@@ -22,7 +22,7 @@ private:
      * @param v2 vertice of edge shared.
      * @return euclidian distance of cincuncenters of triangles.
      */
-    static mpfr::real<MPFR_BITS_PRECISION> *distCircuncenterTrianglesShareInterface( Vertex *v1, Vertex *v2 );
+    static realNumber *distCircuncenterTrianglesShareInterface( Vertex *v1, Vertex *v2 );
     /**
      * Computer a border vertex
      * @param v1 vertice
@@ -41,7 +41,7 @@ private:
      * @param delta_t value of diference of time
      * @return area divided by delta_t
      */
-    static mpfr::real<MPFR_BITS_PRECISION> *areaDivDeltaT(Vertex *v, mpfr::real<MPFR_BITS_PRECISION> &delta_t);
+    static realNumber *areaDivDeltaT(Vertex *v, realNumber &delta_t);
 
 };
 #endif // FINITEVOLUME_H_INCLUDED
@@ -1,6 +1,9 @@
 #include <cmath>
 #include <vector> // ReverseCuthillMcKee
 #include <algorithm> // ReverseCuthillMcKee
+#include <new> // renumberVertices
+#include <map> // repairMovedTriangles
+#include <set> // repairMovedTriangles
 #include "mesh.h"
 Mesh::Mesh()
 {
@@ -8,7 +11,19 @@ Mesh::Mesh()
     this->last              = 0;
     this->numberOfTriangles = 0;
     this->numberOfVertices  = 0;
+    this->refinementLevel   = 0;
+    this->nextVertexId      = 0;
+    this->topologyVersion   = 0;
     this->vertexFunction    = 0;
+    this->hasOrdering       = false;
+    this->orderingVersion   = 0;
+    this->orderingGeometryVersion = 0;
+    this->geometryVersion   = 0;
+    this->orderingMethod    = MESH_ORDERING_CUTHILL_MCKEE;
+    this->orderingReverse   = false;
+    this->orderingStartingVertex = 0;
+    this->vertexBlock       = NULL;
+    this->vertexBlockSize   = 0;
 }
 
 Mesh::~Mesh()
@@ -26,9 +41,10 @@ Mesh::~Mesh()
     while(itv != 0)
     {
         Vertex *aux = itv->next;
-        delete itv;
+        destroyVertex(itv);
         itv = aux;
     }
+    ::operator delete(this->vertexBlock);
 }
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -43,7 +59,7 @@ void Mesh::initialize(string fileName)
     /** ___________________________ Creating the vertices ___________________________ **/
     Vertex *vertices[this->numberOfVertices];
     list<Vertex *> insertList; /* List of vertices to be inserted in the triangulation. */
-    mpfr::real<MPFR_BITS_PRECISION> x = 0, y = 0;
+    realNumber x = 0, y = 0;
     int verticesToRead = this->numberOfVertices;
     for(int i = 0; i < verticesToRead; ++i)
     {
@@ -79,7 +95,7 @@ void Mesh::createInitialTriangulation()
     int xmax = 0, xmin = 0, ymax = 0, ymin = 0;    
     while( v != NULL )
     {      
-        mpfr::real<MPFR_BITS_PRECISION> *x = NULL, *y = NULL; 
+        realNumber *x = NULL, *y = NULL; 
         x = &(v->x);
         y = &(v->y);
         if( *x > xmax )
@@ -93,7 +109,7 @@ void Mesh::createInitialTriangulation()
         v = v->next;
     }
     /** Set the distance between the bounding box and the 'extreme' vertices of the PSLG. **/
-    mpfr::real<MPFR_BITS_PRECISION> x_aux = 0, y_aux = 0;
+    realNumber x_aux = 0, y_aux = 0;
     int distX_aux = 0, distY_aux = 0;
     distX_aux = (xmax - xmin)/16;
     distY_aux = (ymax - ymin)/16;    
@@ -138,7 +154,7 @@ int Mesh::maintainsDelaunay(Triangle *t, Adjacency *edge)
     if(t0 != NULL && t1 != NULL)
     {
         int number_t1_v0 = 0, number_t1_v1 = 0;
-        mpfr::real<MPFR_BITS_PRECISION> *distSQR = NULL;
+        realNumber *distSQR = NULL;
         if( t == t1 )
         {
             t1 = t0;
@@ -185,7 +201,7 @@ int Mesh::maintainsDelaunay()
     this->toFlip.clear();
     for( list<Adjacency *>::iterator it = this->edges.begin(); it != this->edges.end(); ++it )
     {    
-        mpfr::real<MPFR_BITS_PRECISION> *distSQR = NULL;
+        realNumber *distSQR = NULL;
         Triangle *t0 = NULL, *t1 = NULL;     
         t0 = (*it)->getTriangle(ADJ_TRIANGLE_ONE);
         t1 = (*it)->getTriangle(ADJ_TRIANGLE_TWO);        
@@ -338,7 +354,7 @@ bool Mesh::insertVertice(Vertex *v, Triangle *t)
         cerr << "ERROR - Mesh::insertVertice - Vertex already exists- x: " << v->x << " y: "<< v->y << endl;
         return false;        
     }
-    mpfr::real<MPFR_BITS_PRECISION> *orientation1 = NULL, *orientation2 = NULL, *orientation3 = NULL;
+    realNumber *orientation1 = NULL, *orientation2 = NULL, *orientation3 = NULL;
     orientation1 = Utils::orientation(v->x, v->y, v0, v1);
     *orientation1 = fabs(*orientation1);
     orientation2 = Utils::orientation(v->x, v->y, v0, v2);
@@ -381,7 +397,7 @@ bool Mesh::insertVertice(Vertex *v, Triangle *t)
     return true;
 }
 
-void Mesh::insertCircuncenterOff(Triangle *t, mpfr::real<MPFR_BITS_PRECISION> *offCenter)
+void Mesh::insertCircuncenterOff(Triangle *t, realNumber *offCenter)
 {
     Vertex *v;
     if( offCenter == NULL )    /** To insert in the circumcenter. **/
@@ -397,7 +413,7 @@ void Mesh::insertCircuncenterOff(Triangle *t, mpfr::real<MPFR_BITS_PRECISION> *o
     }
 }
 
-void Mesh::calculateOffCenter(Triangle *t, mpfr::real<MPFR_BITS_PRECISION> &b, mpfr::real<MPFR_BITS_PRECISION> *offCenter)
+void Mesh::calculateOffCenter(Triangle *t, realNumber &b, realNumber *offCenter)
 {
     /** SHORTEST EDGE **/
     Adjacency *edge = t->getSmallerEdge();
@@ -414,23 +430,23 @@ void Mesh::calculateOffCenter(Triangle *t, mpfr::real<MPFR_BITS_PRECISION> &b, m
     else
     {
         /* HALF/LENGTH OF THE SHORTEST EDGE */
-        mpfr::real<MPFR_BITS_PRECISION> *length = Utils::distance(v0,v1);
-        mpfr::real<MPFR_BITS_PRECISION> hlength = (*length)/2.0;
+        realNumber *length = Utils::distance(v0,v1);
+        realNumber hlength = (*length)/2.0;
         /* MIDPOINT OF THE SHORTEST EDGE */
-        mpfr::real<MPFR_BITS_PRECISION> midPoint[2];
+        realNumber midPoint[2];
         midPoint[COORDINATE_X] = ( v0->x + v1->x )/2.0;
         midPoint[COORDINATE_Y] = ( v0->y + v1->y )/2.0;
         /* NORMALIZED VECTOR FROM DE MIDPOINT TO THE CIRCUMCENTER */
-        mpfr::real<MPFR_BITS_PRECISION> perpVector[2];
-        mpfr::real<MPFR_BITS_PRECISION> *lvector = Utils::distance(t->cCenter[COORDINATE_X], t->cCenter[COORDINATE_Y], midPoint[COORDINATE_X], midPoint[COORDINATE_Y]);
+        realNumber perpVector[2];
+        realNumber *lvector = Utils::distance(t->cCenter[COORDINATE_X], t->cCenter[COORDINATE_Y], midPoint[COORDINATE_X], midPoint[COORDINATE_Y]);
         perpVector[COORDINATE_X] = (t->cCenter[COORDINATE_X] - midPoint[COORDINATE_X])/(*lvector);
         perpVector[COORDINATE_Y] = (t->cCenter[COORDINATE_Y] - midPoint[COORDINATE_Y])/(*lvector);
 	delete lvector;
         /* RADIUS OF THE CIRCUMCIRCLE OF THE TRIANGLE WITH THE SHORTEST EDGE AND THE OFF-CENTER */
-        mpfr::real<MPFR_BITS_PRECISION> radius = b * (*length);
+        realNumber radius = b * (*length);
 	delete length;
         /* Distance between the midPoint and the circumcenter of the new triangle */
-        mpfr::real<MPFR_BITS_PRECISION> radius1 = sqrt( (radius*radius) - (hlength*hlength) );
+        realNumber radius1 = sqrt( (radius*radius) - (hlength*hlength) );
         /* */
         perpVector[COORDINATE_X] = perpVector[COORDINATE_X]*(radius1+radius);
         perpVector[COORDINATE_Y] = perpVector[COORDINATE_Y]*(radius1+radius);
@@ -577,7 +593,7 @@ void Mesh::splitEdge(Vertex *v, Adjacency *edge)
 // "DELAUNAY REFINEMENT" methods
 
 ////////////////////////////////////////////////////////////////////////////////
-int Mesh::refine(mpfr::real<MPFR_BITS_PRECISION> &B, int refinementType)
+int Mesh::refine(realNumber &B, int refinementType)
 {
     toRefineByAngleCriterion = triangleList;
     int totalRefined = 0;
@@ -599,7 +615,7 @@ int Mesh::refine(mpfr::real<MPFR_BITS_PRECISION> &B, int refinementType)
             }
             else /**  Off-center refinement. **/
             {
-                mpfr::real<MPFR_BITS_PRECISION> *offCenter = new mpfr::real<MPFR_BITS_PRECISION>[2];
+                realNumber *offCenter = new realNumber[2];
                 offCenter[COORDINATE_X] = 0;
                 offCenter[COORDINATE_Y] = 0;
                 calculateOffCenter(t, B, offCenter);
@@ -629,7 +645,7 @@ void Mesh::refineTriangle(Triangle *t )
 // "ENCROACHED" methods
 
 ////////////////////////////////////////////////////////////////////////////////
-bool Mesh::splitEncroachedSegments(mpfr::real<MPFR_BITS_PRECISION> px, mpfr::real<MPFR_BITS_PRECISION> py)
+bool Mesh::splitEncroachedSegments(realNumber px, realNumber py)
 {
     bool r = false;
     list<Adjacency *> encroached1 = this->segments;
@@ -642,8 +658,8 @@ bool Mesh::splitEncroachedSegments(mpfr::real<MPFR_BITS_PRECISION> px, mpfr::rea
             r = true;
             Vertex *v0 = seg->getVertex(ADJ_VERTEX_ONE);
             Vertex *v1 = seg->getVertex(ADJ_VERTEX_TWO);
-            mpfr::real<MPFR_BITS_PRECISION> x = (v0->x + v1->x)/2;
-            mpfr::real<MPFR_BITS_PRECISION> y = (v0->y + v1->y)/2;
+            realNumber x = (v0->x + v1->x)/2;
+            realNumber y = (v0->y + v1->y)/2;
             Vertex *v = createVertex( x, y );
             this->splitEdge(v, seg);
             Adjacency *newSeg0 = v->getAdjacency(v0);
@@ -664,8 +680,8 @@ void Mesh::splitEncroachedSegments()
         Adjacency *segment = this->encroachedS.front();
         Vertex *v0 = segment->getVertex(ADJ_VERTEX_ONE);
         Vertex *v1 = segment->getVertex(ADJ_VERTEX_TWO);
-        mpfr::real<MPFR_BITS_PRECISION> x = (v0->x + v1->x)/2;
-        mpfr::real<MPFR_BITS_PRECISION> y = (v0->y + v1->y)/2;
+        realNumber x = (v0->x + v1->x)/2;
+        realNumber y = (v0->y + v1->y)/2;
         Vertex *v = createVertex(x, y);
         if(segment->type == ADJ_SEG_NOT_TRI) // is a segment, but not in the triangulation
         {
@@ -691,20 +707,20 @@ bool Mesh::isEncroached(Adjacency *seg)
     number_v0 = tmp->getNumber(v0);
     number_v1 = tmp->getNumber(v1);
     number_v3 = 3 - (number_v0 + number_v1);
-    if( tmp->angles[number_v3] > 90 ) /* Verify if the segment opposite to a obtuse angle. */
+    if( tmp->obtuseAngles[number_v3] ) /* Verify if the segment opposite to a obtuse angle. */
         return true;
     return false;
 }
 
-bool Mesh::isEncroached(mpfr::real<MPFR_BITS_PRECISION> &px, mpfr::real<MPFR_BITS_PRECISION> &py, Adjacency *seg)
+bool Mesh::isEncroached(realNumber &px, realNumber &py, Adjacency *seg)
 {   
     Vertex *v0 = seg->getVertex(ADJ_VERTEX_ONE);
     Vertex *v1 = seg->getVertex(ADJ_VERTEX_TWO);
-    mpfr::real<MPFR_BITS_PRECISION> centerX = 0, centerY = 0;
+    realNumber centerX = 0, centerY = 0;
     centerX = (v0->x + v1->x)/2.0;
     centerY = (v0->y + v1->y)/2.0;
-    mpfr::real<MPFR_BITS_PRECISION> *radiusSQR = Utils::distanceSQR(centerX, centerY, v0);
-    mpfr::real<MPFR_BITS_PRECISION> *distSqrToPoint = Utils::distanceSQR(px, py, centerX, centerY);
+    realNumber *radiusSQR = Utils::distanceSQR(centerX, centerY, v0);
+    realNumber *distSqrToPoint = Utils::distanceSQR(px, py, centerX, centerY);
     bool r = ( (*distSqrToPoint - *radiusSQR) < 0);
     delete distSqrToPoint;
     delete radiusSQR;
@@ -801,9 +817,11 @@ void Mesh::setVertexFunction(functionV *function)
     this->vertexFunction = function;
 }
 
-Vertex *Mesh::createVertex(mpfr::real<MPFR_BITS_PRECISION> &x, mpfr::real<MPFR_BITS_PRECISION> &y)
+Vertex *Mesh::createVertex(realNumber &x, realNumber &y)
 {
     Vertex *v = new Vertex(x, y, -1);
+    v->refinementLevel = this->refinementLevel;
+    v->id = this->nextVertexId++;
     if (CONFIG_DEBUG_MODE)     
     {
         Vertex *vertexIterator = this->first;
@@ -826,6 +844,7 @@ Vertex *Mesh::createVertex(mpfr::real<MPFR_BITS_PRECISION> &x, mpfr::real<MPFR_B
         this->last = v;
     }
     ++numberOfVertices;
+    ++topologyVersion;
 
     if( this->vertexFunction != NULL )
         this->vertexFunction(v);  
@@ -856,10 +875,19 @@ void Mesh::deleteVertex(Vertex *v)
         last = pre;
     if(vi == first)
         first = vi->next;
-    delete v;
+    destroyVertex(v);
+    ++topologyVersion;
 //    this->numberOfVertices--;
 }
 
+void Mesh::destroyVertex(Vertex *v)
+{
+    if ( (v >= this->vertexBlock) && (v < this->vertexBlock + this->vertexBlockSize) )
+        v->~Vertex();
+    else
+        delete v;
+}
+
 /* _____________________TRIANGLE_____________________ */
 Triangle *Mesh::createTriangle(Vertex *v0, Vertex *v1, Vertex *v2)
 {
@@ -877,6 +905,7 @@ Triangle *Mesh::createTriangle(Vertex *v0, Vertex *v1, Vertex *v2)
     }    
     Triangle *t = new Triangle(v0, v1, v2);
     ++numberOfTriangles;
+    ++topologyVersion;
     v0->incList.push_back(t); /** Updates the incidences lists **/
     v1->incList.push_back(t);
     v2->incList.push_back(t);
@@ -916,6 +945,7 @@ void Mesh::deleteTriangle(Triangle *t)
     this->toRefineByAdjCriterion.remove(t);
     this->toRemove.remove(t);
     --numberOfTriangles;
+    ++topologyVersion;
     delete t;
 }
 
@@ -946,6 +976,7 @@ void Mesh::removeTriangles(functionR *function)
 
 Adjacency *Mesh::createAdjacency(Vertex *v0, Vertex *v1, Triangle *t0, Triangle *t1, int seg)
 {
+    ++topologyVersion;
     Adjacency *newEdge = v0->getAdjacency(v1);
     if( newEdge == NULL )  /* The adjacency not exist yet. */
     {
@@ -986,6 +1017,7 @@ Adjacency *Mesh::createAdjacency(Vertex *v0, Vertex *v1, Triangle *t0, Triangle
 
 void Mesh::removeEdge(Adjacency *edge)
 {
+    ++topologyVersion;
     this->edges.remove(edge);
     this->toFlip.remove(edge);
     if( edge->type == ADJ_SEG_ONLY_EDGE )
@@ -1020,7 +1052,7 @@ Triangle *Mesh::findTriangle( Vertex *v )
     return NULL;
 }
 
-Triangle *Mesh::findTriangle(Triangle *t, mpfr::real<MPFR_BITS_PRECISION> &px, mpfr::real<MPFR_BITS_PRECISION> &py)
+Triangle *Mesh::findTriangle(Triangle *t, realNumber &px, realNumber &py)
 {
     queue<Triangle*> tqueue;
     tqueue.push(t); /** Start the search with t. **/
@@ -1061,13 +1093,176 @@ Triangle *Mesh::findTriangle(Triangle *t, mpfr::real<MPFR_BITS_PRECISION> &px, m
 ////////////////////////////////////////////////////////////////////////////////
 bool Mesh::movingMesh( monitorFunction monitorFunction) 
 {
+  this->movedVertices.clear();
+  this->previousCoordinates.clear();
   bool r = monitorFunction(this);         
-    // Update the circumcenter coordinates, the angles of the triangle and the radius-to-shortest edge ratio.
-    for( list<Triangle *>::iterator it = this->triangleList.begin(); it != this->triangleList.end(); ++it )   
-        (*it)->updateSRQ();        
+    // Update the shape regularity quality of the triangles of the displaced vertices
+    updateMovedTriangles(false);
   return r;
 }    
 
+void Mesh::getMovedTriangles(vector<Triangle *> &triangles)
+{
+    triangles.clear();
+    for (size_t i = 0; i < this->movedVertices.size(); i++)
+        triangles.insert(triangles.end(), this->movedVertices[i]->incList.begin(), this->movedVertices[i]->incList.end());
+    // A triangle with two or three displaced vertices is taken once
+    sort(triangles.begin(), triangles.end());
+    triangles.erase(unique(triangles.begin(), triangles.end()), triangles.end());
+}
+
+void Mesh::updateMovedTriangles(bool fullUpdate)
+{
+    if (!this->movedVertices.empty())
+        this->geometryVersion++;
+    vector<Triangle *> triangles;
+    getMovedTriangles(triangles);
+    for (size_t i = 0; i < triangles.size(); i++)
+    {
+        if (fullUpdate)
+            triangles[i]->update();
+        else
+            triangles[i]->updateSRQ();
+    }
+}
+
+int Mesh::repairMovedTriangles(bool &displaced)
+{
+    // Position of each displaced vertex before the movement: the first displacement of a vertex displaced twice
+    map<Vertex *, size_t> origin;
+    for (size_t i = this->movedVertices.size(); i > 0; i--)
+        origin[this->movedVertices[i - 1]] = i - 1;
+    set<Vertex *> repaired;
+    vector<Triangle *> invertedTriangles;
+    int step = 0;
+    while ( !checkMovedTriangles(invertedTriangles) )
+    {
+        set<Vertex *> offending;
+        for (size_t i = 0; i < invertedTriangles.size(); i++)
+            for (int number = TRIANGLE_VERTEX_ONE; number <= TRIANGLE_VERTEX_THREE; number++)
+                if (origin.count(invertedTriangles[i]->getVertex(number)) > 0)
+                    offending.insert(invertedTriangles[i]->getVertex(number));
+        bool changed = false;
+        for (set<Vertex *>::iterator it = offending.begin(); it != offending.end(); ++it)
+        {
+            realNumber &x0 = this->previousCoordinates[2*origin[*it] + COORDINATE_X],
+                       &y0 = this->previousCoordinates[2*origin[*it] + COORDINATE_Y];
+            if ( ((*it)->x == x0) && ((*it)->y == y0) )
+                continue;
+            realNumber x = x0, y = y0;
+            if (step < MESH_ROLLBACK_DAMPING_STEPS)
+            {
+                x = x0 + ((*it)->x - x0) / 2;
+                y = y0 + ((*it)->y - y0) / 2;
+            }
+            (*it)->setXY(x, y);
+            repaired.insert(*it);
+            changed = true;
+        }
+        if ( (!changed) && (step >= MESH_ROLLBACK_DAMPING_STEPS) )
+        {
+            // Inverted triangles without displaced vertices: the mesh was not valid before the movement
+            cerr << "ERROR - Mesh::repairMovedTriangles - inverted triangles not displaced by the movement." << endl;
+            break;
+        }
+        step++;
+    }
+    if (!repaired.empty())
+        updateMovedTriangles(false);
+    displaced = false;
+    for (map<Vertex *, size_t>::iterator it = origin.begin(); (it != origin.end()) && (!displaced); ++it)
+        displaced = (it->first->x != this->previousCoordinates[2*it->second + COORDINATE_X]) ||
+                    (it->first->y != this->previousCoordinates[2*it->second + COORDINATE_Y]);
+    return (int) repaired.size();
+}
+
+int Mesh::interpolateMovedVertices()
+{
+    // Position of each displaced vertex before the movement: the first displacement of a vertex displaced twice
+    map<Vertex *, size_t> origin;
+    for (size_t i = this->movedVertices.size(); i > 0; i--)
+        origin[this->movedVertices[i - 1]] = i - 1;
+    // The values are interpolated from the solution before the movement and assigned at the end
+    vector<Vertex *> interpolated;
+    vector<realNumber> values; // values[k] = u of interpolated[k]
+    for (map<Vertex *, size_t>::iterator it = origin.begin(); it != origin.end(); ++it)
+    {
+        Vertex *v = it->first;
+        for (list<Triangle *>::iterator t = v->incList.begin(); t != v->incList.end(); ++t)
+        {
+            Vertex *vertices[3];
+            realNumber x[3], y[3];
+            for (int number = TRIANGLE_VERTEX_ONE; number <= TRIANGLE_VERTEX_THREE; number++)
+            {
+                int k = number - TRIANGLE_VERTEX_ONE;
+                vertices[k] = (*t)->getVertex(number);
+                map<Vertex *, size_t>::iterator previous = origin.find(vertices[k]);
+                if (previous == origin.end())
+                {
+                    x[k] = vertices[k]->x;
+                    y[k] = vertices[k]->y;
+                } else
+                {
+                    x[k] = this->previousCoordinates[2*previous->second + COORDINATE_X];
+                    y[k] = this->previousCoordinates[2*previous->second + COORDINATE_Y];
+                }
+            }
+            // Barycentric coordinates of the new position in the triangle before the movement
+            realNumber area = (x[1] - x[0])*(y[2] - y[0]) - (x[2] - x[0])*(y[1] - y[0]);
+            if ( !(area > 0) )
+                continue;
+            realNumber l0 = ((x[1] - v->x)*(y[2] - v->y) - (x[2] - v->x)*(y[1] - v->y)) / area,
+                       l1 = ((x[2] - v->x)*(y[0] - v->y) - (x[0] - v->x)*(y[2] - v->y)) / area,
+                       l2 = 1 - l0 - l1;
+            if ( (l0 < 0) || (l1 < 0) || (l2 < 0) )
+                continue;
+            interpolated.push_back(v);
+            values.push_back(l0*vertices[0]->u + l1*vertices[1]->u + l2*vertices[2]->u);
+            break;
+        }
+    }
+    for (size_t k = 0; k < interpolated.size(); k++)
+        interpolated[k]->u = values[k];
+    return (int) interpolated.size();
+}
+
+bool Mesh::checkMovedTriangles(vector<Triangle *> &invertedTriangles)
+{
+    vector<Triangle *> triangles;
+    getMovedTriangles(triangles);
+    invertedTriangles.clear();
+    for (size_t i = 0; i < triangles.size(); i++)
+    {
+        Vertex *v1 = triangles[i]->getVertex(TRIANGLE_VERTEX_ONE);
+        Vertex *v2 = triangles[i]->getVertex(TRIANGLE_VERTEX_TWO);
+        Vertex *v3 = triangles[i]->getVertex(TRIANGLE_VERTEX_THREE);
+        double ax, ay, bx, by, cx, cy;
+        v1->x.conv(ax);
+        v1->y.conv(ay);
+        v2->x.conv(bx);
+        v2->y.conv(by);
+        v3->x.conv(cx);
+        v3->y.conv(cy);
+        // Same expression as Utils::orientation(), with the error of the rounding of the coordinates and of the operations
+        double detLeft  = (ax - cx) * (by - cy),
+               detRight = (bx - cx) * (ay - cy),
+               errorBound = MESH_ORIENTATION_FILTER_ERROR * ( (fabs(ax) + fabs(cx)) * (fabs(by) + fabs(cy)) + (fabs(bx) + fabs(cx)) * (fabs(ay) + fabs(cy)) );
+        if (detLeft - detRight > errorBound)
+            continue;
+        if (detLeft - detRight < -errorBound)
+        {
+            invertedTriangles.push_back(triangles[i]);
+            continue;
+        }
+        // Sign not decided in double
+        realNumber *orientation = Utils::orientation(v1, v2, v3);
+        if ( !(*orientation > 0) )
+            invertedTriangles.push_back(triangles[i]);
+        delete orientation;
+    }
+    return invertedTriangles.empty();
+}
+
 bool Mesh::needsToFlipped(Adjacency *edge)
 {
     Triangle *t0 = edge->getTriangle(ADJ_TRIANGLE_ONE);
@@ -1075,7 +1270,7 @@ bool Mesh::needsToFlipped(Adjacency *edge)
     if(t0 != NULL && t1 != NULL)
     {
         int number_t1_v0 = 0, number_t1_v1 = 0;
-        mpfr::real<MPFR_BITS_PRECISION> *distSQR = NULL;
+        realNumber *distSQR = NULL;
         Vertex *v0 = edge->getVertex(ADJ_VERTEX_ONE);
         Vertex *v1 = edge->getVertex(ADJ_VERTEX_TWO);       
         number_t1_v0 = t1->getNumber(v0);
@@ -1107,7 +1302,7 @@ Mesh *Mesh::cloneMesh()
     Mesh *newMesh = new Mesh();
     struct findMethods
     {  
-	static Vertex *findVertex(Vertex *first, mpfr::real<MPFR_BITS_PRECISION> &x, mpfr::real<MPFR_BITS_PRECISION> &y)
+	static Vertex *findVertex(Vertex *first, realNumber &x, realNumber &y)
 	{
 	    Vertex *vIterator = first;
 	    while (vIterator != NULL) 
@@ -1118,7 +1313,7 @@ Mesh *Mesh::cloneMesh()
 	    }
 	    return NULL;
 	}
-	static Triangle *findTriangle(list<Triangle *> tList, mpfr::real<MPFR_BITS_PRECISION> &x0, mpfr::real<MPFR_BITS_PRECISION> &y0, mpfr::real<MPFR_BITS_PRECISION> &x1, mpfr::real<MPFR_BITS_PRECISION> &y1, mpfr::real<MPFR_BITS_PRECISION> &x2, mpfr::real<MPFR_BITS_PRECISION> &y2)
+	static Triangle *findTriangle(list<Triangle *> tList, realNumber &x0, realNumber &y0, realNumber &x1, realNumber &y1, realNumber &x2, realNumber &y2)
 	{
 	    for( list<Triangle *>::iterator it = tList.begin(); it != tList.end(); ++it)
 	    {
@@ -1132,7 +1327,7 @@ Mesh *Mesh::cloneMesh()
 	    }
 	    return NULL;
 	}
-	static Adjacency *findAdjacency(list<Adjacency *> aList, mpfr::real<MPFR_BITS_PRECISION> &x0, mpfr::real<MPFR_BITS_PRECISION> &y0, mpfr::real<MPFR_BITS_PRECISION> &x1, mpfr::real<MPFR_BITS_PRECISION> &y1)
+	static Adjacency *findAdjacency(list<Adjacency *> aList, realNumber &x0, realNumber &y0, realNumber &x1, realNumber &y1)
 	{
 	    for( list<Adjacency *>::iterator it = aList.begin(); it != aList.end(); ++it)
 	    {
@@ -1157,6 +1352,8 @@ Mesh *Mesh::cloneMesh()
 	v->label 	= vertexIterator->label;
 	v->u      	= vertexIterator->u;
 	v->previews_u   = vertexIterator->previews_u;
+	v->refinementLevel = vertexIterator->refinementLevel;
+	v->id          = vertexIterator->id;
 	vertexIterator = vertexIterator->next;
 	v = NULL;
     }    
@@ -1175,9 +1372,9 @@ Mesh *Mesh::cloneMesh()
       }
       Triangle *t                      = newMesh->createTriangle(v0, v1, v2);
       t->sqrRadius                     = (*it)->sqrRadius;
-      t->angles[TRIANGLE_VERTEX_ONE]   = (*it)->angles[TRIANGLE_VERTEX_ONE];
-      t->angles[TRIANGLE_VERTEX_TWO]   = (*it)->angles[TRIANGLE_VERTEX_TWO];
-      t->angles[TRIANGLE_VERTEX_THREE] = (*it)->angles[TRIANGLE_VERTEX_THREE];
+      t->obtuseAngles[TRIANGLE_VERTEX_ONE]   = (*it)->obtuseAngles[TRIANGLE_VERTEX_ONE];
+      t->obtuseAngles[TRIANGLE_VERTEX_TWO]   = (*it)->obtuseAngles[TRIANGLE_VERTEX_TWO];
+      t->obtuseAngles[TRIANGLE_VERTEX_THREE] = (*it)->obtuseAngles[TRIANGLE_VERTEX_THREE];
       t->radiusEdgeRatio               = (*it)->radiusEdgeRatio;
       t->cCenter[COORDINATE_X]         = (*it)->cCenter[COORDINATE_X];
       t->cCenter[COORDINATE_Y]         = (*it)->cCenter[COORDINATE_Y];  
@@ -1239,6 +1436,8 @@ Mesh *Mesh::cloneMesh()
     }
     newMesh->numberOfTriangles = this->numberOfTriangles;
     newMesh->numberOfVertices  = this->numberOfVertices;
+    newMesh->refinementLevel   = this->refinementLevel;
+    newMesh->nextVertexId      = this->nextVertexId;
     newMesh->setVertexFunction(this->vertexFunction);
     return newMesh;
 }
@@ -1437,6 +1636,10 @@ bool Mesh::smartCheckMesh()
 
 void Mesh::cuthillMcKee(bool reverse, int startingVertex) 
 {     
+    // Same topology and parameters: the list of vertices is already in this order
+    if ( isOrderingCurrent(MESH_ORDERING_CUTHILL_MCKEE, reverse, startingVertex) )
+        return;
+    recordOrdering(MESH_ORDERING_CUTHILL_MCKEE, reverse, startingVertex);
     list<Vertex *> f;
     // Sort list of vertices by degree
     Vertex *v               = this->first,  // UTILS_CM_RANDOM
@@ -1459,8 +1662,9 @@ void Mesh::cuthillMcKee(bool reverse, int startingVertex)
     }       
     if (startingVertex == UTILS_CM_PSEUDOPERIPHERAL)
     {
-        Utils::findPseudoPeripheral(*this); 
-        v = this->first;        
+        Vertex *pseudoPeripheral = Utils::findPseudoPeripheral(*this); 
+        if (pseudoPeripheral != NULL)
+            v = pseudoPeripheral;
     }
     v->visited = true;
     this->first = NULL;
@@ -1521,4 +1725,254 @@ void Mesh::cuthillMcKee(bool reverse, int startingVertex)
             }
         }            
     }   
-}
\ No newline at end of file
+}
+
+bool Mesh::reorder(int ordering, bool reverse, int startingVertex)
+{
+    if (ordering == MESH_ORDERING_HILBERT || ordering == MESH_ORDERING_MORTON)
+    {
+        if ( isOrderingCurrent(ordering, false, 0) )
+            return false;
+        spaceFillingCurve(ordering);
+    }
+    else if (ordering == MESH_ORDERING_NESTED_DISSECTION)
+    {
+        if ( isOrderingCurrent(ordering, false, 0) )
+            return false;
+        nestedDissection();
+    }
+    else if (ordering == MESH_ORDERING_CUTHILL_MCKEE)
+    {
+        if ( isOrderingCurrent(ordering, reverse, startingVertex) )
+            return false;
+        cuthillMcKee(reverse, startingVertex);
+    }
+    else
+    {
+        cerr << "ERROR - Mesh::reorder - invalid ordering " << ordering << endl;
+        exit(EXIT_FAILURE);
+    }
+    return true;
+}
+
+bool Mesh::isOrderingCurrent(int ordering, bool reverse, int startingVertex)
+{
+    bool geometric = (ordering == MESH_ORDERING_HILBERT) || (ordering == MESH_ORDERING_MORTON) || (ordering == MESH_ORDERING_NESTED_DISSECTION);
+    return (this->hasOrdering) && (this->orderingVersion == this->topologyVersion) && (this->orderingMethod == ordering) &&
+           (this->orderingReverse == reverse) && (this->orderingStartingVertex == startingVertex) &&
+           ( (!geometric) || (this->orderingGeometryVersion == this->geometryVersion) );
+}
+
+void Mesh::recordOrdering(int ordering, bool reverse, int startingVertex)
+{
+    this->hasOrdering            = true;
+    this->orderingVersion        = this->topologyVersion;
+    this->orderingGeometryVersion = this->geometryVersion;
+    this->orderingMethod         = ordering;
+    this->orderingReverse        = reverse;
+    this->orderingStartingVertex = startingVertex;
+}
+
+void Mesh::relinkVertices(const vector<Vertex *> &order)
+{
+    int newLabel = 0;
+    this->first = NULL;
+    this->last  = NULL;
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        if (!order[i]->isBorder)
+            order[i]->label = newLabel++;
+        if (this->first == NULL)
+            this->first = order[i];
+        else
+            this->last->next = order[i];
+        this->last = order[i];
+    }
+    if (this->last != NULL)
+        this->last->next = NULL;
+}
+
+unsigned long long Mesh::curveKey(int curve, unsigned int x, unsigned int y)
+{
+    unsigned long long key = 0;
+    if (curve == MESH_ORDERING_MORTON) // Interleaved bits
+    {
+        for (int bit = MESH_SPACE_FILLING_CURVE_BITS - 1; bit >= 0; bit--)
+            key = (key << 2) | ( ((x >> bit) & 1u) << 1 ) | ((y >> bit) & 1u);
+        return key;
+    }
+    // Hilbert: quadrant of each level, rotating the lower quadrants
+    unsigned int size = 1u << MESH_SPACE_FILLING_CURVE_BITS;
+    for (unsigned int s = size / 2; s > 0; s /= 2)
+    {
+        unsigned int rx = (x & s) ? 1 : 0, ry = (y & s) ? 1 : 0;
+        key += (unsigned long long) s * s * ( (3 * rx) ^ ry );
+        if (ry == 0)
+        {
+            if (rx == 1)
+            {
+                x = size - 1 - x;
+                y = size - 1 - y;
+            }
+            unsigned int t = x;
+            x = y;
+            y = t;
+        }
+    }
+    return key;
+}
+
+void Mesh::spaceFillingCurve(int curve)
+{
+    if ( isOrderingCurrent(curve, false, 0) )
+        return;
+    recordOrdering(curve, false, 0);
+    vector<Vertex *> vertices;
+    vector<double> x, y;
+    double xMin = 0, xMax = 0, yMin = 0, yMax = 0;
+    for (Vertex *vertexIterator = this->first; vertexIterator != NULL; vertexIterator = vertexIterator->next)
+    {
+        double vx, vy;
+        vertexIterator->x.conv(vx);
+        vertexIterator->y.conv(vy);
+        if ( vertices.empty() || vx < xMin ) xMin = vx;
+        if ( vertices.empty() || vx > xMax ) xMax = vx;
+        if ( vertices.empty() || vy < yMin ) yMin = vy;
+        if ( vertices.empty() || vy > yMax ) yMax = vy;
+        vertices.push_back(vertexIterator);
+        x.push_back(vx);
+        y.push_back(vy);
+    }
+    // Keys of the coordinates scaled to the grid of the curve (the position in the list breaks the ties)
+    double cells = (double) ( (1u << MESH_SPACE_FILLING_CURVE_BITS) - 1 ),
+           scale = max(xMax - xMin, yMax - yMin);
+    if (scale <= 0)
+        scale = 1;
+    vector< pair<unsigned long long, int> > keys(vertices.size());
+    for (size_t i = 0; i < vertices.size(); i++)
+    {
+        unsigned int gx = (unsigned int) ( (x[i] - xMin) / scale * cells ),
+                     gy = (unsigned int) ( (y[i] - yMin) / scale * cells );
+        keys[i] = make_pair(curveKey(curve, gx, gy), (int) i);
+    }
+    sort(keys.begin(), keys.end());
+    vector<Vertex *> order(vertices.size());
+    for (size_t i = 0; i < keys.size(); i++)
+        order[i] = vertices[keys[i].second];
+    relinkVertices(order);
+}
+
+void Mesh::nestedDissection()
+{
+    if ( isOrderingCurrent(MESH_ORDERING_NESTED_DISSECTION, false, 0) )
+        return;
+    recordOrdering(MESH_ORDERING_NESTED_DISSECTION, false, 0);
+    vector<Vertex *> vertices;
+    vector<int> rowStart, neighbor;
+    Utils::getInternalGraph(*this, vertices, rowStart, neighbor);
+    int n = (int) vertices.size();
+    vector<double> x(n), y(n);
+    vector<int> part(n), side(n, 0), order;
+    for (int i = 0; i < n; i++)
+    {
+        vertices[i]->x.conv(x[i]);
+        vertices[i]->y.conv(y[i]);
+        part[i] = i;
+    }
+    order.reserve(n);
+    dissect(part, x, y, rowStart, neighbor, side, order);
+    vector<Vertex *> newOrder;
+    newOrder.reserve(this->numberOfVertices);
+    for (int i = 0; i < n; i++)
+        newOrder.push_back(vertices[order[i]]);
+    for (Vertex *vertexIterator = this->first; vertexIterator != NULL; vertexIterator = vertexIterator->next)
+    {
+        if (vertexIterator->isBorder)
+            newOrder.push_back(vertexIterator);
+    }
+    relinkVertices(newOrder);
+}
+
+void Mesh::dissect(vector<int> &part, const vector<double> &x, const vector<double> &y, const vector<int> &rowStart,
+                   const vector<int> &neighbor, vector<int> &side, vector<int> &order)
+{
+    if ( (int) part.size() <= MESH_NESTED_DISSECTION_MINIMUM )
+    {
+        order.insert(order.end(), part.begin(), part.end());
+        return;
+    }
+    // Median of the longest side of the bounding box
+    double xMin = x[part[0]], xMax = xMin, yMin = y[part[0]], yMax = yMin;
+    for (size_t k = 1; k < part.size(); k++)
+    {
+        xMin = min(xMin, x[part[k]]);
+        xMax = max(xMax, x[part[k]]);
+        yMin = min(yMin, y[part[k]]);
+        yMax = max(yMax, y[part[k]]);
+    }
+    const vector<double> &coordinate = (xMax - xMin >= yMax - yMin) ? x : y;
+    vector< pair<double, int> > sorted(part.size());
+    for (size_t k = 0; k < part.size(); k++)
+        sorted[k] = make_pair(coordinate[part[k]], part[k]);
+    sort(sorted.begin(), sorted.end());
+    size_t half = sorted.size() / 2;
+    for (size_t k = 0; k < sorted.size(); k++)
+        side[sorted[k].second] = (k < half) ? 1 : 2;
+    // Separator: vertices of the first half adjacent to the second half
+    vector<int> first, second, separator;
+    for (size_t k = 0; k < sorted.size(); k++)
+    {
+        int v = sorted[k].second;
+        if (k >= half)
+        {
+            second.push_back(v);
+            continue;
+        }
+        bool isSeparator = false;
+        for (int j = rowStart[v]; j < rowStart[v + 1] && !isSeparator; j++)
+            isSeparator = (side[neighbor[j]] == 2);
+        if (isSeparator)
+            separator.push_back(v);
+        else
+            first.push_back(v);
+    }
+    for (size_t k = 0; k < part.size(); k++)
+        side[part[k]] = 0;
+    part.clear();
+    dissect(first, x, y, rowStart, neighbor, side, order);
+    dissect(second, x, y, rowStart, neighbor, side, order);
+    order.insert(order.end(), separator.begin(), separator.end());
+}
+
+void Mesh::renumberVertices()
+{
+    // Already in the block in the order of the list
+    int n = 0;
+    bool inOrder = true;
+    for (Vertex *vertexIterator = this->first; vertexIterator != NULL; vertexIterator = vertexIterator->next, n++)
+    {
+        if (vertexIterator != this->vertexBlock + n)
+            inOrder = false;
+    }
+    if ( (inOrder) && (n == this->vertexBlockSize) )
+        return;
+    Vertex *block = static_cast<Vertex *>( ::operator new(n * sizeof(Vertex)) );
+    Vertex *vertexIterator = this->first;
+    for (int i = 0; i < n; i++)
+    {
+        Vertex *copy = new (&block[i]) Vertex(*vertexIterator);
+        for( list<Adjacency *>::iterator adj = copy->adjList.begin(); adj != copy->adjList.end(); adj++ )
+            (*adj)->replaceVertex(vertexIterator, copy);
+        for( list<Triangle *>::iterator t = copy->incList.begin(); t != copy->incList.end(); t++ )
+            (*t)->replaceVertex(vertexIterator, copy);
+        copy->next = (i + 1 < n) ? &block[i + 1] : NULL;
+        Vertex *nextVertex = vertexIterator->next;
+        destroyVertex(vertexIterator);
+        vertexIterator = nextVertex;
+    }
+    ::operator delete(this->vertexBlock);
+    this->vertexBlock     = block;
+    this->vertexBlockSize = n;
+    this->first           = (n > 0) ? &block[0] : NULL;
+    this->last            = (n > 0) ? &block[n - 1] : NULL;
+}
@@ -6,6 +6,7 @@
 #include "../Utils/utils.h"
 #include <string>
 #include <list>
+#include <vector>
 #include <queue>
 #include <fstream> // file stream
 
@@ -28,6 +29,12 @@ public:
     list<Adjacency *> segments;    /**<  List of all segments. The segment may or may not be present in the triangulation. If the segment is in triangulation, then it is in the list of edges too. */
     int numberOfVertices;          /**<  Total of vertices in the triangulation. */
     int numberOfTriangles;         /**<  Total of triangles in the triangulation. */    
+    int refinementLevel;           /**<  Refinement stage assigned to the vertices created (Vertex::refinementLevel). */
+    int nextVertexId;              /**<  Vertex::id of the next vertex created by createVertex(). */
+    unsigned long topologyVersion; /**<  Incremented by every creation or deletion of vertices, edges and triangles (and so by the flips). */
+    unsigned long geometryVersion; /**<  Incremented by every movement of vertices (updateMovedTriangles()). */
+    vector<Vertex *> movedVertices; /**<  Vertices displaced by the last movement (filled by the monitor functions), whose incident triangles are updated by updateMovedTriangles() and checked by checkMovedTriangles(). */
+    vector<realNumber> previousCoordinates; /**<  previousCoordinates[2*i + COORDINATE_X] and [2*i + COORDINATE_Y]: position of movedVertices[i] before its displacement (a vertex displaced twice appears twice). */
         ////////////////////////////////////////////////////////////////////////////
     // Methods    
     ////////////////////////////////////////////////////////////////////////////
@@ -56,7 +63,7 @@ public:
      * @param angle is the minimum angle desired.
      * @param refinementType 0 = Ruppert Refinement, otherwise = Off-center (Ungor).    
      */    
-    int refine(mpfr::real<MPFR_BITS_PRECISION> &angle, int refinementType);
+    int refine(realNumber &angle, int refinementType);
     /**
      * Refines the triangle by Ruppert's method.
      * @param t triangle to refine.
@@ -81,6 +88,12 @@ public:
      * Move de vertices of mesh by a monitor function    
      */
     bool movingMesh( monitorFunction monitorFunction);
+    /**
+     * Updates the triangles incident to the vertices of movedVertices, each once. The other triangles did not change.
+     * @param fullUpdate true to update all the geometry of the triangles (Triangle::update()), false to update only the
+                         shape regularity quality (Triangle::updateSRQ()).
+     */
+    void updateMovedTriangles(bool fullUpdate);
     /**
      * Clone the mesh returning pointer to the new mesh
      *
@@ -114,13 +127,75 @@ public:
      */     
     bool smartCheckMesh();
     /**
-     * Reorders the list of vertices according to the in-depth search
+     * Checks the orientation (signed area) of the triangles incident to the vertices of movedVertices. The movement kept
+       the triangulation valid if all of them are still counterclockwise, the orientation given by Triangle::setVertices()
+       (the vertices of the border do not move). The sign is decided in double when it exceeds the error bound
+       MESH_ORIENTATION_FILTER_ERROR, and by Utils::orientation() in realNumber otherwise.
+     * @param invertedTriangles triangles inverted or degenerated (zero area) by the movement.
+     * @return true if no triangle is inverted or degenerated.
+     */
+    bool checkMovedTriangles(vector<Triangle *> &invertedTriangles);
+    /**
+     * Makes the last movement valid: while checkMovedTriangles() finds inverted triangles, the displacements of their
+       displaced vertices are halved, MESH_ROLLBACK_DAMPING_STEPS times, and then reverted to the position before the
+       movement. Reverting all the displaced vertices restores the mesh before the movement, so the loop ends with a valid
+       mesh if the mesh was valid. The triangles of the vertices changed are updated (Triangle::updateSRQ()).
+     * @param displaced set to true if some vertex of movedVertices is still displaced from its position before the movement
+                       (false if the repair reverted the whole movement, or nothing moved).
+     * @return number of vertices whose displacement was damped or reverted.
+     */
+    int repairMovedTriangles(bool &displaced);
+    /**
+     * Interpolates the solution Vertex::u to the positions of the vertices of movedVertices, so that a movement can reuse the
+       last solution instead of solving the system again. The value at the new position is the linear interpolation in the
+       incident triangle that contains it, with the vertices of the triangle at their positions before the movement (the
+       mesh on which the solution was computed). A vertex displaced out of its incident triangles keeps its value.
+       Vertex::previews_u, the value of the previous time step in the right-hand side, is not remapped, as after a movement
+       followed by a solve: a lagged run differs from a run without lag only by the lag.
+     * @return number of vertices interpolated.
+     */
+    int interpolateMovedVertices();
+    /**
+     * Reorders the list of vertices according to the in-depth search. The ordering is kept while topologyVersion is unchanged:
+       a call with the same parameters on the same topology returns without reordering.
      * @param reverse reverse order
      * @param startingVertex use constant UTILS_CM_RANDOM to use random initial vertex; UTILS_CM_PSEUDOPERIPHERAL to use pseudoperipheral vertex (George and Liu algorithm); UTILS_CM_SMALLER_DEGREE to use vertex with smaller degree
      */     
     void cuthillMcKee(bool reverse, int startingVertex);
+    /**
+     * Orders the list of vertices along a space-filling curve of the coordinates. The ordering depends on the coordinates: it is
+       kept while topologyVersion and geometryVersion are unchanged (the movements of the vertices reorder).
+     * @param curve MESH_ORDERING_HILBERT or MESH_ORDERING_MORTON.
+     */
+    void spaceFillingCurve(int curve);
+    /**
+     * Orders the list of vertices by geometric nested dissection: the internal vertices are split at the median of the longest
+       side of their bounding box, the vertices of the first half adjacent to the second half form the separator, and the
+       halves are ordered recursively before the separator. The border vertices are placed at the end. Kept while
+       topologyVersion and geometryVersion are unchanged.
+     */
+    void nestedDissection();
+    /**
+     * Orders the list of vertices by one of the orderings.
+     * @param ordering MESH_ORDERING_CUTHILL_MCKEE, MESH_ORDERING_HILBERT, MESH_ORDERING_MORTON or MESH_ORDERING_NESTED_DISSECTION.
+     * @param reverse reverse order of Cuthill-McKee.
+     * @param startingVertex starting vertex of Cuthill-McKee.
+     * @return false if the list was already in this ordering (same topology, geometry for the orderings by the coordinates, and parameters).
+     */
+    bool reorder(int ordering, bool reverse, int startingVertex);
+    /**
+     * Moves the vertices to a contiguous block of memory in the order of the list of vertices (the ordering of cuthillMcKee()),
+       so that the sweeps of the list by the Finite Volume Method and the Conjugate Gradient Method read consecutive
+       addresses. The triangles and adjacencies are updated to the new addresses; pointers to vertices kept out of the mesh
+       are invalidated. Does nothing if the vertices are already in the block in the order of the list.
+     */
+    void renumberVertices();
 
 private:
+    /**
+     * Triangles incident to the vertices of movedVertices, each once.
+     */
+    void getMovedTriangles(vector<Triangle *> &triangles);
     ////////////////////////////////////////////////////////////////////////////    
     // Attributes    
     ////////////////////////////////////////////////////////////////////////////    
@@ -131,6 +206,16 @@ private:
     list<Adjacency *> toFlip;   
     /* List of triangles candidates to be removed (Auxiliary list). */
     list<Triangle *> toRemove;    
+    /* Ordering of the list of vertices by cuthillMcKee() */
+    bool hasOrdering;              /**<  An ordering was executed. */
+    unsigned long orderingVersion; /**<  topologyVersion of the last ordering. */
+    unsigned long orderingGeometryVersion; /**<  geometryVersion of the last ordering. */
+    int orderingMethod;            /**<  MESH_ORDERING_* of the last ordering. */
+    bool orderingReverse;          /**<  Parameter reverse of the last cuthillMcKee(). */
+    int orderingStartingVertex;    /**<  Parameter startingVertex of the last cuthillMcKee(). */
+    /* Contiguous storage of the vertices created by renumberVertices(). The vertices created later are allocated with new. */
+    Vertex *vertexBlock;           /**<  Vertices in the order of the list at the last renumberVertices(). */
+    int vertexBlockSize;           /**<  Number of vertices of vertexBlock. */
     ////////////////////////////////////////////////////////////////////////////    
     // Methods    
     ////////////////////////////////////////////////////////////////////////////
@@ -163,7 +248,7 @@ private:
      * @param py y coordinate.
      * @return bool indicates fi the segment is encroached.
      */
-    bool splitEncroachedSegments(mpfr::real<MPFR_BITS_PRECISION> px, mpfr::real<MPFR_BITS_PRECISION> py);
+    bool splitEncroachedSegments(realNumber px, realNumber py);
     /**
      * Verify if the segment 'seg is encroached. Verify segments opposite to the obtuse angles. 
      * @param seg segment to verify.
@@ -177,7 +262,7 @@ private:
      * @param seg segment to verify if is encroached.
      * @return true if the segment is encroached.
      */
-    bool isEncroached(mpfr::real<MPFR_BITS_PRECISION> &px, mpfr::real<MPFR_BITS_PRECISION> &py, Adjacency *seg);
+    bool isEncroached(realNumber &px, realNumber &py, Adjacency *seg);
     /**
      * Gives a triangle t and an edge of t, this method verify if the edge is a Delaunay edge. 
      * If is not a Delaunay edge, then the edge is fliped. 
@@ -192,7 +277,7 @@ private:
      * @param t tirnaglo to insert a vertex.
      * @param offcenter if offCenter == 0 -> circuncenter; otherwise create vertex with points (offCenter[0], offCenter[1]), int he off-center. 
      */        
-    void insertCircuncenterOff(Triangle *t, mpfr::real<MPFR_BITS_PRECISION> *offCenter);
+    void insertCircuncenterOff(Triangle *t, realNumber *offCenter);
     /**
      * Find the triangle tha contains the point (px, py), starting the search from the triangle 't'. 
      * @param t triangle to starting the search.
@@ -200,20 +285,20 @@ private:
      * @param py coordinate y of the point.
      * \see calculateOffCenter().
      */
-    Triangle *findTriangle(Triangle *t, mpfr::real<MPFR_BITS_PRECISION> &px, mpfr::real<MPFR_BITS_PRECISION> &py);
+    Triangle *findTriangle(Triangle *t, realNumber &px, realNumber &py);
     /**
      * Calculates the off-center of 't' and stores in the array 'offCenter'. b is the bound radius-edge ratio.
      * @param t triangle to calculate.
      * @param b bound radius-edge ratio.
      * @param offCenter array which stores the offCenter.
      */
-    void calculateOffCenter(Triangle *t, mpfr::real<MPFR_BITS_PRECISION> &b, mpfr::real<MPFR_BITS_PRECISION> *offCenter);
+    void calculateOffCenter(Triangle *t, realNumber &b, realNumber *offCenter);
     /** 
      * Returns a vertex object with coordinates (x,y). Updates the number of vertices, and the linked list. 
      * @param x x coordenate of vertex to create.
      * @param y y coordenate of vertex to create.
      */
-    Vertex *createVertex(mpfr::real<MPFR_BITS_PRECISION> &x, mpfr::real<MPFR_BITS_PRECISION> &y);
+    Vertex *createVertex(realNumber &x, realNumber &y);
     /**
      * Creates the triangulation of the bounding box, with two triangles. 
      */
@@ -262,6 +347,42 @@ private:
      * @param v vertex to delete.
      */
     void deleteVertex(Vertex *v);
+    /**
+     * Destroys the vertex v, allocated with new or in vertexBlock.
+     * @param v vertex to destroy.
+     */
+    void destroyVertex(Vertex *v);
+    /**
+     * The list of vertices is in the ordering, computed on the current topology (and on the current geometry for the orderings
+       by the coordinates: MESH_ORDERING_HILBERT, MESH_ORDERING_MORTON and MESH_ORDERING_NESTED_DISSECTION).
+     */
+    bool isOrderingCurrent(int ordering, bool reverse, int startingVertex);
+    /**
+     * Records the ordering of the list of vertices on the current topology.
+     */
+    void recordOrdering(int ordering, bool reverse, int startingVertex);
+    /**
+     * Relinks the list of vertices in the order of 'order' and labels the internal vertices 0, 1, ... in this order.
+     * @param order all the vertices of the mesh.
+     */
+    void relinkVertices(const vector<Vertex *> &order);
+    /**
+     * Key of the point (x, y), with coordinates of MESH_SPACE_FILLING_CURVE_BITS bits, along the curve.
+     * @param curve MESH_ORDERING_HILBERT or MESH_ORDERING_MORTON.
+     */
+    static unsigned long long curveKey(int curve, unsigned int x, unsigned int y);
+    /**
+     * Appends to order the vertices of part in nested dissection order (recursive step of nestedDissection()).
+     * @param part indices of the internal vertices to order.
+     * @param x coordinates x of the internal vertices.
+     * @param y coordinates y of the internal vertices.
+     * @param rowStart graph of the internal vertices (Utils::getInternalGraph()).
+     * @param neighbor graph of the internal vertices.
+     * @param side auxiliary array of the internal vertices, zero out of the calls.
+     * @param order indices of the internal vertices in nested dissection order.
+     */
+    static void dissect(vector<int> &part, const vector<double> &x, const vector<double> &y, const vector<int> &rowStart,
+                        const vector<int> &neighbor, vector<int> &side, vector<int> &order);
     /** 
      * Replaces the triangle 'oldT' that share de edge 'v0v1' (or 'edge') by the triangle 'newT' in the pointes of the adjacency object. 
      * @param v0 vertex 0 of edge shared.
@@ -5,7 +5,7 @@ CONFIG_LOCAL_SHOW_CIRCLE            = true,
 CONFIG_LOCAL_SHOW_VORONOI_DIAGRAM   = true,
 CONFIG_LOCAL_SHOW_VERTEX_LABEL      = true;
 
-void openGL::drawLine( mpfr::real<MPFR_BITS_PRECISION> x1, mpfr::real<MPFR_BITS_PRECISION> y1, mpfr::real<MPFR_BITS_PRECISION> x2, mpfr::real<MPFR_BITS_PRECISION> y2, double r, double g, double b )
+void openGL::drawLine( realNumber x1, realNumber y1, realNumber x2, realNumber y2, double r, double g, double b )
 {
     double x1_double = 0, y1_double = 0, x2_double = 0, y2_double = 0;    
     x1.conv(x1_double);
@@ -22,8 +22,8 @@ void openGL::drawLine( mpfr::real<MPFR_BITS_PRECISION> x1, mpfr::real<MPFR_BITS_
 void openGL::drawVertex( Vertex *v )
 {
     double x_double = 0, y_double = 0;    
-    mpfr::real<MPFR_BITS_PRECISION> x = v->x;
-    mpfr::real<MPFR_BITS_PRECISION> y = v->y;
+    realNumber x = v->x;
+    realNumber y = v->y;
     x.conv(x_double);   
     y.conv(y_double);      
     glPointSize(5.5);
@@ -43,7 +43,7 @@ void openGL::drawVertex( Vertex *v )
     RenderBitmap(x_double, y_double, str);        
 }
 
-void openGL::drawVertex( mpfr::real<MPFR_BITS_PRECISION> x, mpfr::real<MPFR_BITS_PRECISION> y  )
+void openGL::drawVertex( realNumber x, realNumber y  )
 {
     double x_double = 0, y_double = 0;    
     x.conv(x_double);
@@ -63,7 +63,7 @@ void openGL::drawVertex( mpfr::real<MPFR_BITS_PRECISION> x, mpfr::real<MPFR_BITS
     RenderBitmap(x_double, y_double, str);        
 }
 
-void openGL::RenderBitmap(mpfr::real<MPFR_BITS_PRECISION> x, mpfr::real<MPFR_BITS_PRECISION> y, string str)
+void openGL::RenderBitmap(realNumber x, realNumber y, string str)
 {
     double x_double = 0, y_double = 0;    
     x.conv(x_double);
@@ -100,13 +100,13 @@ void openGL::drawTriangle( Vertex *v1, Vertex *v2, Vertex *v3 )
     }
 }
 
-void openGL::drawCcircle( Vertex *v, mpfr::real<MPFR_BITS_PRECISION> ccenterX, mpfr::real<MPFR_BITS_PRECISION> ccenterY )
+void openGL::drawCcircle( Vertex *v, realNumber ccenterX, realNumber ccenterY )
 {
     double ccenterX_double = 0, ccenterY_double = 0, angle_double = 0, raio_double = 0;      
-    mpfr::real<MPFR_BITS_PRECISION> raio = sqrt( ( v->x - ccenterX )*( v->x - ccenterX ) +
+    realNumber raio = sqrt( ( v->x - ccenterX )*( v->x - ccenterX ) +
                                                  ( v->y - ccenterY )*( v->y - ccenterY ) ); 
     raio.conv(raio_double);
-    mpfr::real<MPFR_BITS_PRECISION> angle;
+    realNumber angle;
     glColor3f(0, 255, 0);
     glBegin(GL_LINE_LOOP);
     if (CONFIG_LOCAL_SHOW_CIRCLE) {
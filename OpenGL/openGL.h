@@ -23,14 +23,14 @@ public:
      * @param g g value of rgb
      * @param b b value of rgb
      */  
-    static void drawLine( mpfr::real<MPFR_BITS_PRECISION> x1, mpfr::real<MPFR_BITS_PRECISION> y1, mpfr::real<MPFR_BITS_PRECISION> x2, mpfr::real<MPFR_BITS_PRECISION> y2, double r, double g, double b );
+    static void drawLine( realNumber x1, realNumber y1, realNumber x2, realNumber y2, double r, double g, double b );
     /**
      *  Print the string in the position (x,y)
      * @param x x coordinate
      * @param y y coordinate
      * @param str string to print
      */      
-    static void RenderBitmap(mpfr::real<MPFR_BITS_PRECISION> x, mpfr::real<MPFR_BITS_PRECISION> y, string str);
+    static void RenderBitmap(realNumber x, realNumber y, string str);
     /**
      *  Draws the vertex v
      * @param v vertex to draw
@@ -41,7 +41,7 @@ public:
      * @param x x coordinate
      * @param y y coordinate
      */           
-    static void drawVertex( mpfr::real<MPFR_BITS_PRECISION> x, mpfr::real<MPFR_BITS_PRECISION> y );    
+    static void drawVertex( realNumber x, realNumber y );    
     /**
      *  Draws a triangle
      * @param v1 vertex v1 of triangle
@@ -55,7 +55,7 @@ public:
      * @param x x coordinate of circuncircle
      * @param y y coordinate of circuncircle
      */     
-    static void drawCcircle( Vertex *v, mpfr::real<MPFR_BITS_PRECISION> ccenterX, mpfr::real<MPFR_BITS_PRECISION> ccenterY );
+    static void drawCcircle( Vertex *v, realNumber ccenterX, realNumber ccenterY );
     /**
      *  Draws the Grid
      * @param tlist triangles list
@@ -0,0 +1,205 @@
+/****** Declaration and implementation of the class DoubleDouble ******/
+/* Double-double real number: unevaluated sum hi + lo of two doubles with |lo| <= ulp(hi)/2,
+   about 106 bits (32 decimal digits) of precision. The algorithms follow the QD library of
+   Hida, Li and Bailey. Header only. */
+
+#ifndef DOUBLEDOUBLE_H_INCLUDED
+#define DOUBLEDOUBLE_H_INCLUDED
+
+#include "multipleDouble.h"
+
+class DoubleDouble
+{
+public:
+    //
+    // Attributes
+    //
+    double hi; /**< Leading term */
+    double lo; /**< Trailing term */
+    //
+    // Methods
+    //
+    DoubleDouble() : hi(0.0), lo(0.0) {}
+    DoubleDouble(double h) : hi(h), lo(0.0) {}
+    DoubleDouble(double h, double l) : hi(h), lo(l) {}
+    DoubleDouble(int h) : hi((double) h), lo(0.0) {}
+    DoubleDouble(unsigned int h) : hi((double) h), lo(0.0) {}
+    DoubleDouble(long h) : hi((double) h), lo((double) (h - (long) ((double) h))) {}
+    DoubleDouble(unsigned long h) : hi((double) h), lo((double) ((long double) h - (long double) ((double) h))) {}
+    DoubleDouble(long double h) : hi((double) h), lo((double) (h - (long double) ((double) h))) {}
+    /**
+     * Converts to a native type (same interface of mpfr::real).
+     * @param t output value.
+     */
+    template <typename T> void conv(T &t) const { t = (T) ((long double) hi + (long double) lo); }
+    /**
+     * Leading double of the number.
+     */
+    double toDouble() const { return hi; }
+    bool isZero() const { return hi == 0.0; }
+    /**
+     * Pi with double-double precision.
+     */
+    static DoubleDouble pi() { return DoubleDouble(3.141592653589793116e+00, 1.224646799147353207e-16); }
+    /**
+     * Relative precision of the type, 2^-104.
+     */
+    static double epsilon() { return 4.93038065763132e-32; }
+
+    inline DoubleDouble &operator+=(const DoubleDouble &b);
+    inline DoubleDouble &operator+=(double b);
+    inline DoubleDouble &operator-=(const DoubleDouble &b);
+    inline DoubleDouble &operator-=(double b);
+    inline DoubleDouble &operator*=(const DoubleDouble &b);
+    inline DoubleDouble &operator*=(double b);
+    inline DoubleDouble &operator/=(const DoubleDouble &b);
+    inline DoubleDouble &operator/=(double b);
+};
+
+//
+// Arithmetic
+//
+inline DoubleDouble operator-(const DoubleDouble &a)
+{
+    return DoubleDouble(-a.hi, -a.lo);
+}
+
+inline DoubleDouble operator+(const DoubleDouble &a, const DoubleDouble &b)
+{
+    double s1, s2, t1, t2;
+    s1 = MultipleDouble::twoSum(a.hi, b.hi, s2);
+    t1 = MultipleDouble::twoSum(a.lo, b.lo, t2);
+    s2 += t1;
+    s1 = MultipleDouble::quickTwoSum(s1, s2, s2);
+    s2 += t2;
+    s1 = MultipleDouble::quickTwoSum(s1, s2, s2);
+    return DoubleDouble(s1, s2);
+}
+
+inline DoubleDouble operator+(const DoubleDouble &a, double b)
+{
+    double s1, s2;
+    s1 = MultipleDouble::twoSum(a.hi, b, s2);
+    s2 += a.lo;
+    s1 = MultipleDouble::quickTwoSum(s1, s2, s2);
+    return DoubleDouble(s1, s2);
+}
+
+inline DoubleDouble operator+(double a, const DoubleDouble &b) { return b + a; }
+inline DoubleDouble operator-(const DoubleDouble &a, const DoubleDouble &b) { return a + (-b); }
+inline DoubleDouble operator-(const DoubleDouble &a, double b) { return a + (-b); }
+inline DoubleDouble operator-(double a, const DoubleDouble &b) { return (-b) + a; }
+
+inline DoubleDouble operator*(const DoubleDouble &a, const DoubleDouble &b)
+{
+    double p1, p2;
+    p1 = MultipleDouble::twoProd(a.hi, b.hi, p2);
+    p2 += (a.hi * b.lo + a.lo * b.hi);
+    p1 = MultipleDouble::quickTwoSum(p1, p2, p2);
+    return DoubleDouble(p1, p2);
+}
+
+inline DoubleDouble operator*(const DoubleDouble &a, double b)
+{
+    double p1, p2;
+    p1 = MultipleDouble::twoProd(a.hi, b, p2);
+    p2 += (a.lo * b);
+    p1 = MultipleDouble::quickTwoSum(p1, p2, p2);
+    return DoubleDouble(p1, p2);
+}
+
+inline DoubleDouble operator*(double a, const DoubleDouble &b) { return b * a; }
+
+inline DoubleDouble operator/(const DoubleDouble &a, const DoubleDouble &b)
+{
+    double q1, q2, q3;
+    DoubleDouble r;
+    q1 = a.hi / b.hi; // Approximate quotient
+    r  = a - (b * q1);
+    q2 = r.hi / b.hi;
+    r  = r - (b * q2);
+    q3 = r.hi / b.hi;
+    q1 = MultipleDouble::quickTwoSum(q1, q2, q2);
+    return DoubleDouble(q1, q2) + q3;
+}
+
+inline DoubleDouble operator/(const DoubleDouble &a, double b)
+{
+    double q1, q2, p1, p2, s, e;
+    q1 = a.hi / b; // Approximate quotient
+    // Computes a - q1 * b
+    p1 = MultipleDouble::twoProd(q1, b, p2);
+    s  = MultipleDouble::twoSum(a.hi, -p1, e);
+    e += a.lo;
+    e -= p2;
+    q2 = (s + e) / b;
+    q1 = MultipleDouble::quickTwoSum(q1, q2, q2);
+    return DoubleDouble(q1, q2);
+}
+
+inline DoubleDouble operator/(double a, const DoubleDouble &b) { return DoubleDouble(a) / b; }
+
+inline DoubleDouble &DoubleDouble::operator+=(const DoubleDouble &b) { return *this = *this + b; }
+inline DoubleDouble &DoubleDouble::operator+=(double b)              { return *this = *this + b; }
+inline DoubleDouble &DoubleDouble::operator-=(const DoubleDouble &b) { return *this = *this - b; }
+inline DoubleDouble &DoubleDouble::operator-=(double b)              { return *this = *this - b; }
+inline DoubleDouble &DoubleDouble::operator*=(const DoubleDouble &b) { return *this = *this * b; }
+inline DoubleDouble &DoubleDouble::operator*=(double b)              { return *this = *this * b; }
+inline DoubleDouble &DoubleDouble::operator/=(const DoubleDouble &b) { return *this = *this / b; }
+inline DoubleDouble &DoubleDouble::operator/=(double b)              { return *this = *this / b; }
+
+//
+// Comparisons
+//
+inline bool operator==(const DoubleDouble &a, const DoubleDouble &b) { return (a.hi == b.hi) && (a.lo == b.lo); }
+inline bool operator<(const DoubleDouble &a, const DoubleDouble &b)  { return (a.hi < b.hi) || ( (a.hi == b.hi) && (a.lo < b.lo) ); }
+inline bool operator!=(const DoubleDouble &a, const DoubleDouble &b) { return !(a == b); }
+inline bool operator>(const DoubleDouble &a, const DoubleDouble &b)  { return b < a; }
+inline bool operator<=(const DoubleDouble &a, const DoubleDouble &b) { return !(b < a); }
+inline bool operator>=(const DoubleDouble &a, const DoubleDouble &b) { return !(a < b); }
+inline bool operator==(const DoubleDouble &a, double b) { return (a.hi == b) && (a.lo == 0.0); }
+inline bool operator<(const DoubleDouble &a, double b)  { return (a.hi < b) || ( (a.hi == b) && (a.lo < 0.0) ); }
+inline bool operator>(const DoubleDouble &a, double b)  { return (a.hi > b) || ( (a.hi == b) && (a.lo > 0.0) ); }
+inline bool operator!=(const DoubleDouble &a, double b) { return !(a == b); }
+inline bool operator<=(const DoubleDouble &a, double b) { return !(a > b); }
+inline bool operator>=(const DoubleDouble &a, double b) { return !(a < b); }
+inline bool operator==(double a, const DoubleDouble &b) { return b == a; }
+inline bool operator!=(double a, const DoubleDouble &b) { return b != a; }
+inline bool operator<(double a, const DoubleDouble &b)  { return b > a; }
+inline bool operator>(double a, const DoubleDouble &b)  { return b < a; }
+inline bool operator<=(double a, const DoubleDouble &b) { return b >= a; }
+inline bool operator>=(double a, const DoubleDouble &b) { return b <= a; }
+
+//
+// Functions
+//
+inline DoubleDouble abs(const DoubleDouble &a)  { return (a.hi < 0.0) ? -a : a; }
+inline DoubleDouble fabs(const DoubleDouble &a) { return abs(a); }
+
+inline DoubleDouble sqrt(const DoubleDouble &a)
+{
+    if (a.hi == 0.0)
+        return DoubleDouble(0.0);
+    if (a.hi < 0.0)
+        return DoubleDouble(NAN);
+    // Karp's trick: sqrt(a) = a*x + [a - (a*x)^2] * x / 2, with x = 1/sqrt(a)
+    double x = 1.0 / std::sqrt(a.hi);
+    double ax = a.hi * x, e = 0.0;
+    double ax2 = MultipleDouble::twoProd(ax, ax, e);
+    DoubleDouble diff = a - DoubleDouble(ax2, e);
+    double s1, s2;
+    s1 = MultipleDouble::twoSum(ax, diff.hi * (x * 0.5), s2);
+    return DoubleDouble(s1, s2);
+}
+
+inline DoubleDouble sin(const DoubleDouble &a)  { return MultipleDouble::sin(a); }
+inline DoubleDouble cos(const DoubleDouble &a)  { return MultipleDouble::cos(a); }
+inline DoubleDouble acos(const DoubleDouble &a) { return MultipleDouble::acos(a); }
+
+//
+// Streams
+//
+inline ostream &operator<<(ostream &os, const DoubleDouble &a) { return MultipleDouble::write(os, a); }
+inline istream &operator>>(istream &is, DoubleDouble &a)       { return MultipleDouble::read(is, a); }
+
+#endif // DOUBLEDOUBLE_H_INCLUDED
@@ -0,0 +1,322 @@
+/****** Common algorithms of the multiple-double real numbers (DoubleDouble and QuadDouble) ******/
+/* A multiple-double number is an unevaluated sum of doubles ordered by decreasing magnitude.
+   The arithmetic is built on the error-free transformations of Dekker, Knuth and Shewchuk;
+   the functions below are shared by the double-double (about 106 bits) and the quad-double
+   (about 212 bits) types. Header only. */
+
+#ifndef MULTIPLEDOUBLE_H_INCLUDED
+#define MULTIPLEDOUBLE_H_INCLUDED
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+using namespace std;
+
+class MultipleDouble
+{
+public:
+    /**
+     * Error-free sum: s + e = a + b exactly, s = fl(a + b).
+     */
+    static inline double twoSum(double a, double b, double &e)
+    {
+        double s  = a + b;
+        double bb = s - a;
+        e = (a - (s - bb)) + (b - bb);
+        return s;
+    }
+    /**
+     * Error-free sum when |a| >= |b|: s + e = a + b exactly, s = fl(a + b).
+     */
+    static inline double quickTwoSum(double a, double b, double &e)
+    {
+        double s = a + b;
+        e = b - (s - a);
+        return s;
+    }
+    /**
+     * Error-free product: p + e = a * b exactly, p = fl(a * b).
+     */
+    static inline double twoProd(double a, double b, double &e)
+    {
+        double p = a * b;
+        e = fma(a, b, -p);
+        return p;
+    }
+    /**
+     * Renormalizes the n terms of x (roughly ordered by decreasing magnitude) into the k leading
+       non-overlapping terms of r (Joldes, Muller and Popescu). The first pass is error-free.
+     * @param x terms to renormalize, overwritten.
+     * @param n number of terms of x.
+     * @param r output with k terms.
+     * @param k number of terms of output.
+     */
+    static inline void renormalize(double *x, int n, double *r, int k)
+    {
+        // VecSum: from the smallest to the biggest term
+        double s = x[n - 1];
+        for (int i = n - 2; i >= 0; i--)
+            s = twoSum(x[i], s, x[i + 1]);
+        x[0] = s;
+        // VecSumErrBranch: from the biggest to the smallest term
+        for (int i = 0; i < k; i++)
+            r[i] = 0.0;
+        int j = 0;
+        double epsilon = x[0];
+        for (int i = 1; i < n; i++)
+        {
+            double error = 0.0;
+            r[j] = quickTwoSum(epsilon, x[i], error);
+            if (error != 0.0)
+            {
+                if (j >= k - 1)
+                    return;
+                j++;
+                epsilon = error;
+            }
+            else
+                epsilon = r[j];
+        }
+        if (j < k)
+            r[j] = epsilon;
+    }
+    /**
+     * Sine of x by argument reduction modulo pi/2 and Taylor series.
+     */
+    template <class T> static T sin(const T &x)
+    {
+        int quadrant = 0;
+        T t = reduceHalfPi(x, quadrant), s = 0, c = 0;
+        sinCosTaylor(t, s, c);
+        switch (quadrant)
+        {
+            case 0:  return s;
+            case 1:  return c;
+            case 2:  return -s;
+            default: return -c;
+        }
+    }
+    /**
+     * Cosine of x by argument reduction modulo pi/2 and Taylor series.
+     */
+    template <class T> static T cos(const T &x)
+    {
+        int quadrant = 0;
+        T t = reduceHalfPi(x, quadrant), s = 0, c = 0;
+        sinCosTaylor(t, s, c);
+        switch (quadrant)
+        {
+            case 0:  return c;
+            case 1:  return -s;
+            case 2:  return -c;
+            default: return s;
+        }
+    }
+    /**
+     * Arc tangent of y/x in (-pi, pi], Newton iterations on sin/cos from the double approximation.
+     */
+    template <class T> static T atan2(const T &y, const T &x)
+    {
+        if (x.isZero() && y.isZero())
+            return T(0);
+        T r = sqrt(x * x + y * y), xx = x / r, yy = y / r;
+        T z = std::atan2(y.toDouble(), x.toDouble());
+        // Each iteration doubles the number of correct digits: 53 -> 106 -> 212
+        for (int i = 0; i < 3; i++)
+        {
+            if (fabs(xx.toDouble()) > fabs(yy.toDouble()))
+                z = z + (yy - sin(z)) / cos(z);
+            else
+                z = z - (xx - cos(z)) / sin(z);
+        }
+        return z;
+    }
+    /**
+     * Arc cosine of x in [0, pi].
+     */
+    template <class T> static T acos(const T &x)
+    {
+        if ( (x > 1) || (x < -1) )
+            return T(NAN);
+        return atan2(sqrt(1 - x * x), x);
+    }
+    /**
+     * Writes x to the stream in scientific notation with precision digits after the point,
+       in the same format of mpfr::real (the fixed/scientific flags are ignored).
+     */
+    template <class T> static ostream &write(ostream &os, const T &x)
+    {
+        double leading = x.toDouble();
+        if (leading != leading)
+            return os << "nan";
+        if (leading == HUGE_VAL || leading == -HUGE_VAL)
+            return os << ( (leading < 0) ? "-inf" : "inf" );
+        ostringstream s;
+        int exponent = 0;
+        string d = digits(x, (int) os.precision() + 1, exponent);
+        if (leading < 0)
+            s << "-";
+        else if (os.flags() & ios_base::showpos)
+            s << "+";
+        s << d[0] << "." << d.substr(1) << ( (os.flags() & ios_base::uppercase) ? "E" : "e" )
+          << ( (exponent < 0) ? "-" : "+" ) << ( (abs(exponent) < 10) ? "0" : "" ) << abs(exponent);
+        return os << s.str();
+    }
+    /**
+     * Reads x from the stream (decimal notation, optionally with exponent).
+     */
+    template <class T> static istream &read(istream &is, T &x)
+    {
+        string s;
+        if (!(is >> s))
+            return is;
+        size_t i = 0;
+        bool negative = false;
+        if ( (i < s.size()) && ( (s[i] == '-') || (s[i] == '+') ) )
+            negative = (s[i++] == '-');
+        T mantissa = 0;
+        int exponent = 0, nDigits = 0;
+        bool point = false;
+        for (; i < s.size(); i++)
+        {
+            if ( (s[i] >= '0') && (s[i] <= '9') )
+            {
+                mantissa = mantissa * 10 + (s[i] - '0');
+                nDigits++;
+                if (point)
+                    exponent--;
+            }
+            else if ( (s[i] == '.') && !point )
+                point = true;
+            else
+                break;
+        }
+        if ( (i < s.size()) && ( (s[i] == 'e') || (s[i] == 'E') ) )
+            exponent += atoi(s.c_str() + i + 1);
+        else if (i < s.size())
+            nDigits = 0;
+        if (nDigits == 0)
+        {
+            is.setstate(ios_base::failbit);
+            return is;
+        }
+        x = (exponent >= 0) ? mantissa * powerOfTen<T>(exponent) : mantissa / powerOfTen<T>(-exponent);
+        if (negative)
+            x = -x;
+        return is;
+    }
+
+private:
+    /**
+     * Computes 10^n (n >= 0) by binary powering.
+     */
+    template <class T> static T powerOfTen(int n)
+    {
+        T result = 1, base = 10;
+        while (n > 0)
+        {
+            if (n & 1)
+                result = result * base;
+            base = base * base;
+            n >>= 1;
+        }
+        return result;
+    }
+    /**
+     * Reduces x to t in [-pi/4, pi/4] with x = t + quadrant * pi/2 (mod 2 pi).
+     */
+    template <class T> static T reduceHalfPi(const T &x, int &quadrant)
+    {
+        T halfPi = T::pi() * 0.5;
+        double k = floor( (x / halfPi).toDouble() + 0.5 );
+        quadrant = ( ( (int) fmod(k, 4.0) ) + 4 ) % 4;
+        return x - halfPi * k;
+    }
+    /**
+     * Taylor series of sin and cos for |t| <= pi/4.
+     */
+    template <class T> static void sinCosTaylor(const T &t, T &s, T &c)
+    {
+        T t2 = t * t, term = t;
+        s = t;
+        for (int n = 3; !term.isZero() && fabs(term.toDouble()) > T::epsilon() * 1e-2; n += 2)
+        {
+            term = -term * t2 / (double) ( (n - 1) * n );
+            s += term;
+        }
+        term = 1;
+        c = 1;
+        for (int n = 2; !term.isZero() && fabs(term.toDouble()) > T::epsilon() * 1e-2; n += 2)
+        {
+            term = -term * t2 / (double) ( (n - 1) * n );
+            c += term;
+        }
+    }
+    /**
+     * Decimal exponent of x (|x| = r * 10^exponent, 1 <= r < 10) and the normalized r.
+     */
+    template <class T> static int decimalExponent(const T &x, T &r)
+    {
+        r = (x.toDouble() < 0) ? -x : x;
+        if (r.isZero())
+            return 0;
+        int exponent = (int) floor( log10( fabs(r.toDouble()) ) );
+        r = (exponent >= 0) ? r / powerOfTen<T>(exponent) : r * powerOfTen<T>(-exponent);
+        // Fix the exponent estimated in double
+        if (r >= 10)
+        {
+            r = r / 10;
+            exponent++;
+        }
+        else if (r < 1)
+        {
+            r = r * 10;
+            exponent--;
+        }
+        return exponent;
+    }
+    /**
+     * Generates the n leading decimal digits of |x| (n + 1 digits are generated to round the last one).
+     * @param exponent decimal exponent of the first digit.
+     */
+    template <class T> static string digits(const T &x, int n, int &exponent)
+    {
+        T r = 0;
+        exponent = decimalExponent(x, r);
+        if (r.isZero())
+            return string(n, '0');
+        string d(n + 1, '0');
+        for (int i = 0; i <= n; i++)
+        {
+            int digit = (int) floor(r.toDouble());
+            if (digit < 0) digit = 0;
+            if (digit > 9) digit = 9;
+            d[i] = (char) ('0' + digit);
+            r = (r - digit) * 10;
+        }
+        // Rounding
+        bool carry = (d[n] >= '5');
+        d.erase(n);
+        for (int i = n - 1; carry && (i >= 0); i--)
+        {
+            if (d[i] == '9')
+                d[i] = '0';
+            else
+            {
+                d[i]++;
+                carry = false;
+            }
+        }
+        if (carry)
+        {
+            d.insert(d.begin(), '1');
+            d.erase(n);
+            exponent++;
+        }
+        return d;
+    }
+};
+
+#endif // MULTIPLEDOUBLE_H_INCLUDED
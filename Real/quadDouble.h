@@ -0,0 +1,243 @@
+/****** Declaration and implementation of the class QuadDouble ******/
+/* Quad-double real number: unevaluated sum x[0] + x[1] + x[2] + x[3] of four non-overlapping doubles,
+   about 212 bits (64 decimal digits) of precision. The partial sums and products are accumulated with
+   error-free transformations and renormalized to four terms. Header only. */
+
+#ifndef QUADDOUBLE_H_INCLUDED
+#define QUADDOUBLE_H_INCLUDED
+
+#include "multipleDouble.h"
+
+class QuadDouble
+{
+public:
+    //
+    // Attributes
+    //
+    double x[4]; /**< Terms ordered by decreasing magnitude */
+    //
+    // Methods
+    //
+    QuadDouble()                   { x[0] = x[1] = x[2] = x[3] = 0.0; }
+    QuadDouble(double a)           { x[0] = a; x[1] = x[2] = x[3] = 0.0; }
+    QuadDouble(int a)              { x[0] = (double) a; x[1] = x[2] = x[3] = 0.0; }
+    QuadDouble(unsigned int a)     { x[0] = (double) a; x[1] = x[2] = x[3] = 0.0; }
+    QuadDouble(long a)             { x[0] = (double) a; x[1] = (double) (a - (long) x[0]); x[2] = x[3] = 0.0; }
+    QuadDouble(unsigned long a)    { x[0] = (double) a; x[1] = (double) ((long double) a - (long double) x[0]); x[2] = x[3] = 0.0; }
+    QuadDouble(long double a)      { x[0] = (double) a; x[1] = (double) (a - (long double) x[0]); x[2] = x[3] = 0.0; }
+    QuadDouble(double a0, double a1, double a2, double a3) { x[0] = a0; x[1] = a1; x[2] = a2; x[3] = a3; }
+    /**
+     * Converts to a native type (same interface of mpfr::real).
+     * @param t output value.
+     */
+    template <typename T> void conv(T &t) const { t = (T) ( ( (long double) x[0] + (long double) x[1] ) + (long double) x[2] ); }
+    /**
+     * Leading double of the number.
+     */
+    double toDouble() const { return x[0]; }
+    bool isZero() const { return x[0] == 0.0; }
+    /**
+     * Pi with quad-double precision.
+     */
+    static QuadDouble pi() { return QuadDouble(3.141592653589793116e+00, 1.224646799147353207e-16, -2.994769809718339666e-33, 1.112454220863365282e-49); }
+    /**
+     * Relative precision of the type, 2^-209.
+     */
+    static double epsilon() { return 1.21543267145725e-63; }
+    /**
+     * Renormalizes n terms into a quad-double.
+     */
+    static QuadDouble renormalize(double *terms, int n)
+    {
+        QuadDouble r;
+        MultipleDouble::renormalize(terms, n, r.x, 4);
+        return r;
+    }
+
+    inline QuadDouble &operator+=(const QuadDouble &b);
+    inline QuadDouble &operator+=(double b);
+    inline QuadDouble &operator-=(const QuadDouble &b);
+    inline QuadDouble &operator-=(double b);
+    inline QuadDouble &operator*=(const QuadDouble &b);
+    inline QuadDouble &operator*=(double b);
+    inline QuadDouble &operator/=(const QuadDouble &b);
+    inline QuadDouble &operator/=(double b);
+};
+
+//
+// Arithmetic
+//
+inline QuadDouble operator-(const QuadDouble &a)
+{
+    return QuadDouble(-a.x[0], -a.x[1], -a.x[2], -a.x[3]);
+}
+
+inline QuadDouble operator+(const QuadDouble &a, const QuadDouble &b)
+{
+    // Merges the terms by decreasing magnitude, the renormalization is error-free before the truncation
+    double terms[8];
+    int i = 0, j = 0, k = 0;
+    while ( (i < 4) && (j < 4) )
+        terms[k++] = ( fabs(a.x[i]) >= fabs(b.x[j]) ) ? a.x[i++] : b.x[j++];
+    while (i < 4)
+        terms[k++] = a.x[i++];
+    while (j < 4)
+        terms[k++] = b.x[j++];
+    return QuadDouble::renormalize(terms, 8);
+}
+
+inline QuadDouble operator+(const QuadDouble &a, double b)
+{
+    double terms[5] = { b, a.x[0], a.x[1], a.x[2], a.x[3] };
+    int k = 0;
+    // Moves b to its position by decreasing magnitude
+    while ( (k < 4) && ( fabs(terms[k]) < fabs(terms[k + 1]) ) )
+    {
+        double tmp = terms[k];
+        terms[k] = terms[k + 1];
+        terms[k + 1] = tmp;
+        k++;
+    }
+    return QuadDouble::renormalize(terms, 5);
+}
+
+inline QuadDouble operator+(double a, const QuadDouble &b) { return b + a; }
+inline QuadDouble operator-(const QuadDouble &a, const QuadDouble &b) { return a + (-b); }
+inline QuadDouble operator-(const QuadDouble &a, double b) { return a + (-b); }
+inline QuadDouble operator-(double a, const QuadDouble &b) { return (-b) + a; }
+
+inline QuadDouble operator*(const QuadDouble &a, const QuadDouble &b)
+{
+    // Terms of order 0, 1, 2 (exact products) and 3 (rounded products) ordered by magnitude
+    double terms[16], e[6];
+    terms[0]  = MultipleDouble::twoProd(a.x[0], b.x[0], terms[3]);
+    terms[1]  = MultipleDouble::twoProd(a.x[0], b.x[1], e[0]);
+    terms[2]  = MultipleDouble::twoProd(a.x[1], b.x[0], e[1]);
+    terms[4]  = MultipleDouble::twoProd(a.x[0], b.x[2], e[2]);
+    terms[5]  = MultipleDouble::twoProd(a.x[1], b.x[1], e[3]);
+    terms[6]  = MultipleDouble::twoProd(a.x[2], b.x[0], e[4]);
+    terms[7]  = e[0];
+    terms[8]  = e[1];
+    terms[9]  = a.x[0] * b.x[3];
+    terms[10] = a.x[1] * b.x[2];
+    terms[11] = a.x[2] * b.x[1];
+    terms[12] = a.x[3] * b.x[0];
+    terms[13] = e[2];
+    terms[14] = e[3];
+    terms[15] = e[4];
+    return QuadDouble::renormalize(terms, 16);
+}
+
+inline QuadDouble operator*(const QuadDouble &a, double b)
+{
+    double terms[7];
+    terms[0] = MultipleDouble::twoProd(a.x[0], b, terms[2]);
+    terms[1] = MultipleDouble::twoProd(a.x[1], b, terms[4]);
+    terms[3] = MultipleDouble::twoProd(a.x[2], b, terms[6]);
+    terms[5] = a.x[3] * b;
+    return QuadDouble::renormalize(terms, 7);
+}
+
+inline QuadDouble operator*(double a, const QuadDouble &b) { return b * a; }
+
+inline QuadDouble operator/(const QuadDouble &a, const QuadDouble &b)
+{
+    // Long division: each quotient term is computed in double from the current remainder
+    double q[5];
+    QuadDouble r = a;
+    for (int i = 0; i < 4; i++)
+    {
+        q[i] = r.x[0] / b.x[0];
+        r = r - (b * q[i]);
+    }
+    q[4] = r.x[0] / b.x[0];
+    return QuadDouble::renormalize(q, 5);
+}
+
+inline QuadDouble operator/(const QuadDouble &a, double b)
+{
+    double q[5];
+    QuadDouble r = a;
+    for (int i = 0; i < 4; i++)
+    {
+        q[i] = r.x[0] / b;
+        r = r - QuadDouble(q[i]) * b;
+    }
+    q[4] = r.x[0] / b;
+    return QuadDouble::renormalize(q, 5);
+}
+
+inline QuadDouble operator/(double a, const QuadDouble &b) { return QuadDouble(a) / b; }
+
+inline QuadDouble &QuadDouble::operator+=(const QuadDouble &b) { return *this = *this + b; }
+inline QuadDouble &QuadDouble::operator+=(double b)            { return *this = *this + b; }
+inline QuadDouble &QuadDouble::operator-=(const QuadDouble &b) { return *this = *this - b; }
+inline QuadDouble &QuadDouble::operator-=(double b)            { return *this = *this - b; }
+inline QuadDouble &QuadDouble::operator*=(const QuadDouble &b) { return *this = *this * b; }
+inline QuadDouble &QuadDouble::operator*=(double b)            { return *this = *this * b; }
+inline QuadDouble &QuadDouble::operator/=(const QuadDouble &b) { return *this = *this / b; }
+inline QuadDouble &QuadDouble::operator/=(double b)            { return *this = *this / b; }
+
+//
+// Comparisons
+//
+inline bool operator==(const QuadDouble &a, const QuadDouble &b)
+{
+    return (a.x[0] == b.x[0]) && (a.x[1] == b.x[1]) && (a.x[2] == b.x[2]) && (a.x[3] == b.x[3]);
+}
+
+inline bool operator<(const QuadDouble &a, const QuadDouble &b)
+{
+    for (int i = 0; i < 4; i++)
+        if (a.x[i] != b.x[i])
+            return a.x[i] < b.x[i];
+    return false;
+}
+
+inline bool operator!=(const QuadDouble &a, const QuadDouble &b) { return !(a == b); }
+inline bool operator>(const QuadDouble &a, const QuadDouble &b)  { return b < a; }
+inline bool operator<=(const QuadDouble &a, const QuadDouble &b) { return !(b < a); }
+inline bool operator>=(const QuadDouble &a, const QuadDouble &b) { return !(a < b); }
+inline bool operator==(const QuadDouble &a, double b) { return (a.x[0] == b) && (a.x[1] == 0.0); }
+inline bool operator<(const QuadDouble &a, double b)  { return (a.x[0] < b) || ( (a.x[0] == b) && (a.x[1] < 0.0) ); }
+inline bool operator>(const QuadDouble &a, double b)  { return (a.x[0] > b) || ( (a.x[0] == b) && (a.x[1] > 0.0) ); }
+inline bool operator!=(const QuadDouble &a, double b) { return !(a == b); }
+inline bool operator<=(const QuadDouble &a, double b) { return !(a > b); }
+inline bool operator>=(const QuadDouble &a, double b) { return !(a < b); }
+inline bool operator==(double a, const QuadDouble &b) { return b == a; }
+inline bool operator!=(double a, const QuadDouble &b) { return b != a; }
+inline bool operator<(double a, const QuadDouble &b)  { return b > a; }
+inline bool operator>(double a, const QuadDouble &b)  { return b < a; }
+inline bool operator<=(double a, const QuadDouble &b) { return b >= a; }
+inline bool operator>=(double a, const QuadDouble &b) { return b <= a; }
+
+//
+// Functions
+//
+inline QuadDouble abs(const QuadDouble &a)  { return (a.x[0] < 0.0) ? -a : a; }
+inline QuadDouble fabs(const QuadDouble &a) { return abs(a); }
+
+inline QuadDouble sqrt(const QuadDouble &a)
+{
+    if (a.x[0] == 0.0)
+        return QuadDouble(0.0);
+    if (a.x[0] < 0.0)
+        return QuadDouble(NAN);
+    // Newton iterations for 1/sqrt(a): r = r + r * (1 - a * r^2) / 2, each one doubles the correct digits
+    QuadDouble r = 1.0 / std::sqrt(a.x[0]), h = a * 0.5;
+    for (int i = 0; i < 3; i++)
+        r += (0.5 - h * (r * r)) * r;
+    return r * a;
+}
+
+inline QuadDouble sin(const QuadDouble &a)  { return MultipleDouble::sin(a); }
+inline QuadDouble cos(const QuadDouble &a)  { return MultipleDouble::cos(a); }
+inline QuadDouble acos(const QuadDouble &a) { return MultipleDouble::acos(a); }
+
+//
+// Streams
+//
+inline ostream &operator<<(ostream &os, const QuadDouble &a) { return MultipleDouble::write(os, a); }
+inline istream &operator>>(istream &is, QuadDouble &a)       { return MultipleDouble::read(is, a); }
+
+#endif // QUADDOUBLE_H_INCLUDED
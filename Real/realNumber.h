@@ -0,0 +1,62 @@
+/****** Definition of the real number type used in the whole project ******/
+/* The type is selected at compile time by REAL_NUMBER_TYPE (see Utils/constants.h):
+   REAL_NUMBER_MPFR          => mpfr::real<MPFR_BITS_PRECISION> (default)
+   REAL_NUMBER_DOUBLE_DOUBLE => DoubleDouble, about 106 bits
+   REAL_NUMBER_QUAD_DOUBLE   => QuadDouble, about 212 bits
+   e.g. make CFLAGS="-Wall -I./External/mpfr_real_v0.0.9-alpha -DREAL_NUMBER_TYPE=REAL_NUMBER_DOUBLE_DOUBLE" */
+
+#ifndef REALNUMBER_H_INCLUDED
+#define REALNUMBER_H_INCLUDED
+
+#include "../Utils/constants.h"
+
+#if REAL_NUMBER_TYPE == REAL_NUMBER_DOUBLE_DOUBLE
+#include "doubleDouble.h"
+typedef DoubleDouble realNumber;
+#define REAL_NUMBER_BITS 106 /**< Bits of precision of realNumber */
+#elif REAL_NUMBER_TYPE == REAL_NUMBER_QUAD_DOUBLE
+#include "quadDouble.h"
+typedef QuadDouble realNumber;
+#define REAL_NUMBER_BITS 212 /**< Bits of precision of realNumber */
+#else
+#define MPFR_REAL_DATA_PUBLIC 1 // Access to the mpfr_t of mpfr::real (mpfr_sum in Real/reduction.h)
+#include "real.hpp"
+typedef mpfr::real<MPFR_BITS_PRECISION> realNumber;
+#define REAL_NUMBER_BITS MPFR_BITS_PRECISION /**< Bits of precision of realNumber */
+#endif
+
+/**
+ * Pi with the precision of realNumber.
+ */
+inline realNumber realNumberPi()
+{
+#if (REAL_NUMBER_TYPE == REAL_NUMBER_DOUBLE_DOUBLE) || (REAL_NUMBER_TYPE == REAL_NUMBER_QUAD_DOUBLE)
+    return realNumber::pi();
+#else
+    return mpfr::const_pi<MPFR_BITS_PRECISION, MPFR_RNDN>();
+#endif
+}
+
+/**
+ * Positive (sign > 0) or negative (sign < 0) infinity.
+ */
+inline realNumber realNumberInfinity(int sign)
+{
+#if (REAL_NUMBER_TYPE == REAL_NUMBER_DOUBLE_DOUBLE) || (REAL_NUMBER_TYPE == REAL_NUMBER_QUAD_DOUBLE)
+    return realNumber( (sign < 0) ? -HUGE_VAL : HUGE_VAL );
+#else
+    return mpfr::inf<MPFR_BITS_PRECISION, MPFR_RNDN>(sign);
+#endif
+}
+
+/**
+ * Frees the caches of constants (pi) and of transcendental functions. Nothing to do on the multiple-double types.
+ */
+inline void realNumberFreeCache()
+{
+#if (REAL_NUMBER_TYPE != REAL_NUMBER_DOUBLE_DOUBLE) && (REAL_NUMBER_TYPE != REAL_NUMBER_QUAD_DOUBLE)
+    mpfr_free_cache();
+#endif
+}
+
+#endif // REALNUMBER_H_INCLUDED
@@ -0,0 +1,265 @@
+/****** Declaration and implementation of the class Reduction ******/
+/* Accurate sum of a sequence of terms, used in the dot products of the conjugate gradient method.
+   The floating types (double, DoubleDouble and QuadDouble) use the compensated summation of Neumaier over
+   consecutive chunks of REDUCTION_CHUNK_SIZE terms, and the sums of the chunks are added, also compensated,
+   in the order of the chunks. The mpfr::real types keep the terms and compute the correctly rounded sum with
+   mpfr_sum, so the result does not depend on the order of the terms; reduce() replaces the terms of a block by
+   their exact sum, computed in parallel by the thread of the block. Partial sums of blocks of consecutive
+   terms can be combined with merge(), in the order of the blocks: the result is the same as the serial sum
+   if every block but the last starts and ends at a multiple of REDUCTION_CHUNK_SIZE (see
+   reductionBlockBoundary()), whatever the number of blocks. Header only. */
+
+#ifndef REDUCTION_H_INCLUDED
+#define REDUCTION_H_INCLUDED
+
+#include <cmath>
+#include <vector>
+#include "realNumber.h"
+using namespace std;
+
+/**
+ * First term of a block of consecutive terms split in numberOfBlocks blocks: a multiple of REDUCTION_CHUNK_SIZE,
+   so that the merge of the partial sums of the blocks gives the serial sum.
+ * @param n number of terms.
+ * @param block number of the block (numberOfBlocks gives the end of the last block, n).
+ * @param numberOfBlocks number of blocks.
+ */
+inline int reductionBlockBoundary(int n, int block, int numberOfBlocks)
+{
+    long chunks = ( (long) n + REDUCTION_CHUNK_SIZE - 1 ) / REDUCTION_CHUNK_SIZE,
+         boundary = ( (chunks * block) / numberOfBlocks ) * REDUCTION_CHUNK_SIZE;
+    return (int) ( (boundary < n) ? boundary : n );
+}
+
+template <class T> class Reduction
+{
+public:
+    Reduction() : sum(0.0), compensation(0.0), chunkTerms(0) {}
+    /**
+     * Restarts the sum. The memory of the sums of the chunks is kept to the next sum.
+     */
+    void clear()
+    {
+        sum = 0.0;
+        compensation = 0.0;
+        chunkTerms = 0;
+        chunks.clear();
+    }
+    /**
+     * Adds a term (Neumaier's compensated summation) to the sum of the current chunk.
+     */
+    void add(const T &term)
+    {
+        accumulate(sum, compensation, term);
+        if (++chunkTerms == REDUCTION_CHUNK_SIZE)
+        {
+            chunks.push_back(sum);
+            chunks.push_back(compensation);
+            sum = 0.0;
+            compensation = 0.0;
+            chunkTerms = 0;
+        }
+    }
+    /**
+     * Nothing to do: the sums of the chunks are already the partial sum of the block (see the MPFR specialization).
+     */
+    void reduce()
+    {
+    }
+    /**
+     * Appends the sums of the chunks of the next block of terms.
+     */
+    void merge(const Reduction &other)
+    {
+        if (chunkTerms > 0)
+        {
+            chunks.push_back(sum);
+            chunks.push_back(compensation);
+            sum = 0.0;
+            compensation = 0.0;
+            chunkTerms = 0;
+        }
+        chunks.insert(chunks.end(), other.chunks.begin(), other.chunks.end());
+        sum = other.sum;
+        compensation = other.compensation;
+        chunkTerms = other.chunkTerms;
+    }
+    /**
+     * Returns the sum of the terms: the compensated sum of the sums of the chunks, in the order of the chunks.
+     */
+    T result() const
+    {
+        T s = 0.0, c = 0.0;
+        for (size_t i = 0; i < chunks.size(); i++)
+            accumulate(s, c, chunks[i]);
+        if (chunkTerms > 0)
+        {
+            accumulate(s, c, sum);
+            accumulate(s, c, compensation);
+        }
+        return s + c;
+    }
+
+private:
+    /**
+     * Adds a term to the running sum s with the error compensation c (Neumaier).
+     */
+    static void accumulate(T &s, T &c, const T &term)
+    {
+        T t = s + term;
+        if (fabs(s) >= fabs(term))
+            c += (s - t) + term;
+        else
+            c += (term - t) + s;
+        s = t;
+    }
+    T sum;             /**< Running sum of the current chunk */
+    T compensation;    /**< Sum of the rounding errors of the running sum of the current chunk */
+    int chunkTerms;    /**< Terms of the current chunk */
+    vector<T> chunks;  /**< Sum and compensation of each complete chunk, in order */
+};
+
+#if REAL_NUMBER_TYPE == REAL_NUMBER_MPFR
+/**
+ * mpfr_t of variable precision with value semantics, the exact partial sums of Reduction< mpfr::real >.
+ */
+class ReductionPartial
+{
+public:
+    ReductionPartial()
+    {
+        mpfr_init2(value, MPFR_PREC_MIN);
+        mpfr_set_zero(value, 1);
+    }
+    ReductionPartial(const ReductionPartial &other)
+    {
+        mpfr_init2(value, mpfr_get_prec(other.value));
+        mpfr_set(value, other.value, MPFR_RNDN);
+    }
+    ReductionPartial &operator=(const ReductionPartial &other)
+    {
+        if (this != &other)
+        {
+            mpfr_set_prec(value, mpfr_get_prec(other.value));
+            mpfr_set(value, other.value, MPFR_RNDN);
+        }
+        return *this;
+    }
+    ~ReductionPartial()
+    {
+        mpfr_clear(value);
+    }
+    mpfr_t value;
+};
+
+template <mpfr::real_prec_t _prec, mpfr::real_rnd_t _rnd> class Reduction< mpfr::real<_prec, _rnd> >
+{
+public:
+    Reduction() : count(0), partialCount(0) {}
+    /**
+     * Restarts the sum. The memory of the terms is kept to the next sum.
+     */
+    void clear()
+    {
+        count = 0;
+        partialCount = 0;
+    }
+    /**
+     * Stores a term.
+     */
+    void add(const mpfr::real<_prec, _rnd> &term)
+    {
+        if (count < terms.size())
+            terms[count] = term;
+        else
+            terms.push_back(term);
+        count++;
+    }
+    /**
+     * Replaces the terms stored by their exact sum, so that merge() copies one value per block. Called by the thread
+       of each block, the sums of the blocks are computed in parallel. The precision of the exact sum goes from the
+       last bit of the smallest term to the first bit of the sum (at most log2(count) bits above the largest term).
+     */
+    void reduce()
+    {
+        if (count == 0)
+            return;
+        mpfr_exp_t emin = 0, emax = 0;
+        bool found = false, special = false;
+        for (size_t i = 0; i < count; i++)
+        {
+            if (mpfr_zero_p(terms[i]._x))
+                continue;
+            if (!mpfr_number_p(terms[i]._x))
+            {
+                special = true; // NaN or infinity: the sum is not finite
+                continue;
+            }
+            mpfr_exp_t e = mpfr_get_exp(terms[i]._x);
+            if ( (!found) || (e < emin) )
+                emin = e;
+            if ( (!found) || (e > emax) )
+                emax = e;
+            found = true;
+        }
+        mpfr_prec_t precision = _prec;
+        if ( (found) && (!special) )
+        {
+            precision = (mpfr_prec_t) (emax - emin) + _prec + 2;
+            for (size_t c = count; c > 1; c >>= 1)
+                precision++;
+            if (precision > MPFR_PREC_MAX)
+                precision = MPFR_PREC_MAX;
+        }
+        if (partialCount == partials.size())
+            partials.push_back(ReductionPartial());
+        mpfr_set_prec(partials[partialCount].value, precision);
+        vector<mpfr_ptr> pointers(count);
+        for (size_t i = 0; i < count; i++)
+            pointers[i] = terms[i]._x;
+        mpfr_sum(partials[partialCount].value, &pointers[0], count, MPFR_RNDN);
+        partialCount++;
+        count = 0;
+    }
+    /**
+     * Stores the terms and the exact partial sums of other block of terms.
+     */
+    void merge(const Reduction &other)
+    {
+        for (size_t i = 0; i < other.count; i++)
+            add(other.terms[i]);
+        for (size_t i = 0; i < other.partialCount; i++)
+        {
+            if (partialCount < partials.size())
+                partials[partialCount] = other.partials[i];
+            else
+                partials.push_back(other.partials[i]);
+            partialCount++;
+        }
+    }
+    /**
+     * Returns the correctly rounded sum of the terms and partial sums (mpfr_sum), the same with or without reduce().
+     */
+    mpfr::real<_prec, _rnd> result() const
+    {
+        mpfr::real<_prec, _rnd> s = 0.0;
+        if (count + partialCount == 0)
+            return s;
+        vector<mpfr_ptr> pointers(count + partialCount);
+        for (size_t i = 0; i < count; i++)
+            pointers[i] = const_cast<mpfr_ptr>(terms[i]._x);
+        for (size_t i = 0; i < partialCount; i++)
+            pointers[count + i] = const_cast<mpfr_ptr>(partials[i].value);
+        mpfr_sum(s._x, &pointers[0], count + partialCount, _rnd);
+        return s;
+    }
+
+private:
+    vector< mpfr::real<_prec, _rnd> > terms; /**< Terms of the sum, terms[0..count-1] */
+    size_t count;                            /**< Number of terms */
+    vector<ReductionPartial> partials;       /**< Exact sums of the terms of blocks, partials[0..partialCount-1] */
+    size_t partialCount;                     /**< Number of exact partial sums */
+};
+#endif
+
+#endif // REDUCTION_H_INCLUDED
@@ -18,15 +18,12 @@ Triangle::Triangle(Vertex *v1, Vertex *v2, Vertex *v3)
     this->neighbor[TRIANGLE_VERTEX_ONE]   = NULL;
     this->neighbor[TRIANGLE_VERTEX_TWO]   = NULL;
     this->neighbor[TRIANGLE_VERTEX_THREE] = NULL;
-    this->updateCcenter();
-    this->updateAngle();
-    this->updateRadiusEdge();  
-    this->updateShapeRegularityQuality(); 
+    this->updateQuality();
 }
 
 void Triangle::setVertices(Vertex *v1, Vertex *v2, Vertex *v3)
 {
-    mpfr::real<MPFR_BITS_PRECISION> *orientation = Utils::orientation(v1, v2, v3);
+    realNumber *orientation = Utils::orientation(v1, v2, v3);
     if( *orientation > 0 )
     {
         this->v[TRIANGLE_VERTEX_ONE]   = v1;
@@ -44,10 +41,7 @@ void Triangle::setVertices(Vertex *v1, Vertex *v2, Vertex *v3)
 
 void Triangle::update() {
     
-    this->updateCcenter();
-    this->updateAngle();
-    this->updateRadiusEdge();    
-    this->updateShapeRegularityQuality();   
+    this->updateQuality();
 }
 
 void Triangle::updateSRQ() {
@@ -61,9 +55,7 @@ void Triangle::setVertice( Vertex *v, int number)
     {
         this->v[number] = v;
         setVertices(this->v[TRIANGLE_VERTEX_ONE], this->v[TRIANGLE_VERTEX_TWO], this->v[TRIANGLE_VERTEX_THREE]);
-        updateCcenter();
-        updateAngle();
-        updateRadiusEdge();
+        updateQuality();
     }
     else
     {
@@ -112,6 +104,16 @@ void Triangle::replaceNeighbor(Triangle *oldNeighbor, Triangle *newNeighbor)
         this->neighbor[TRIANGLE_VERTEX_THREE] = newNeighbor;
 }
 
+void Triangle::replaceVertex(Vertex *oldVertex, Vertex *newVertex)
+{
+    if(this->v[TRIANGLE_VERTEX_ONE] == oldVertex)
+        this->v[TRIANGLE_VERTEX_ONE] = newVertex;
+    else if(this->v[TRIANGLE_VERTEX_TWO] == oldVertex)
+        this->v[TRIANGLE_VERTEX_TWO] = newVertex;
+    else if(this->v[TRIANGLE_VERTEX_THREE] == oldVertex)
+        this->v[TRIANGLE_VERTEX_THREE] = newVertex;
+}
+
 Vertex *Triangle::getVertex(int number)
 {
     if( !(number >= TRIANGLE_VERTEX_ONE && number <= TRIANGLE_VERTEX_THREE) )
@@ -150,78 +152,113 @@ int Triangle::getNumber(Vertex *v)
     return number;
 }
 
-void Triangle::updateCcenter()
+void Triangle::updateQuality()
 {
-    mpfr::real<MPFR_BITS_PRECISION> *x1 = NULL, *y1 = NULL, *x2 = NULL, *y2 = NULL, *x3 = NULL, *y3 = NULL, asq = 0, csq = 0, top1 = 0, top2 = 0, bot = 0, *sqrRadius = NULL;
+    realNumber *x1 = NULL, *y1 = NULL, *x2 = NULL, *y2 = NULL, *x3 = NULL, *y3 = NULL;
     x1 = &(v[TRIANGLE_VERTEX_ONE]->x);
     y1 = &(v[TRIANGLE_VERTEX_ONE]->y);
     x2 = &(v[TRIANGLE_VERTEX_TWO]->x);
     y2 = &(v[TRIANGLE_VERTEX_TWO]->y);
     x3 = &(v[TRIANGLE_VERTEX_THREE]->x);
     y3 = &(v[TRIANGLE_VERTEX_THREE]->y);
-    asq = ( *x2 - *x1 ) * ( *x2 - *x1 ) + ( *y2 - *y1 ) * ( *y2 - *y1 );
-    csq = ( *x3 - *x1 ) * ( *x3 - *x1 ) + ( *y3 - *y1 ) * ( *y3 - *y1 );
-    top1 = ( *y2 - *y1 ) * csq - ( *y3 - *y1 ) * asq;
-    top2 = -( *x2 - *x1 ) * csq + ( *x3 - *x1 ) * asq;
-    bot = ( ( *y2 - *y1 ) * ( *x3 - *x1 ) ) - ( ( *y3 - *y1 ) * ( *x2 - *x1 ) );
-    this->cCenter[COORDINATE_X] = *x1 +  (0.5*top1)/bot;
-    this->cCenter[COORDINATE_Y] = *y1 +  (0.5*top2)/bot;
+    // Edges vectors
+    realNumber dx21 = *x2 - *x1, dy21 = *y2 - *y1; // v2 - v1
+    realNumber dx31 = *x3 - *x1, dy31 = *y3 - *y1; // v3 - v1
+    realNumber dx32 = *x3 - *x2, dy32 = *y3 - *y2; // v3 - v2
+    // Squared edges lengths: sqrEdge[i] is the edge opposite to the vertex v[i]
+    realNumber sqrEdge[3];
+    sqrEdge[TRIANGLE_VERTEX_ONE]   = dx32 * dx32 + dy32 * dy32;
+    sqrEdge[TRIANGLE_VERTEX_TWO]   = dx31 * dx31 + dy31 * dy31;
+    sqrEdge[TRIANGLE_VERTEX_THREE] = dx21 * dx21 + dy21 * dy21;
+    //
+    /* Circumcenter and square of the circumradius */
+    //
+    realNumber top1 = 0, top2 = 0, bot = 0;
+    top1 = dy21 * sqrEdge[TRIANGLE_VERTEX_TWO] - dy31 * sqrEdge[TRIANGLE_VERTEX_THREE];
+    top2 = -dx21 * sqrEdge[TRIANGLE_VERTEX_TWO] + dx31 * sqrEdge[TRIANGLE_VERTEX_THREE];
+    bot = ( dy21 * dx31 ) - ( dy31 * dx21 );
     if( bot == 0.0 )
     {
-        cerr << "ERROR - UpdateCcenter(): Possible two points equals." << endl;
+        cerr << "ERROR - Triangle::updateQuality(): Possible two points equals." << endl;
         exit(EXIT_FAILURE);
     }
-    sqrRadius = Utils::distanceSQR(cCenter[COORDINATE_X], cCenter[COORDINATE_Y], v[TRIANGLE_VERTEX_ONE]);
-    this->sqrRadius = *sqrRadius;
-    delete sqrRadius;
+    this->cCenter[COORDINATE_X] = *x1 +  (0.5*top1)/bot;
+    this->cCenter[COORDINATE_Y] = *y1 +  (0.5*top2)/bot;
+    // Measured from the stored circumcenter, like the in-circle tests, to keep cocircular points consistent
+    top1 = this->cCenter[COORDINATE_X] - *x1;
+    top2 = this->cCenter[COORDINATE_Y] - *y1;
+    this->sqrRadius = (top1 * top1) + (top2 * top2);
+    //
+    /* Radius-to-shortest edge ratio: sqrt( R^2 / smallest edge^2 ) */
+    //
+    realNumber *sqrSmallerEdge = &(sqrEdge[TRIANGLE_VERTEX_THREE]);
+    if( sqrEdge[TRIANGLE_VERTEX_TWO] < *sqrSmallerEdge )
+        sqrSmallerEdge = &(sqrEdge[TRIANGLE_VERTEX_TWO]);
+    if( sqrEdge[TRIANGLE_VERTEX_ONE] < *sqrSmallerEdge )
+        sqrSmallerEdge = &(sqrEdge[TRIANGLE_VERTEX_ONE]);
+    this->radiusEdgeRatio = sqrt( this->sqrRadius / (*sqrSmallerEdge) );
+    //
+    /* Shape Regularity Quality: 2 * sqrt(3) * |2 * area| / sum of squared edges */
+    //
+    this->shapeRegularityQuality = (2 * sqrt(3) * abs(bot)) / ( sqrEdge[TRIANGLE_VERTEX_ONE] + sqrEdge[TRIANGLE_VERTEX_TWO] + sqrEdge[TRIANGLE_VERTEX_THREE] );
+    //
+    /* Obtuse angles: the angle in v[i] is obtuse if the dot product of its two edges is negative */
+    //
+    this->obtuseAngles[TRIANGLE_VERTEX_ONE]   = ( ( dx21 * dx31 ) + ( dy21 * dy31 ) ) < 0;
+    this->obtuseAngles[TRIANGLE_VERTEX_TWO]   = ( ( dx21 * dx32 ) + ( dy21 * dy32 ) ) > 0; // (v1 - v2).(v3 - v2) = -(v2 - v1).(v3 - v2)
+    this->obtuseAngles[TRIANGLE_VERTEX_THREE] = ( ( dx31 * dx32 ) + ( dy31 * dy32 ) ) < 0; // (v1 - v3).(v2 - v3) = (v3 - v1).(v3 - v2)
 }
 
-void Triangle::updateAngle()
+realNumber *Triangle::getAngle(int number)
 {
-    mpfr::real<MPFR_BITS_PRECISION> *V1V2 = Utils::distance(v[TRIANGLE_VERTEX_ONE], v[TRIANGLE_VERTEX_TWO]);
-    mpfr::real<MPFR_BITS_PRECISION> *V1V3 = Utils::distance(v[TRIANGLE_VERTEX_ONE], v[TRIANGLE_VERTEX_THREE]);
-    mpfr::real<MPFR_BITS_PRECISION> *V2V3 = Utils::distance(v[TRIANGLE_VERTEX_TWO], v[TRIANGLE_VERTEX_THREE]);
-    mpfr::real<MPFR_BITS_PRECISION> cosV1 = ( (*V1V2)*(*V1V2) + (*V1V3)*(*V1V3) - (*V2V3)*(*V2V3) )/ (2*(*V1V2)*(*V1V3));
-    mpfr::real<MPFR_BITS_PRECISION> cosV2 = ( (*V1V2)*(*V1V2) + (*V2V3)*(*V2V3) - (*V1V3)*(*V1V3) )/ (2*(*V1V2)*(*V2V3));
-    mpfr::real<MPFR_BITS_PRECISION> cosV3 = ( (*V1V3)*(*V1V3) + (*V2V3)*(*V2V3) - (*V1V2)*(*V1V2) )/ (2*(*V1V3)*(*V2V3));    
-    delete V1V2;
-    delete V1V3;
-    delete V2V3;
-    mpfr::real<MPFR_BITS_PRECISION> r = 180 / mpfr::const_pi<MPFR_BITS_PRECISION, MPFR_RNDN> (); // RADIAN TO DEGREES 57.295779513082320876; 
-    this->angles[TRIANGLE_VERTEX_ONE]   = acos(cosV1) * r;
-    this->angles[TRIANGLE_VERTEX_TWO]   = acos(cosV2) * r;
-    this->angles[TRIANGLE_VERTEX_THREE] = acos(cosV3) * r;
-    mpfr_free_cache();
+    if( !(number >= TRIANGLE_VERTEX_ONE && number <= TRIANGLE_VERTEX_THREE) )
+    {
+        cerr << "ERROR - Triangle::getAngle" << endl;
+        exit(EXIT_FAILURE);
+    }
+    Vertex *v0 = this->v[number];
+    Vertex *v1 = this->v[(number + 1) % 3];
+    Vertex *v2 = this->v[(number + 2) % 3];
+    realNumber *angle = new realNumber(0);
+    realNumber *l1 = Utils::distanceSQR(v0, v1);
+    realNumber *l2 = Utils::distanceSQR(v0, v2);
+    realNumber dot = ( (v1->x - v0->x) * (v2->x - v0->x) ) + ( (v1->y - v0->y) * (v2->y - v0->y) );
+    realNumber r = 180 / realNumberPi(); // RADIAN TO DEGREES 57.295779513082320876; 
+    *angle = acos( dot / sqrt( (*l1) * (*l2) ) ) * r;
+    delete l1;
+    delete l2;
+    realNumberFreeCache();
+    return angle;
 }
 
-bool Triangle::isInside(mpfr::real<MPFR_BITS_PRECISION> &px, mpfr::real<MPFR_BITS_PRECISION> &py)
+bool Triangle::isInside(realNumber &px, realNumber &py)
 {
-    mpfr::real<MPFR_BITS_PRECISION> *v1x = &(v[TRIANGLE_VERTEX_ONE]->x);
-    mpfr::real<MPFR_BITS_PRECISION> *v1y = &(v[TRIANGLE_VERTEX_ONE]->y);
-    mpfr::real<MPFR_BITS_PRECISION> *v2x = &(v[TRIANGLE_VERTEX_TWO]->x);
-    mpfr::real<MPFR_BITS_PRECISION> *v2y = &(v[TRIANGLE_VERTEX_TWO]->y);
-    mpfr::real<MPFR_BITS_PRECISION> *v3x = &(v[TRIANGLE_VERTEX_THREE]->x);
-    mpfr::real<MPFR_BITS_PRECISION> *v3y = &(v[TRIANGLE_VERTEX_THREE]->y);
+    realNumber *v1x = &(v[TRIANGLE_VERTEX_ONE]->x);
+    realNumber *v1y = &(v[TRIANGLE_VERTEX_ONE]->y);
+    realNumber *v2x = &(v[TRIANGLE_VERTEX_TWO]->x);
+    realNumber *v2y = &(v[TRIANGLE_VERTEX_TWO]->y);
+    realNumber *v3x = &(v[TRIANGLE_VERTEX_THREE]->x);
+    realNumber *v3y = &(v[TRIANGLE_VERTEX_THREE]->y);
     //
     /* Barycentre technique */
     //
     /* t->v1 is the origin  */
-    mpfr::real<MPFR_BITS_PRECISION> v00x = *v3x - *v1x; // t->v3 - t->v1
-    mpfr::real<MPFR_BITS_PRECISION> v00y = *v3y - *v1y;
-    mpfr::real<MPFR_BITS_PRECISION> v01x = *v2x - *v1x; // t->v2 - t->v1
-    mpfr::real<MPFR_BITS_PRECISION> v01y = *v2y - *v1y;
-    mpfr::real<MPFR_BITS_PRECISION> v02x = px - *v1x; // p - t->v1
-    mpfr::real<MPFR_BITS_PRECISION> v02y = py - *v1y;
+    realNumber v00x = *v3x - *v1x; // t->v3 - t->v1
+    realNumber v00y = *v3y - *v1y;
+    realNumber v01x = *v2x - *v1x; // t->v2 - t->v1
+    realNumber v01y = *v2y - *v1y;
+    realNumber v02x = px - *v1x; // p - t->v1
+    realNumber v02y = py - *v1y;
     // Compute dot products
-    mpfr::real<MPFR_BITS_PRECISION> dot00 = (v00x * v00x) + (v00y * v00y);
-    mpfr::real<MPFR_BITS_PRECISION> dot01 = (v00x * v01x) + (v00y * v01y);
-    mpfr::real<MPFR_BITS_PRECISION> dot02 = (v00x * v02x) + (v00y * v02y);
-    mpfr::real<MPFR_BITS_PRECISION> dot11 = (v01x * v01x) + (v01y * v01y);
-    mpfr::real<MPFR_BITS_PRECISION> dot12 = (v01x * v02x) + (v01y * v02y);
+    realNumber dot00 = (v00x * v00x) + (v00y * v00y);
+    realNumber dot01 = (v00x * v01x) + (v00y * v01y);
+    realNumber dot02 = (v00x * v02x) + (v00y * v02y);
+    realNumber dot11 = (v01x * v01x) + (v01y * v01y);
+    realNumber dot12 = (v01x * v02x) + (v01y * v02y);
     // Compute barycentric coordinates
-    mpfr::real<MPFR_BITS_PRECISION> invDenom = 1/( (dot00 * dot11) - (dot01 * dot01) );
-    mpfr::real<MPFR_BITS_PRECISION> u = ( (dot11 * dot02) - (dot01 * dot12) ) * invDenom;
-    mpfr::real<MPFR_BITS_PRECISION> v = ( (dot00 * dot12) - (dot01 * dot02) ) * invDenom;
+    realNumber invDenom = 1/( (dot00 * dot11) - (dot01 * dot01) );
+    realNumber u = ( (dot11 * dot02) - (dot01 * dot12) ) * invDenom;
+    realNumber v = ( (dot00 * dot12) - (dot01 * dot02) ) * invDenom;
     // Check if point is in triangle
     bool method1 = (u >= 0) && (v >= 0) && (u + v <= 1.0);
     //
@@ -229,7 +266,7 @@ bool Triangle::isInside(mpfr::real<MPFR_BITS_PRECISION> &px, mpfr::real<MPFR_BIT
     //
     int crossings = 0;
     /* EDGE V1 - V2 */
-    mpfr::real<MPFR_BITS_PRECISION> slope = 0;
+    realNumber slope = 0;
     slope = (*v2y - *v1y)/(*v2x - *v1x);
     bool cond1 = (*v1x <= px) && (px < *v2x);
     bool cond2 = (*v2x <= px) && (px < *v1x);
@@ -254,9 +291,9 @@ bool Triangle::isInside(mpfr::real<MPFR_BITS_PRECISION> &px, mpfr::real<MPFR_BIT
     //
     /* Orientation technique */
     //
-    mpfr::real<MPFR_BITS_PRECISION> *orientation1 = Utils::orientation(px, py, this->v[TRIANGLE_VERTEX_ONE], this->v[TRIANGLE_VERTEX_TWO]);
-    mpfr::real<MPFR_BITS_PRECISION> *orientation2 = Utils::orientation(px, py, this->v[TRIANGLE_VERTEX_TWO], this->v[TRIANGLE_VERTEX_THREE]);
-    mpfr::real<MPFR_BITS_PRECISION> *orientation3 = Utils::orientation(px, py, this->v[TRIANGLE_VERTEX_THREE], this->v[TRIANGLE_VERTEX_ONE]);
+    realNumber *orientation1 = Utils::orientation(px, py, this->v[TRIANGLE_VERTEX_ONE], this->v[TRIANGLE_VERTEX_TWO]);
+    realNumber *orientation2 = Utils::orientation(px, py, this->v[TRIANGLE_VERTEX_TWO], this->v[TRIANGLE_VERTEX_THREE]);
+    realNumber *orientation3 = Utils::orientation(px, py, this->v[TRIANGLE_VERTEX_THREE], this->v[TRIANGLE_VERTEX_ONE]);
     bool method3 = (*orientation1 >= 0) && (*orientation2 >= 0) && (*orientation3 >= 0);
     delete orientation1;
     delete orientation2;
@@ -267,9 +304,9 @@ bool Triangle::isInside(mpfr::real<MPFR_BITS_PRECISION> &px, mpfr::real<MPFR_BIT
 
 Adjacency *Triangle::getSmallerEdge()
 {
-    mpfr::real<MPFR_BITS_PRECISION> *v0v1 = Utils::distanceSQR(v[TRIANGLE_VERTEX_ONE],v[TRIANGLE_VERTEX_TWO]);
-    mpfr::real<MPFR_BITS_PRECISION> *v0v2 = Utils::distanceSQR(v[TRIANGLE_VERTEX_ONE],v[TRIANGLE_VERTEX_THREE]);
-    mpfr::real<MPFR_BITS_PRECISION> *v1v2 = Utils::distanceSQR(v[TRIANGLE_VERTEX_TWO],v[TRIANGLE_VERTEX_THREE]);
+    realNumber *v0v1 = Utils::distanceSQR(v[TRIANGLE_VERTEX_ONE],v[TRIANGLE_VERTEX_TWO]);
+    realNumber *v0v2 = Utils::distanceSQR(v[TRIANGLE_VERTEX_ONE],v[TRIANGLE_VERTEX_THREE]);
+    realNumber *v1v2 = Utils::distanceSQR(v[TRIANGLE_VERTEX_TWO],v[TRIANGLE_VERTEX_THREE]);
     Adjacency *edge;
     if( (*v0v1 <= *v0v2) && (*v0v1 <= *v1v2) )
         edge = v[TRIANGLE_VERTEX_ONE]->getAdjacency(v[TRIANGLE_VERTEX_TWO]);
@@ -283,44 +320,14 @@ Adjacency *Triangle::getSmallerEdge()
     return edge;    
 }
 
-void Triangle::updateRadiusEdge()
-{
-    mpfr::real<MPFR_BITS_PRECISION> *v0v1 = Utils::distanceSQR(v[TRIANGLE_VERTEX_ONE],v[TRIANGLE_VERTEX_TWO]);
-    mpfr::real<MPFR_BITS_PRECISION> *v0v2 = Utils::distanceSQR(v[TRIANGLE_VERTEX_ONE],v[TRIANGLE_VERTEX_THREE]);
-    mpfr::real<MPFR_BITS_PRECISION> *v1v2 = Utils::distanceSQR(v[TRIANGLE_VERTEX_TWO],v[TRIANGLE_VERTEX_THREE]);
-    Vertex *v0, *v1;
-    if( (*v0v1 <= *v0v2) && (*v0v1 <= *v1v2) )
-    {
-        v0 = v[TRIANGLE_VERTEX_ONE];
-        v1 = v[TRIANGLE_VERTEX_TWO];
-    }
-    else if( (*v0v2 <= *v0v1) && (*v0v2 <= *v1v2) )
-    {
-        v0 = v[TRIANGLE_VERTEX_ONE];
-        v1 = v[TRIANGLE_VERTEX_THREE];
-    }
-    else
-    {
-        v0 = v[TRIANGLE_VERTEX_TWO];
-        v1 = v[TRIANGLE_VERTEX_THREE];
-    }
-    mpfr::real<MPFR_BITS_PRECISION> *length = Utils::distance(v0, v1);
-    this->radiusEdgeRatio = sqrt(this->sqrRadius);
-    this->radiusEdgeRatio = this->radiusEdgeRatio/(*length);
-    delete length;
-    delete v0v1;
-    delete v0v2; 
-    delete v1v2;
-}
-
 void Triangle::setVerticeToNull(int number)
 {
     this->v[number] = NULL;
 }
 
-Vertex *Triangle::getNearestVertexInsideTriangle(mpfr::real<MPFR_BITS_PRECISION> &px , mpfr::real<MPFR_BITS_PRECISION> &py, Triangle *t) 
+Vertex *Triangle::getNearestVertexInsideTriangle(realNumber &px , realNumber &py, Triangle *t) 
 {
-    mpfr::real<MPFR_BITS_PRECISION> *distance = NULL, *shortestDistanceSQR = NULL;
+    realNumber *distance = NULL, *shortestDistanceSQR = NULL;
     Vertex *nearestVertex = t->v[TRIANGLE_VERTEX_ONE];
     shortestDistanceSQR = Utils::distanceSQR(px, py, t->v[TRIANGLE_VERTEX_ONE]); 
     distance = Utils::distanceSQR(px, py, t->v[TRIANGLE_VERTEX_TWO]);
@@ -377,14 +384,17 @@ void Triangle::getNeighbors(list<Triangle*> &listTriangles) {
 
 void Triangle::updateShapeRegularityQuality() {
   
-    mpfr::real<MPFR_BITS_PRECISION> *l1 = NULL, *l2 = NULL, *l3 = NULL, t;
+    realNumber dx21, dy21, dx31, dy31, dx32, dy32, t;
     // Counter Clockwise t < 0; Clockwise t > 0;
     Vertex *v1 = this->v[TRIANGLE_VERTEX_ONE];
     Vertex *v2 = this->v[TRIANGLE_VERTEX_TWO];
     Vertex *v3 = this->v[TRIANGLE_VERTEX_THREE];
-    t = abs( ((v2->x - v1->x)*(v3->y - v1->y)) - ((v3->x - v1->x)*(v2->y - v1->y)) );
-    l1 = Utils::distanceSQR(v3, v2);
-    l2 = Utils::distanceSQR(v1, v3);
-    l3 = Utils::distanceSQR(v1, v2);
-    this->shapeRegularityQuality = (2 * sqrt(3) * t) / ( (*l1) + (*l2) + (*l3) ); 
-}  
\ No newline at end of file
+    dx21 = v2->x - v1->x;
+    dy21 = v2->y - v1->y;
+    dx31 = v3->x - v1->x;
+    dy31 = v3->y - v1->y;
+    dx32 = v3->x - v2->x;
+    dy32 = v3->y - v2->y;
+    t = abs( (dx21 * dy31) - (dx31 * dy21) );
+    this->shapeRegularityQuality = (2 * sqrt(3) * t) / ( (dx32 * dx32 + dy32 * dy32) + (dx31 * dx31 + dy31 * dy31) + (dx21 * dx21 + dy21 * dy21) ); 
+}
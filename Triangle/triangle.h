@@ -16,11 +16,11 @@ public:
     //
     // Attributes
     //
-    mpfr::real<MPFR_BITS_PRECISION> sqrRadius;       	    /**< Square of the circumradius. */
-    mpfr::real<MPFR_BITS_PRECISION> shapeRegularityQuality; /**< Square of the circumradius. */
-    mpfr::real<MPFR_BITS_PRECISION> cCenter[2];             /**< Coordinates of the circumcenter. */
-    mpfr::real<MPFR_BITS_PRECISION> angles[3];              /**< angle[i] is the angle in the vertex v[i]*/
-    mpfr::real<MPFR_BITS_PRECISION> radiusEdgeRatio;        /**< Radius-to-shortest edge ratio. */
+    realNumber sqrRadius;              /**< Square of the circumradius. */
+    realNumber shapeRegularityQuality; /**< Square of the circumradius. */
+    realNumber cCenter[2];             /**< Coordinates of the circumcenter. */
+    realNumber radiusEdgeRatio;        /**< Radius-to-shortest edge ratio. */
+    bool obtuseAngles[3];              /**< obtuseAngles[i] is true if the angle in the vertex v[i] is greater than 90 degrees */
     //
     // Methods
     //
@@ -62,6 +62,12 @@ public:
      * @param newNeighbor
      */
     void replaceNeighbor(Triangle *oldNeighbor, Triangle *newNeighbor);
+    /**
+     * Replace the vertex "oldVertex" for "newVertex", a copy of it (same coordinates) at another address.
+     * @param oldVertex
+     * @param newVertex
+     */
+    void replaceVertex(Vertex *oldVertex, Vertex *newVertex);
     /**
      * Get the vertex with index 'number'. Returns a error if the number is other than 0, 1 or 2
      * @param number
@@ -74,6 +80,13 @@ public:
      * @return the vertex or neighbor with index 'number' or error.
      */    
     Triangle *getNeighbor(int number);
+    /**
+     * Get the angle, in degrees, in the vertex with index 'number'. The angles are not stored in the triangle,
+       they are computed on demand (acos) and should be used only to print values.
+     * @param number of vertice.
+     * @return angle in degrees.
+     */
+    realNumber *getAngle(int number);
     /**
      * Get the smaller edge of the triangle.
      * @return the smaller triangle's edge.
@@ -91,14 +104,14 @@ public:
      * @param py y coordenate of vertex.
      * @return number of the vertex or -1 (if vertex not found).
      */
-    bool isInside(mpfr::real<MPFR_BITS_PRECISION> &px, mpfr::real<MPFR_BITS_PRECISION> &py);
+    bool isInside(realNumber &px, realNumber &py);
     /**
      * Get nearest vertex of a point which is inside the triangle.
      * @param px x coordenate of vertex.
      * @param py y coordenate of vertex.
      * @return u value.
      */
-    Vertex *getNearestVertexInsideTriangle(mpfr::real<MPFR_BITS_PRECISION> &px, mpfr::real<MPFR_BITS_PRECISION> &py, Triangle *t);    
+    Vertex *getNearestVertexInsideTriangle(realNumber &px, realNumber &py, Triangle *t);    
     /**
      * Checks if a triangle has a vertex.
      */
@@ -109,7 +122,7 @@ public:
      */
     void getNeighbors(list<Triangle *> &listTriangles);
     /**
-     *  Update circuncenter, angle and CircunradiusToShortestEdgeRatio;
+     *  Update circuncenter, obtuse angles, CircunradiusToShortestEdgeRatio and ShapeRegularityQuality;
      */
     void update();
     /**
@@ -127,17 +140,11 @@ private:
     // Methods
     //
     /**
-     * Update the circumcenter coordinates.
-     */
-    void updateCcenter();
-    /**
-     * Update the angles of the triangle.
-     */
-    void updateAngle();
-    /**
-     * Update the radius-to-shortest edge ratio.
+     * Fused quality kernel. Computes the squared edge lengths once and derives the circumcenter coordinates,
+       the square of the circumradius, the radius-to-shortest edge ratio, the Shape Regularity Quality and the
+       obtuse angles flags (sign of dot products). No transcendental function is evaluated.
      */
-    void updateRadiusEdge();    
+    void updateQuality();
     /**
      * Update the Shape Regularity Quality.
      */
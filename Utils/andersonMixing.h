@@ -0,0 +1,147 @@
+/****** Declaration and implementation of the class AndersonMixing ******/
+/* Anderson acceleration of a fixed point iteration x_k+1 = G(x_k). With the residuals f_k = G(x_k) - x_k of the last
+   depth iterations, the next iterate is the combination of the images G(x_j) whose combination of residuals has the
+   least norm:
+       x_k+1 = G(x_k) - sum_j gamma_j (G(x_j+1) - G(x_j)),  gamma = argmin || f_k - sum_j gamma_j (f_j+1 - f_j) ||
+   The least squares problem is solved by the normal equations, regularized by ANDERSON_REGULARIZATION. The
+   differences are kept in double: the correction is a perturbation of G(x_k), added by the caller in its own
+   precision. The history restarts if the residual grows (the map G changed, or the iteration left the region where
+   the mixing converges). Header only. */
+
+#ifndef ANDERSONMIXING_H_INCLUDED
+#define ANDERSONMIXING_H_INCLUDED
+
+#include <cmath>
+#include <deque>
+#include <vector>
+#include "constants.h"
+using namespace std;
+
+class AndersonMixing
+{
+public:
+    /**
+     * Constructor.
+     * @param depth number of differences of the history (0 = no acceleration).
+     */
+    AndersonMixing(int depth)
+    {
+        this->depth = depth;
+        this->previousNormF = 0;
+    }
+    /**
+     * Clears the history (the map G changed, or the last correction was rejected).
+     */
+    void clear()
+    {
+        differenceG.clear();
+        differenceF.clear();
+        previousG.clear();
+        previousF.clear();
+    }
+    /**
+     * Adds the iteration to the history and computes the correction of G(x_k).
+     * @param g image G(x_k) of the iterate.
+     * @param f residual G(x_k) - x_k.
+     * @param correction set to - sum_j gamma_j (G(x_j+1) - G(x_j)), to add to g.
+     * @return false (correction not set) on the first iteration of the history (also after a restart, if the size of the
+                 vectors changed or ||f|| grew by more than ANDERSON_RESTART_GROWTH) or if a coefficient exceeds
+                 ANDERSON_MAXIMUM_COEFFICIENT (the history is then cleared).
+     */
+    bool mix(const vector<double> &g, const vector<double> &f, vector<double> &correction)
+    {
+        double normF = 0;
+        for (size_t i = 0; i < f.size(); i++)
+            normF += f[i] * f[i];
+        normF = sqrt(normF);
+        // Restart: the residual grew, the iterates left the region where the mixing converges
+        if ( (depth <= 0) || ( !previousG.empty() && ( (previousG.size() != g.size()) || (normF > ANDERSON_RESTART_GROWTH * previousNormF) ) ) )
+            clear();
+        if (!previousG.empty())
+        {
+            differenceG.push_back(g);
+            differenceF.push_back(f);
+            for (size_t i = 0; i < g.size(); i++)
+            {
+                differenceG.back()[i] -= previousG[i];
+                differenceF.back()[i] -= previousF[i];
+            }
+            if ((int) differenceG.size() > depth)
+            {
+                differenceG.pop_front();
+                differenceF.pop_front();
+            }
+        }
+        previousG = g;
+        previousF = f;
+        previousNormF = normF;
+        int m = (int) differenceF.size();
+        if (m == 0)
+            return false;
+        // Normal equations (dF^T dF + lambda I) gamma = dF^T f, in an augmented matrix
+        vector< vector<double> > A(m, vector<double>(m + 1, 0.0));
+        double trace = 0;
+        for (int i = 0; i < m; i++)
+        {
+            for (int j = i; j < m; j++)
+            {
+                double sum = 0;
+                for (size_t k = 0; k < f.size(); k++)
+                    sum += differenceF[i][k] * differenceF[j][k];
+                A[i][j] = A[j][i] = sum;
+            }
+            for (size_t k = 0; k < f.size(); k++)
+                A[i][m] += differenceF[i][k] * f[k];
+            trace += A[i][i];
+        }
+        if (trace <= 0)
+        {
+            clear();
+            return false;
+        }
+        for (int i = 0; i < m; i++)
+            A[i][i] += ANDERSON_REGULARIZATION * trace / m;
+        // Gaussian elimination with partial pivoting
+        for (int c = 0; c < m; c++)
+        {
+            int pivot = c;
+            for (int i = c + 1; i < m; i++)
+                if (fabs(A[i][c]) > fabs(A[pivot][c]))
+                    pivot = i;
+            A[c].swap(A[pivot]);
+            for (int i = c + 1; i < m; i++)
+            {
+                double factor = A[i][c] / A[c][c];
+                for (int j = c; j <= m; j++)
+                    A[i][j] -= factor * A[c][j];
+            }
+        }
+        vector<double> gamma(m);
+        for (int i = m - 1; i >= 0; i--)
+        {
+            double sum = A[i][m];
+            for (int j = i + 1; j < m; j++)
+                sum -= A[i][j] * gamma[j];
+            gamma[i] = sum / A[i][i];
+            if ( !(fabs(gamma[i]) <= ANDERSON_MAXIMUM_COEFFICIENT) )
+            {
+                clear();
+                return false;
+            }
+        }
+        correction.assign(g.size(), 0.0);
+        for (int j = 0; j < m; j++)
+            for (size_t k = 0; k < g.size(); k++)
+                correction[k] -= gamma[j] * differenceG[j][k];
+        return true;
+    }
+
+private:
+    int depth;                             /**< Maximum number of differences */
+    deque< vector<double> > differenceG;   /**< G(x_j+1) - G(x_j) of the last iterations */
+    deque< vector<double> > differenceF;   /**< f_j+1 - f_j of the last iterations */
+    vector<double> previousG, previousF;   /**< G(x_k) and f_k of the last iteration */
+    double previousNormF;                  /**< ||f_k||_2 of the last iteration */
+};
+
+#endif // ANDERSONMIXING_H_INCLUDED
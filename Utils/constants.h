@@ -21,12 +21,64 @@
 #define UTILS_CM_RANDOM           0  
 #define UTILS_CM_PSEUDOPERIPHERAL 1  
 #define UTILS_CM_SMALLER_DEGREE   2  
+// Orderings of the list of vertices
+#define MESH_ORDERING_CUTHILL_MCKEE      0  /**< Cuthill-McKee (reverse by CONFIG_CUTHILL_MCKEE_REVERSE) */
+#define MESH_ORDERING_HILBERT            1  /**< Hilbert curve of the coordinates */
+#define MESH_ORDERING_MORTON             2  /**< Morton (Z) curve of the coordinates */
+#define MESH_ORDERING_NESTED_DISSECTION  3  /**< Geometric nested dissection, separators last */
+#define MESH_SPACE_FILLING_CURVE_BITS    16 /**< Bits of each coordinate in the keys of the space-filling curves */
+#define MESH_NESTED_DISSECTION_MINIMUM   32 /**< Parts of the nested dissection with at most this number of vertices are not divided */
+#define MESH_ORIENTATION_FILTER_ERROR    2e-15 /**< Relative error bound (8 epsilons) of the orientation computed in double by Mesh::checkMovedTriangles() */
+#define MESH_ROLLBACK_DAMPING_STEPS      4     /**< Halvings of the displacements of the vertices of inverted triangles before they are reverted by Mesh::repairMovedTriangles() */
+#define MESH_ORDERING_CACHE_LINE_BYTES   64    /**< Cache line of the estimate of Utils::getOrderingStatistics() */
+#define MESH_ORDERING_CACHE_BYTES        32768 /**< Cache (fully associative, least recently used) of the estimate of Utils::getOrderingStatistics() */
 // Type of monitor function
 #define MONITOR_FUNCTION_LAMBDA    0  
 #define MONITOR_FUNCTION_UPSILON   1 
 #define MONITOR_FUNCTION_XI        2
 #define MONITOR_FUNCTION_GAMMA     3
 #define MONITOR_FUNCTION_PSI       4
+// Conjugate gradient methods
+#define CG_METHOD_CLASSIC          0  /**< Four sweeps of the vertices per iteration */
+#define CG_METHOD_FUSED            1  /**< Chronopoulos-Gear, two sweeps of the vertices per iteration */
+#define CG_METHOD_PIPELINED        2  /**< Ghysels-Vanroose, one reduction per iteration, multithreaded */
+#define CG_METHOD_MULTIGRID_PCG    3  /**< Conjugate gradient preconditioned by one multigrid cycle */
+#define CG_METHOD_MULTIGRID        4  /**< Multigrid cycles */
+#define CG_METHOD_CHOLESKY         5  /**< Sparse Cholesky factorization (direct) */
+#define CG_METHOD_DEFLATED         6  /**< Deflated conjugate gradient, approximate eigenvectors recycled between solves */
+#define CG_METHOD_CHEBYSHEV        7  /**< Chebyshev semi-iterative method, no inner products, multithreaded */
+#define CG_METHOD_CHEBYSHEV_PCG    8  /**< Conjugate gradient preconditioned by a Chebyshev polynomial */
+#define CG_PIPELINED_REPLACEMENT_PERIOD 50 /**< Iterations between the residual replacements of CG_METHOD_PIPELINED */
+#define CHOLESKY_REFACTOR_ITERATIONS    10 /**< Iterations of the conjugate gradient preconditioned by an outdated factor that cause a refactorization */
+#define CG_DEFLATION_RECYCLED_DIRECTIONS  20    /**< First search directions of a solve used to update the deflation space */
+#define CG_DEFLATION_DEPENDENCE_TOLERANCE 1e-10 /**< A recycled vector is dropped if the A-orthogonalization leaves less than this fraction of its squared A-norm */
+// Multigrid
+#define MULTIGRID_V_CYCLE                1    /**< One coarse cycle per cycle */
+#define MULTIGRID_W_CYCLE                2    /**< Two coarse cycles per cycle */
+#define MULTIGRID_COARSENING_REFINEMENT  0    /**< Geometric levels of the refinement stages */
+#define MULTIGRID_COARSENING_AGGREGATION 1    /**< Smoothed aggregation (algebraic) */
+#define MULTIGRID_STRENGTH_THRESHOLD     0.08 /**< Strong connection of the aggregation: |a_ij| >= threshold * sqrt(a_ii * a_jj) */
+#define MULTIGRID_SMOOTHING_SWEEPS       1    /**< Gauss-Seidel sweeps before and after the coarse correction */
+#define MULTIGRID_COARSEST_SIZE          200  /**< Maximum number of unknowns of the coarsest level (dense factorization) */
+#define MULTIGRID_COARSEST_SWEEPS        4    /**< Symmetric Gauss-Seidel sweeps of a coarsest level too big to be factored */
+#define MULTIGRID_MAX_COARSENING_RATIO   0.8  /**< Maximum ratio between the unknowns of a coarse level and of the level above */
+#define MULTIGRID_SMOOTHER_GAUSS_SEIDEL  0    /**< Forward and backward Gauss-Seidel sweeps */
+#define MULTIGRID_SMOOTHER_CHEBYSHEV     1    /**< Chebyshev polynomial of D^-1 A */
+#define MULTIGRID_CHEBYSHEV_DEGREE       2    /**< Steps of the Chebyshev smoother before and after the coarse correction */
+#define MULTIGRID_CHEBYSHEV_RATIO        0.125 /**< Lower end of the interval of the Chebyshev smoother, relative to the upper end */
+// Chebyshev
+#define CHEBYSHEV_LANCZOS_STEPS          10   /**< Conjugate gradient steps that estimate the smallest eigenvalue */
+#define CHEBYSHEV_BISECTION_STEPS        60   /**< Bisection steps of the smallest Ritz value */
+#define CHEBYSHEV_MINIMUM_RATIO          0.01 /**< Lower end of the interval, relative to the upper end, when Gershgorin gives no positive bound */
+#define CHEBYSHEV_CHECK_PERIOD           10   /**< Iterations between the convergence tests (the only reductions) of CG_METHOD_CHEBYSHEV */
+#define CHEBYSHEV_PRECONDITIONER_DEGREE  4    /**< Steps of the Chebyshev preconditioner */
+#define ANDERSON_REGULARIZATION          1e-10 /**< Regularization of the least squares of AndersonMixing, relative to the mean diagonal */
+#define ANDERSON_MAXIMUM_COEFFICIENT     10    /**< Coefficients of AndersonMixing above this value reject the correction (safeguard) */
+#define ANDERSON_RESTART_GROWTH          1.0   /**< AndersonMixing restarts its history if the residual grows by more than this factor */
+// Conjugate gradient convergence criteria
+#define CG_CRITERION_UPDATE              0  /**< Infinit norm of the relative update of u */
+#define CG_CRITERION_RELATIVE_RESIDUAL   1  /**< ||r|| / ||b|| */
+#define CG_CRITERION_ABSOLUTE_RESIDUAL   2  /**< ||r|| */
 //
 // Triangle constants
 //
@@ -57,6 +109,16 @@
 //
 #define MPFR_BITS_PRECISION     512  /**< The calculation is done with maximum of 4096 bits of precision */
 //
+// Real number constants (type of realNumber, see Real/realNumber.h)
+//
+#define REAL_NUMBER_MPFR           0  /**< mpfr::real<MPFR_BITS_PRECISION> */
+#define REAL_NUMBER_DOUBLE_DOUBLE  1  /**< DoubleDouble, about 106 bits of precision */
+#define REAL_NUMBER_QUAD_DOUBLE    2  /**< QuadDouble, about 212 bits of precision */
+#ifndef REAL_NUMBER_TYPE
+#define REAL_NUMBER_TYPE           REAL_NUMBER_MPFR
+#endif
+#define REDUCTION_CHUNK_SIZE       256 /**< Terms of each chunk of the compensated sums of Reduction (the sums do not depend on the blocks of the threads) */
+//
 // Print constants
 //
 #define QUOTES                  "\""
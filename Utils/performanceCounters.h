@@ -0,0 +1,116 @@
+/****** Declaration and implementation of the class PerformanceCounters ******/
+/* Hardware event counters of the calling thread by perf_event_open (Linux): cycles, instructions, cache references
+   and cache misses (last level). The threads created while counting are included (inherit), so the workers of the
+   multithreaded solvers are counted. Only the user space is counted, which /proc/sys/kernel/perf_event_paranoid <= 2
+   allows to any user. Where the counters are not available (other systems, virtual machines without a PMU) the
+   values are -1. Header only. */
+
+#ifndef PERFORMANCECOUNTERS_H_INCLUDED
+#define PERFORMANCECOUNTERS_H_INCLUDED
+
+#ifdef __linux__
+#include <cstring>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#define PERFORMANCE_COUNTER_CYCLES           0
+#define PERFORMANCE_COUNTER_INSTRUCTIONS     1
+#define PERFORMANCE_COUNTER_CACHE_REFERENCES 2
+#define PERFORMANCE_COUNTER_CACHE_MISSES     3
+#define PERFORMANCE_COUNTERS                 4
+
+class PerformanceCounters
+{
+public:
+    /**
+     * Constructor. Opens the counters, disabled.
+     */
+    PerformanceCounters()
+    {
+        for (int i = 0; i < PERFORMANCE_COUNTERS; i++)
+        {
+            fd[i] = -1;
+            value[i] = -1;
+        }
+#ifdef __linux__
+        const unsigned long long events[PERFORMANCE_COUNTERS] = { PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                                                  PERF_COUNT_HW_CACHE_REFERENCES, PERF_COUNT_HW_CACHE_MISSES };
+        for (int i = 0; i < PERFORMANCE_COUNTERS; i++)
+        {
+            struct perf_event_attr attributes;
+            memset(&attributes, 0, sizeof(attributes));
+            attributes.type           = PERF_TYPE_HARDWARE;
+            attributes.size           = sizeof(attributes);
+            attributes.config         = events[i];
+            attributes.disabled       = 1;
+            attributes.inherit        = 1;
+            attributes.exclude_kernel = 1;
+            attributes.exclude_hv     = 1;
+            fd[i] = (int) syscall(__NR_perf_event_open, &attributes, 0, -1, -1, 0);
+        }
+#endif
+    }
+    /**
+     * Destructor. Closes the counters.
+     */
+    ~PerformanceCounters()
+    {
+#ifdef __linux__
+        for (int i = 0; i < PERFORMANCE_COUNTERS; i++)
+            if (fd[i] >= 0)
+                close(fd[i]);
+#endif
+    }
+    /**
+     * Resets and enables the counters.
+     */
+    void start()
+    {
+#ifdef __linux__
+        for (int i = 0; i < PERFORMANCE_COUNTERS; i++)
+        {
+            if (fd[i] >= 0)
+            {
+                ioctl(fd[i], PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd[i], PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+    }
+    /**
+     * Disables the counters and reads the values.
+     */
+    void stop()
+    {
+#ifdef __linux__
+        for (int i = 0; i < PERFORMANCE_COUNTERS; i++)
+        {
+            if (fd[i] >= 0)
+            {
+                ioctl(fd[i], PERF_EVENT_IOC_DISABLE, 0);
+                long long count;
+                value[i] = (read(fd[i], &count, sizeof(count)) == (ssize_t) sizeof(count)) ? count : -1;
+            }
+        }
+#endif
+    }
+    /**
+     * Value of the counter between start() and stop().
+     * @param counter PERFORMANCE_COUNTER_CYCLES, PERFORMANCE_COUNTER_INSTRUCTIONS, PERFORMANCE_COUNTER_CACHE_REFERENCES or
+                      PERFORMANCE_COUNTER_CACHE_MISSES.
+     * @return number of events, -1 if the counter is not available.
+     */
+    long long getValue(int counter) const
+    {
+        return value[counter];
+    }
+
+private:
+    int fd[PERFORMANCE_COUNTERS];          /**< File descriptors of the counters (-1 = not available) */
+    long long value[PERFORMANCE_COUNTERS]; /**< Values read by stop() */
+};
+
+#endif // PERFORMANCECOUNTERS_H_INCLUDED
@@ -2,6 +2,7 @@
 #include <iomanip>
 #include <string>
 #include <vector>
+#include <map>
 #include <sstream>
 #include "utils.h"
 #include "../Mesh/mesh.h"
@@ -11,9 +12,9 @@
 #include <unsupported/Eigen/IterativeSolvers>
 using namespace Eigen;
 */
-mpfr::real<MPFR_BITS_PRECISION> *Utils::orientation(Vertex *v1, Vertex *v2, Vertex *v3)
+realNumber *Utils::orientation(Vertex *v1, Vertex *v2, Vertex *v3)
 {
-    mpfr::real<MPFR_BITS_PRECISION> *ax = NULL, *ay = NULL, *bx = NULL, *by = NULL, *cx = NULL, *cy = NULL, det1 = 0, det2 = 0, *det = new mpfr::real<MPFR_BITS_PRECISION>(0);
+    realNumber *ax = NULL, *ay = NULL, *bx = NULL, *by = NULL, *cx = NULL, *cy = NULL, det1 = 0, det2 = 0, *det = new realNumber(0);
     ax = &(v1->x);
     ay = &(v1->y);
     bx = &(v2->x); 
@@ -26,9 +27,9 @@ mpfr::real<MPFR_BITS_PRECISION> *Utils::orientation(Vertex *v1, Vertex *v2, Vert
     return det;
 }
 
-mpfr::real<MPFR_BITS_PRECISION> *Utils::orientation(mpfr::real<MPFR_BITS_PRECISION> &ax, mpfr::real<MPFR_BITS_PRECISION> &ay, Vertex *v2, Vertex *v3)
+realNumber *Utils::orientation(realNumber &ax, realNumber &ay, Vertex *v2, Vertex *v3)
 {
-    mpfr::real<MPFR_BITS_PRECISION> *bx = NULL, *by = NULL, *cx = NULL, *cy = NULL, *det = new mpfr::real<MPFR_BITS_PRECISION> (0);
+    realNumber *bx = NULL, *by = NULL, *cx = NULL, *cy = NULL, *det = new realNumber (0);
     bx = &(v2->x);
     by = &(v2->y);
     cx = &(v3->x);
@@ -37,66 +38,66 @@ mpfr::real<MPFR_BITS_PRECISION> *Utils::orientation(mpfr::real<MPFR_BITS_PRECISI
     return det;
 }
 
-mpfr::real<MPFR_BITS_PRECISION> *Utils::gradient(Vertex *v1, Vertex *v2)
+realNumber *Utils::gradient(Vertex *v1, Vertex *v2)
 {
-    mpfr::real<MPFR_BITS_PRECISION> *gradient = new mpfr::real<MPFR_BITS_PRECISION> (0), *distance = Utils::distance(v1, v2);  
+    realNumber *gradient = new realNumber (0), *distance = Utils::distance(v1, v2);  
     *gradient = abs(v1->u - v2->u) / (*distance);
     delete distance;
     return gradient;
 }
 
-mpfr::real<MPFR_BITS_PRECISION> *Utils::distance(Vertex *v1, Vertex *v2)
+realNumber *Utils::distance(Vertex *v1, Vertex *v2)
 {
-    mpfr::real<MPFR_BITS_PRECISION> *dist = distanceSQR(v1, v2);
+    realNumber *dist = distanceSQR(v1, v2);
     *dist = sqrt(*dist);
     return dist;
 }
 
-mpfr::real<MPFR_BITS_PRECISION> *Utils::distance(mpfr::real<MPFR_BITS_PRECISION> &px, mpfr::real<MPFR_BITS_PRECISION> &py, Vertex *v)
+realNumber *Utils::distance(realNumber &px, realNumber &py, Vertex *v)
 {
-    mpfr::real<MPFR_BITS_PRECISION> *dist = distanceSQR(px, py, v);
+    realNumber *dist = distanceSQR(px, py, v);
     *dist = sqrt(*dist);
     return dist;
 }
 
-mpfr::real<MPFR_BITS_PRECISION> *Utils::distance(mpfr::real<MPFR_BITS_PRECISION> &p1x, mpfr::real<MPFR_BITS_PRECISION> &p1y, mpfr::real<MPFR_BITS_PRECISION> &p2x, mpfr::real<MPFR_BITS_PRECISION> &p2y)
+realNumber *Utils::distance(realNumber &p1x, realNumber &p1y, realNumber &p2x, realNumber &p2y)
 {
-    mpfr::real<MPFR_BITS_PRECISION> *dist = distanceSQR(p1x, p1y, p2x, p2y);
+    realNumber *dist = distanceSQR(p1x, p1y, p2x, p2y);
     *dist = sqrt(*dist);
     return dist;
 }
 
-mpfr::real<MPFR_BITS_PRECISION> *Utils::distanceSQR(Vertex *v1, Vertex *v2)
+realNumber *Utils::distanceSQR(Vertex *v1, Vertex *v2)
 {
-    mpfr::real<MPFR_BITS_PRECISION> diffX = 0, diffY = 0, *dist = new mpfr::real<MPFR_BITS_PRECISION> (0);
+    realNumber diffX = 0, diffY = 0, *dist = new realNumber (0);
     diffX = v1->x - v2->x;
     diffY = v1->y - v2->y;
     *dist = (diffX*diffX) + (diffY*diffY);
     return dist;
 }
 
-mpfr::real<MPFR_BITS_PRECISION> *Utils::distanceSQR(mpfr::real<MPFR_BITS_PRECISION> &px, mpfr::real<MPFR_BITS_PRECISION> &py, Vertex *v)
+realNumber *Utils::distanceSQR(realNumber &px, realNumber &py, Vertex *v)
 {
-    mpfr::real<MPFR_BITS_PRECISION> diffX = 0, diffY = 0, *dist = new mpfr::real<MPFR_BITS_PRECISION> (0);
+    realNumber diffX = 0, diffY = 0, *dist = new realNumber (0);
     diffX = px - v->x;
     diffY = py - v->y;
     *dist = (diffX*diffX) + (diffY*diffY);
     return dist;
 }
 
-mpfr::real<MPFR_BITS_PRECISION> *Utils::distanceSQR(mpfr::real<MPFR_BITS_PRECISION> &p1x, mpfr::real<MPFR_BITS_PRECISION> &p1y, mpfr::real<MPFR_BITS_PRECISION> &p2x, mpfr::real<MPFR_BITS_PRECISION> &p2y)
+realNumber *Utils::distanceSQR(realNumber &p1x, realNumber &p1y, realNumber &p2x, realNumber &p2y)
 {
-    mpfr::real<MPFR_BITS_PRECISION> diffX = 0, diffY = 0, *dist = new mpfr::real<MPFR_BITS_PRECISION> (0);
+    realNumber diffX = 0, diffY = 0, *dist = new realNumber (0);
     diffX = p1x - p2x;
     diffY = p1y - p2y;
     *dist = (diffX*diffX) + (diffY*diffY);
     return dist;
 }
 
-bool Utils::inDiametralCircle(Vertex *v1, Vertex *v2, mpfr::real<MPFR_BITS_PRECISION> &px, mpfr::real<MPFR_BITS_PRECISION> &py)
+bool Utils::inDiametralCircle(Vertex *v1, Vertex *v2, realNumber &px, realNumber &py)
 {
     bool r = false;
-    mpfr::real<MPFR_BITS_PRECISION> radius = 0, centerX = 0, centerY = 0, *dist = NULL;
+    realNumber radius = 0, centerX = 0, centerY = 0, *dist = NULL;
     dist = distance(v1, v2);
     radius = (*dist)/2.0;
     centerX = (v1->x + v2->x)/2.0;
@@ -206,7 +207,7 @@ void Utils::printMatrixAB(Mesh &mesh, string outputA, string outputB, int output
     outputFileB.close();    
 }
 */
-void Utils::printVertexMovement(Vertex *v, mpfr::real<MPFR_BITS_PRECISION> &newX, mpfr::real<MPFR_BITS_PRECISION> &newY, string s) 
+void Utils::printVertexMovement(Vertex *v, realNumber &newX, realNumber &newY, string s) 
 {
     int precision = 9;
     bool printHeader = false;
@@ -251,7 +252,7 @@ void Utils::printVertexMovement(Vertex *v, mpfr::real<MPFR_BITS_PRECISION> &newX
     outputFile << endl;
 }
 
-void Utils::printLinearSystem(Vertex *firstVertex, mpfr::real<MPFR_BITS_PRECISION> *diferenceTime, string s)
+void Utils::printLinearSystem(Vertex *firstVertex, realNumber *diferenceTime, string s)
 {
    ofstream outputFile;  
    outputFile.open(s.c_str(), fstream::out);       
@@ -266,7 +267,7 @@ void Utils::printLinearSystem(Vertex *firstVertex, mpfr::real<MPFR_BITS_PRECISIO
            vector<string> listStringB;            
            std::ostringstream convert;               
            string tmp;           
-           mpfr::real<MPFR_BITS_PRECISION> *area = Utils::areaPolygon(vertexIterator);  
+           realNumber *area = Utils::areaPolygon(vertexIterator);  
            // Area / Delta t
            convert.str("");    
            convert << "(" <<std::fixed << *area << "/" << *diferenceTime << ")" ;   
@@ -377,7 +378,7 @@ void Utils::printValuesVertices(Vertex *v, string s)
     {
 //        if(v->isBorder == false) // is not at the border
 //        {
-            mpfr::real<MPFR_BITS_PRECISION> *area = NULL, x = 0, y = 0;
+            realNumber *area = NULL, x = 0, y = 0;
             float u_float = 0, previews_u_float = 0, x_float = 0, y_float = 0, area_float = 0;
             area = Utils::areaPolygon(v);
             x = v->x;
@@ -570,14 +571,17 @@ void Utils::printValuesTriangles(list<Triangle *> &l, string s)
         listValues.push_back( aux_float );  
         (*it)->cCenter[COORDINATE_Y].conv(aux_float);                                      
         listValues.push_back( aux_float );            
-        (*it)->angles[TRIANGLE_VERTEX_ONE].conv(aux_float);
-        listValues.push_back( aux_float );            
-        (*it)->angles[TRIANGLE_VERTEX_TWO].conv(aux_float);
-        listValues.push_back( aux_float );            
-        (*it)->angles[TRIANGLE_VERTEX_THREE].conv(aux_float);
-        listValues.push_back( aux_float );            
+        // Angles are not stored in the triangles, compute only to print
+        realNumber *angle = NULL;
+        for (int number = TRIANGLE_VERTEX_ONE; number <= TRIANGLE_VERTEX_THREE; number++)
+        {
+            angle = (*it)->getAngle(number);
+            angle->conv(aux_float);
+            listValues.push_back( aux_float );            
+            delete angle;
+        }
         Triangle *neighbor = (*it)->getNeighbor(TRIANGLE_VERTEX_ONE);
-        mpfr::real<MPFR_BITS_PRECISION> *distance = NULL;
+        realNumber *distance = NULL;
         float distance_float = 0;
         if (neighbor != NULL) 
         {
@@ -615,20 +619,20 @@ void Utils::printValuesTriangles(list<Triangle *> &l, string s)
     }
 }
 
-mpfr::real<MPFR_BITS_PRECISION> *Utils::getDiferenceGradient(list<Adjacency *> &l)
+realNumber *Utils::getDiferenceGradient(list<Adjacency *> &l)
 {
-    mpfr::real<MPFR_BITS_PRECISION> smallestGradient = mpfr::inf<MPFR_BITS_PRECISION, MPFR_RNDN>(+1), biggerGradient = mpfr::inf<MPFR_BITS_PRECISION, MPFR_RNDN>(-1), *diference = new mpfr::real<MPFR_BITS_PRECISION> (0);     
+    realNumber smallestGradient = realNumberInfinity(+1), biggerGradient = realNumberInfinity(-1), *diference = new realNumber (0);     
     bool existInternalAdj = false;
     for(list<Adjacency *>::iterator it = l.begin(); it != l.end(); it++)
     {
 	
-        mpfr::real<MPFR_BITS_PRECISION> *gradient = NULL;
+        realNumber *gradient = NULL;
         if ( !(*it)->getVertex(ADJ_VERTEX_ONE)->isBorder && !(*it)->getVertex(ADJ_VERTEX_TWO)->isBorder )
         {
 	    existInternalAdj = true;
 	    gradient = Utils::gradient((*it)->getVertex(ADJ_VERTEX_ONE), (*it)->getVertex(ADJ_VERTEX_TWO));            	
 	    // Necessary initial value of gradient in case all vertices be internals           
-	    if ( (biggerGradient == mpfr::inf<MPFR_BITS_PRECISION, MPFR_RNDN>(-1)) || ( smallestGradient == mpfr::inf<MPFR_BITS_PRECISION, MPFR_RNDN>(+1)) )   
+	    if ( (biggerGradient == realNumberInfinity(-1)) || ( smallestGradient == realNumberInfinity(+1)) )   
 	    {		
 		biggerGradient   = *gradient;
 		smallestGradient = *gradient;
@@ -651,12 +655,12 @@ mpfr::real<MPFR_BITS_PRECISION> *Utils::getDiferenceGradient(list<Adjacency *> &
     return diference;
 }
 
-mpfr::real<MPFR_BITS_PRECISION> *Utils::getSmallestGradient(list<Triangle *> &l)
+realNumber *Utils::getSmallestGradient(list<Triangle *> &l)
 {
-    mpfr::real<MPFR_BITS_PRECISION> *smallestGradient = new mpfr::real<MPFR_BITS_PRECISION>(0);
+    realNumber *smallestGradient = new realNumber(0);
     for(list<Triangle *>::iterator it = l.begin(); it != l.end(); it++)
     {        
-        mpfr::real<MPFR_BITS_PRECISION> *gradient = NULL;
+        realNumber *gradient = NULL;
         gradient = Utils::gradient((*it)->getVertex(TRIANGLE_VERTEX_ONE), (*it)->getVertex(TRIANGLE_VERTEX_TWO));
         if (*smallestGradient == 0) {
             *smallestGradient = *gradient;
@@ -678,13 +682,13 @@ mpfr::real<MPFR_BITS_PRECISION> *Utils::getSmallestGradient(list<Triangle *> &l)
     return smallestGradient;
 }
 
-mpfr::real<MPFR_BITS_PRECISION> *Utils::getSmallestGradient(list<Adjacency *> &l)
+realNumber *Utils::getSmallestGradient(list<Adjacency *> &l)
 {
-    mpfr::real<MPFR_BITS_PRECISION> *smallestGradient = NULL;
+    realNumber *smallestGradient = NULL;
     list<Adjacency *>::iterator it;
     for(it = l.begin(); it != l.end(); it++)
     {        
-        mpfr::real<MPFR_BITS_PRECISION> *gradient = NULL;
+        realNumber *gradient = NULL;
 	if ( ( !(*it)->getVertex(ADJ_VERTEX_ONE)->isBorder) && ( !(*it)->getVertex(ADJ_VERTEX_ONE)->isBorder) )  
 	{
 	    gradient = Utils::gradient((*it)->getVertex(ADJ_VERTEX_ONE), (*it)->getVertex(ADJ_VERTEX_TWO));
@@ -697,13 +701,13 @@ mpfr::real<MPFR_BITS_PRECISION> *Utils::getSmallestGradient(list<Adjacency *> &l
     return smallestGradient;
 }
 
-mpfr::real<MPFR_BITS_PRECISION> *Utils::getBiggerGradient(list<Triangle *> &l)
+realNumber *Utils::getBiggerGradient(list<Triangle *> &l)
 {
-    mpfr::real<MPFR_BITS_PRECISION> *biggerGradient = new mpfr::real<MPFR_BITS_PRECISION>(0);
+    realNumber *biggerGradient = new realNumber(0);
     list<Triangle *>::iterator it;
     for(it = l.begin(); it != l.end(); it++)
     {        
-        mpfr::real<MPFR_BITS_PRECISION> *gradient = NULL;
+        realNumber *gradient = NULL;
         gradient = Utils::gradient((*it)->getVertex(TRIANGLE_VERTEX_ONE), (*it)->getVertex(TRIANGLE_VERTEX_TWO));
         if (*biggerGradient == 0) {
             *biggerGradient = *gradient;
@@ -725,13 +729,13 @@ mpfr::real<MPFR_BITS_PRECISION> *Utils::getBiggerGradient(list<Triangle *> &l)
     return biggerGradient;
 }
 
-mpfr::real<MPFR_BITS_PRECISION> *Utils::getBiggerGradient(list<Adjacency *> &l)
+realNumber *Utils::getBiggerGradient(list<Adjacency *> &l)
 {
-    mpfr::real<MPFR_BITS_PRECISION> *biggerGradient = new mpfr::real<MPFR_BITS_PRECISION>(0);
+    realNumber *biggerGradient = new realNumber(0);
     list<Adjacency *>::iterator it;
     for(it = l.begin(); it != l.end(); it++)
     {        
-        mpfr::real<MPFR_BITS_PRECISION> *gradient = NULL;
+        realNumber *gradient = NULL;
 	if ( ( !(*it)->getVertex(ADJ_VERTEX_ONE)->isBorder) && ( !(*it)->getVertex(ADJ_VERTEX_ONE)->isBorder) )  
 	{
 	    gradient = Utils::gradient((*it)->getVertex(ADJ_VERTEX_ONE), (*it)->getVertex(ADJ_VERTEX_TWO));
@@ -746,14 +750,14 @@ mpfr::real<MPFR_BITS_PRECISION> *Utils::getBiggerGradient(list<Adjacency *> &l)
     return biggerGradient;
 }
 
-mpfr::real<MPFR_BITS_PRECISION> *Utils::getMediaGradient(list<Adjacency *> &l)
+realNumber *Utils::getMediaGradient(list<Adjacency *> &l)
 {
-    mpfr::real<MPFR_BITS_PRECISION> *mediaGradient = new mpfr::real<MPFR_BITS_PRECISION>(0);
+    realNumber *mediaGradient = new realNumber(0);
     int numEdges = 0;
     list<Adjacency *>::iterator it;
     for(it = l.begin(); it != l.end(); it++)
     {        
-        mpfr::real<MPFR_BITS_PRECISION> *gradient = NULL;
+        realNumber *gradient = NULL;
 	if ( ( !(*it)->getVertex(ADJ_VERTEX_ONE)->isBorder) && ( !(*it)->getVertex(ADJ_VERTEX_ONE)->isBorder) )  
 	{
 	    gradient = Utils::gradient((*it)->getVertex(ADJ_VERTEX_ONE), (*it)->getVertex(ADJ_VERTEX_TWO));
@@ -768,13 +772,13 @@ mpfr::real<MPFR_BITS_PRECISION> *Utils::getMediaGradient(list<Adjacency *> &l)
 
 float *Utils::getGradients(list<Adjacency *> &l)
 {
-    mpfr::real<MPFR_BITS_PRECISION> mediaGradient = 0, lowerGradient = 1e100, higherGradient = 0;
+    realNumber mediaGradient = 0, lowerGradient = 1e100, higherGradient = 0;
     float *gradientsData = new float[3], tmpFloat = 0;
     int numEdges = 0;
     list<Adjacency *>::iterator it;
     for(it = l.begin(); it != l.end(); it++)
     {        
-        mpfr::real<MPFR_BITS_PRECISION> *gradient = NULL;
+        realNumber *gradient = NULL;
 	if ( ( !(*it)->getVertex(ADJ_VERTEX_ONE)->isBorder) && ( !(*it)->getVertex(ADJ_VERTEX_ONE)->isBorder) )  
 	{
 	    gradient = Utils::gradient((*it)->getVertex(ADJ_VERTEX_ONE), (*it)->getVertex(ADJ_VERTEX_TWO));
@@ -796,13 +800,13 @@ float *Utils::getGradients(list<Adjacency *> &l)
     gradientsData[2] = tmpFloat;     
     return gradientsData;
 }
-mpfr::real<MPFR_BITS_PRECISION> *Utils::getBiggerDistance(list<Triangle *> &l)
+realNumber *Utils::getBiggerDistance(list<Triangle *> &l)
 {
-    mpfr::real<MPFR_BITS_PRECISION> *biggerDistance = new mpfr::real<MPFR_BITS_PRECISION>(0);
+    realNumber *biggerDistance = new realNumber(0);
     list<Triangle *>::iterator it;
     for(it = l.begin(); it != l.end(); it++)
     {        
-        mpfr::real<MPFR_BITS_PRECISION> *distance = NULL;
+        realNumber *distance = NULL;
         distance = Utils::distance((*it)->getVertex(TRIANGLE_VERTEX_ONE), (*it)->getVertex(TRIANGLE_VERTEX_TWO));
         if (*biggerDistance == 0) {
             *biggerDistance = *distance;
@@ -824,16 +828,16 @@ mpfr::real<MPFR_BITS_PRECISION> *Utils::getBiggerDistance(list<Triangle *> &l)
     return biggerDistance;
 }
 
-mpfr::real<MPFR_BITS_PRECISION> *Utils::areaPolygon(Vertex *v)
+realNumber *Utils::areaPolygon(Vertex *v)
 {
     list<Triangle * > listTriangles; // listTriangles: list of triangles that share a vertex.
-    list<mpfr::real<MPFR_BITS_PRECISION> *> listVertices; // listVertices: list of vertices coordinates of polygon
-    mpfr::real<MPFR_BITS_PRECISION> *area = NULL;
+    list<realNumber *> listVertices; // listVertices: list of vertices coordinates of polygon
+    realNumber *area = NULL;
     getTrianglesWithVertex(listTriangles, v);    
     getCcentersTriangles(listVertices, listTriangles);
     area = areaVertices(listVertices);      
     listTriangles.clear();
-    for(list<mpfr::real<MPFR_BITS_PRECISION> *>::iterator it = listVertices.begin(); it != listVertices.end(); it++)
+    for(list<realNumber *>::iterator it = listVertices.begin(); it != listVertices.end(); it++)
     {
         delete[] *it;
     }    
@@ -878,11 +882,11 @@ void Utils::getTrianglesWithVertex(list<Triangle *> &listTriangles, Vertex *v)
     }           
 }
 
-mpfr::real<MPFR_BITS_PRECISION> *Utils::areaVertices(list<mpfr::real<MPFR_BITS_PRECISION> *> &listVertices) 
+realNumber *Utils::areaVertices(list<realNumber *> &listVertices) 
 {   
-    mpfr::real<MPFR_BITS_PRECISION> *area = new mpfr::real<MPFR_BITS_PRECISION> (0);
-    mpfr::real<MPFR_BITS_PRECISION> *v = NULL, *vPrevious = NULL;
-    list<mpfr::real<MPFR_BITS_PRECISION> *>::iterator it;        
+    realNumber *area = new realNumber (0);
+    realNumber *v = NULL, *vPrevious = NULL;
+    list<realNumber *>::iterator it;        
     vPrevious = listVertices.back();    
     for(it = listVertices.begin(); it != listVertices.end(); it++)
     {
@@ -894,20 +898,20 @@ mpfr::real<MPFR_BITS_PRECISION> *Utils::areaVertices(list<mpfr::real<MPFR_BITS_P
     return area;
 }
 
-void Utils::getCcentersTriangles(list<mpfr::real<MPFR_BITS_PRECISION> *> &listCcenters, list<Triangle *> &listTriangles) 
+void Utils::getCcentersTriangles(list<realNumber *> &listCcenters, list<Triangle *> &listTriangles) 
 {    
     for(list<Triangle *>::iterator it = listTriangles.begin(); it != listTriangles.end(); it++)
     {
-        mpfr::real<MPFR_BITS_PRECISION> *coordinates = new mpfr::real<MPFR_BITS_PRECISION>[2];
+        realNumber *coordinates = new realNumber[2];
         coordinates[COORDINATE_X] = (*it)->cCenter[COORDINATE_X];
         coordinates[COORDINATE_Y] = (*it)->cCenter[COORDINATE_Y];
         listCcenters.push_back( coordinates );
     }
 }
 
-mpfr::real<MPFR_BITS_PRECISION> *Utils::getBiggerAreaPolygon(Vertex *v) 
+realNumber *Utils::getBiggerAreaPolygon(Vertex *v) 
 {    
-    mpfr::real<MPFR_BITS_PRECISION> *area = NULL, *biggerArea = NULL;       
+    realNumber *area = NULL, *biggerArea = NULL;       
     biggerArea = Utils::areaPolygon(v);
     v = (*v).next;    
     while (v != NULL) 
@@ -926,9 +930,9 @@ mpfr::real<MPFR_BITS_PRECISION> *Utils::getBiggerAreaPolygon(Vertex *v)
     return biggerArea;
 }
 
-mpfr::real<MPFR_BITS_PRECISION> *Utils::getSmallestAreaPolygon(Vertex *v) 
+realNumber *Utils::getSmallestAreaPolygon(Vertex *v) 
 {    
-    mpfr::real<MPFR_BITS_PRECISION> *area = NULL, *smallestArea = NULL;    
+    realNumber *area = NULL, *smallestArea = NULL;    
     if ( (*v).isBorder == false ) 
     { 
         smallestArea = Utils::areaPolygon(v); 
@@ -950,9 +954,9 @@ mpfr::real<MPFR_BITS_PRECISION> *Utils::getSmallestAreaPolygon(Vertex *v)
     return smallestArea;
 }
 
-mpfr::real<MPFR_BITS_PRECISION> *Utils::distanceCircuncenterTrianglesShareInterface( Vertex *v1, Vertex *v2 )
+realNumber *Utils::distanceCircuncenterTrianglesShareInterface( Vertex *v1, Vertex *v2 )
 {
-    mpfr::real<MPFR_BITS_PRECISION> *distanceCircuncenterTrianglesShareInterface = new mpfr::real<MPFR_BITS_PRECISION> (0);
+    realNumber *distanceCircuncenterTrianglesShareInterface = new realNumber (0);
     Adjacency *adj = v1->getAdjacency(v2); // Get the Adjacency with vertex v1 and v2. 
     Triangle *c1 = adj->getTriangle(ADJ_TRIANGLE_ONE);
     Triangle *c2 = adj->getTriangle(ADJ_TRIANGLE_TWO);  
@@ -982,8 +986,8 @@ void Utils::finiteVolumeLaplaceEquation(Vertex *firstVertex)
 
                 if( adjVertex->isBorder ) // If the adjacent vertex is a border vertex
                 {
-                    mpfr::real<MPFR_BITS_PRECISION> *distance = Utils::distance(vertexIterator, adjVertex),
-                                                    *distanceInterfaceDivDistanceVertices = Utils::distanceCircuncenterTrianglesShareInterface(vertexIterator, adjVertex) ;   
+                    realNumber *distance = Utils::distance(vertexIterator, adjVertex),
+                               *distanceInterfaceDivDistanceVertices = Utils::distanceCircuncenterTrianglesShareInterface(vertexIterator, adjVertex) ;   
                     *distanceInterfaceDivDistanceVertices = (*distanceInterfaceDivDistanceVertices) / (*distance);
                     delete distance;
                     // Updates vertex p
@@ -997,8 +1001,8 @@ void Utils::finiteVolumeLaplaceEquation(Vertex *firstVertex)
                     if(adjVertex == vertexIterator) // If true, get next vertice of edge
                         adjVertex = (*it)->getVertex(ADJ_VERTEX_TWO);
                     // Distance of circuncenter of triangles which shared edge (p, adjVertex) / Distance of p to adjVertex
-                    mpfr::real<MPFR_BITS_PRECISION> *distance = Utils::distance(vertexIterator, adjVertex),
-                                                    *distanceInterfaceDivDistanceVertices = Utils::distanceCircuncenterTrianglesShareInterface(vertexIterator, adjVertex) ;   
+                    realNumber *distance = Utils::distance(vertexIterator, adjVertex),
+                               *distanceInterfaceDivDistanceVertices = Utils::distanceCircuncenterTrianglesShareInterface(vertexIterator, adjVertex) ;   
                     *distanceInterfaceDivDistanceVertices = (*distanceInterfaceDivDistanceVertices) / (*distance);
                     delete distance;                    
                     // Updates vertex p
@@ -1021,143 +1025,150 @@ bool Utils::compare(Vertex *first, Vertex *second)
         return false;
 }
 
-void Utils::findPseudoPeripheral(Mesh &mesh)
-{    
-    queue<Vertex *> visitationOrder;
-    Vertex *rootVertex    = mesh.first;
-    Vertex *leafVertex    = NULL; // Vertex PseudoPeripheral
-    Vertex *vertexIterator = mesh.first;   
-    bool hasFindedleafVertex = true;
-    unsigned int lowerValency = 1e3;    
-    //rootVertex->eccentricity = 1;                
-    while( hasFindedleafVertex )
-    {     
-        vertexIterator = rootVertex;
-        hasFindedleafVertex = false;         
-        /** Construir a estrutura de nivel do vertice raiz rootVertex */
-        while(vertexIterator != NULL)                      
+void Utils::getInternalGraph(Mesh &mesh, vector<Vertex *> &vertices, vector<int> &rowStart, vector<int> &neighbor)
+{
+    vertices.clear();
+    neighbor.clear();
+    for (Vertex *vertexIterator = mesh.first; vertexIterator != NULL; vertexIterator = vertexIterator->next)
+    {
+        if (!vertexIterator->isBorder)
         {
-            if(!vertexIterator->isBorder)  
-            {
-                if(vertexIterator->visited == false)
-                {
-                    vertexIterator->visited = true;
-                    rootVertex = vertexIterator;
-                    leafVertex = vertexIterator;
-                }
-                bool hasUpdatedLevelStructureEccentricity = false;                                
-                for(list<Adjacency *>::iterator it = vertexIterator->adjList.begin(); it != vertexIterator->adjList.end(); it++)  
-                {
-                    Vertex *adjVertex = (*it)->getVertex(ADJ_VERTEX_ONE);
-                    if(!adjVertex->isBorder)
-                    {        
-                        if(adjVertex == vertexIterator)
-                            adjVertex = (*it)->getVertex(ADJ_VERTEX_TWO);
-                        if(!adjVertex->isBorder)
-                        {
-                            if(!adjVertex->visited)
-                            {
-                                visitationOrder.push(adjVertex); // Guarda aos vertices adjacentes para visitar em seguida
-                                adjVertex->visited = true;
-                                hasUpdatedLevelStructureEccentricity = true;
-                                adjVertex->levelStructure =  vertexIterator->levelStructure + 1; // Atualiza estrutura de nivel
-                                rootVertex->eccentricity = adjVertex->levelStructure; // Atualiza excentricidade do noh raiz
-                            } 
-                        }
-                    }
-                }
-                // Verifica vertice com maior excentricidade e menor grau: Se currentVertex->excentricidade > rootVertex->excentricidade                
-                if( (vertexIterator->levelStructure >= rootVertex->eccentricity) && 
-                    (vertexIterator->incList.size() < lowerValency) )
-                {
-                    lowerValency = vertexIterator->incList.size();
-                    leafVertex = vertexIterator; // Noh folha: vertice com maior excentricidade e menor grau                 
-                    hasFindedleafVertex= true;
-                    //rootVertex->eccentricity = largestStructure;
-                }
-                if ( hasUpdatedLevelStructureEccentricity )
-                {
-                    vertexIterator = visitationOrder.front(); // Visita primeiro os vertices adjacentes
-                    visitationOrder.pop();
-                    hasUpdatedLevelStructureEccentricity = false;
-                } else if(!visitationOrder.empty())
-                {
-                    vertexIterator = visitationOrder.front(); // Visita primeiro os vertices adjacentes
-                    visitationOrder.pop();
-                } else
-                    vertexIterator = vertexIterator->next;
-            } else
-                vertexIterator = vertexIterator->next;
-        } /** Fim while: Construiu a estrutura de nivel do vertice raiz rootVertex */                
-        if (!visitationOrder.empty())  { 
-            cerr << "ERROR - Utils::findPseudoPeripheral - visitationOrder not empty" << endl;
-            exit(EXIT_FAILURE);  
+            vertexIterator->levelStructure = (int) vertices.size();
+            vertices.push_back(vertexIterator);
+        }
+    }
+    int n = (int) vertices.size();
+    rowStart.assign(n + 1, 0);
+    for (int i = 0; i < n; i++)
+    {
+        for (list<Adjacency *>::iterator it = vertices[i]->adjList.begin(); it != vertices[i]->adjList.end(); it++)  
+        {
+            Vertex *adjVertex = (*it)->getVertex(ADJ_VERTEX_ONE);
+            if (adjVertex == vertices[i])
+                adjVertex = (*it)->getVertex(ADJ_VERTEX_TWO);
+            if (!adjVertex->isBorder)
+                neighbor.push_back(adjVertex->levelStructure);
+        }
+        rowStart[i + 1] = (int) neighbor.size();
+    }
+}
+
+void Utils::getOrderingStatistics(Mesh &mesh, int bytesPerValue, long &bandwidth, long &profile, double &averageDistance, long &cacheLines)
+{
+    vector<Vertex *> vertices;
+    vector<int> rowStart, neighbor;
+    getInternalGraph(mesh, vertices, rowStart, neighbor);
+    bandwidth = 0;
+    profile = 0;
+    averageDistance = 0;
+    cacheLines = 0;
+    double sumDistance = 0;
+    for (int i = 0; i < (int) vertices.size(); i++)
+    {
+        int firstColumn = i;
+        for (int k = rowStart[i]; k < rowStart[i + 1]; k++)
+        {
+            if (neighbor[k] < firstColumn)
+                firstColumn = neighbor[k];
+            if (abs(i - neighbor[k]) > bandwidth)
+                bandwidth = abs(i - neighbor[k]);
+            sumDistance += abs(i - neighbor[k]);
         }
-        vertexIterator = mesh.first;
-        int labelAux = 0;      
-        // Se encontrou vertice pseudo-periferico, reinicializa atributos visited e levelStructure e insere o vertice pseudo-periferico como primerio da lista de vertices
-        if( hasFindedleafVertex )
-        {       
-            while(vertexIterator != NULL)
+        profile += i - firstColumn;
+    }
+    if (!neighbor.empty())
+        averageDistance = sumDistance / neighbor.size();
+    if (bytesPerValue <= 0)
+        return;
+    // Least recently used cache of the lines of the vector
+    size_t capacity = MESH_ORDERING_CACHE_BYTES / MESH_ORDERING_CACHE_LINE_BYTES;
+    list<long> recentLines;
+    map<long, list<long>::iterator> position;
+    for (int i = 0; i < (int) vertices.size(); i++)
+    {
+        for (int k = rowStart[i] - 1; k < rowStart[i + 1]; k++)
+        {
+            long line = (long) ( (k < rowStart[i]) ? i : neighbor[k] ) * bytesPerValue / MESH_ORDERING_CACHE_LINE_BYTES;
+            map<long, list<long>::iterator>::iterator it = position.find(line);
+            if (it != position.end())
+                recentLines.splice(recentLines.begin(), recentLines, it->second);
+            else
             {
-                if(!vertexIterator->isBorder)
+                cacheLines++;
+                recentLines.push_front(line);
+                position[line] = recentLines.begin();
+                if (recentLines.size() > capacity)
                 {
-                    // Marca todos os vertices internos como nao-visitados e estrutura de nivel = 0
-                    vertexIterator->visited = false;
-                    vertexIterator->levelStructure = 0;
+                    position.erase(recentLines.back());
+                    recentLines.pop_back();
                 }
-                // Troca o label e inverte posicao do noh raiz com o noh folha (vertice com maior excentricidade e menor grau)
-                if(vertexIterator == rootVertex)
-                {
-                    labelAux = leafVertex->label;
-                    leafVertex->label = rootVertex->label;
-                    visitationOrder.push(leafVertex);
-                } else if(vertexIterator == leafVertex)
-                {
-                    rootVertex->label = labelAux;
-                    visitationOrder.push(rootVertex);
-                } else {
-                    visitationOrder.push(vertexIterator);
-                }
-                vertexIterator = vertexIterator->next;
             }
-            // Gera a fila com base na ordem de visita armazenada na lista
-            mesh.first = NULL;
-            mesh.last = NULL;
-            while( !visitationOrder.empty() )
-            {
-                if(mesh.first == NULL)
-                {
-                    mesh.first = visitationOrder.front();
-                    mesh.last = visitationOrder.front();
-                    mesh.last->next = 0;
-                }
-                else // Insere no fim da fila
-                {
-                    mesh.last->next = visitationOrder.front();
-                    mesh.last = visitationOrder.front();
-                    mesh.last->next = NULL;
-                }
-                visitationOrder.pop();
-            }            
-        } else { // Reinicializa os atributos visited e levelStructure
-            while(vertexIterator != NULL)
+        }
+    }
+}
+
+Vertex *Utils::findPseudoPeripheral(Mesh &mesh)
+{    
+    // Indexed graph of the internal vertices
+    vector<Vertex *> vertices;
+    vector<int> rowStart, neighbor;
+    getInternalGraph(mesh, vertices, rowStart, neighbor);
+    if (vertices.empty())
+        return NULL;
+    int n = (int) vertices.size();
+    // George and Liu: root at the vertex of minimum degree of the last level while the eccentricity grows
+    vector<int> level, order;
+    int root = 0, eccentricity = rootedLevelStructure(rowStart, neighbor, root, level, order);
+    while (true)
+    {
+        int candidate = -1;
+        for (int k = (int) order.size() - 1; k >= 0 && level[order[k]] == eccentricity; k--)
+        {
+            int v = order[k];
+            if ( (candidate < 0) || (rowStart[v + 1] - rowStart[v] < rowStart[candidate + 1] - rowStart[candidate]) )
+                candidate = v;
+        }
+        vector<int> candidateLevel, candidateOrder;
+        int candidateEccentricity = rootedLevelStructure(rowStart, neighbor, candidate, candidateLevel, candidateOrder);
+        if (candidateEccentricity <= eccentricity)
+            break;
+        root = candidate;
+        eccentricity = candidateEccentricity;
+        level.swap(candidateLevel);
+        order.swap(candidateOrder);
+    }
+    for (int i = 0; i < n; i++)
+        vertices[i]->levelStructure = (level[i] >= 0) ? level[i] : 0;
+    vertices[root]->eccentricity = eccentricity;
+    return vertices[root];
+}
+
+int Utils::rootedLevelStructure(const vector<int> &rowStart, const vector<int> &neighbor, int root, vector<int> &level, vector<int> &order)
+{
+    int n = (int) rowStart.size() - 1;
+    level.assign(n, -1);
+    order.clear();
+    order.reserve(n);
+    level[root] = 0;
+    order.push_back(root);
+    for (size_t head = 0; head < order.size(); head++) // order is the queue of the search
+    {
+        int v = order[head];
+        for (int k = rowStart[v]; k < rowStart[v + 1]; k++)
+        {
+            if (level[neighbor[k]] < 0)
             {
-                if(vertexIterator->isBorder == false)
-                {
-                    vertexIterator->visited = false;
-                    vertexIterator->levelStructure = 0;
-                } 
-                vertexIterator = vertexIterator->next;
+                level[neighbor[k]] = level[v] + 1;
+                order.push_back(neighbor[k]);
             }
         }
-        rootVertex = leafVertex;
-    } /* Fim while( hasFindedHigherEccentricityLowerValency )*/ 
+    }
+    return level[order.back()];
 }
 
-mpfr::real<MPFR_BITS_PRECISION> *Utils::circunradiusToShortestEdgeRatioMesh(Mesh &m)
+realNumber *Utils::circunradiusToShortestEdgeRatioMesh(Mesh &m)
 { 
-    mpfr::real<MPFR_BITS_PRECISION> *maxCER = new mpfr::real<MPFR_BITS_PRECISION> (0);
+    realNumber *maxCER = new realNumber (0);
     for(list<Triangle *>::iterator it = m.triangleList.begin(); it != m.triangleList.end(); it++)  
     {    
         if ( (*it)->radiusEdgeRatio > *maxCER )
@@ -1166,9 +1177,9 @@ mpfr::real<MPFR_BITS_PRECISION> *Utils::circunradiusToShortestEdgeRatioMesh(Mesh
     return maxCER;
 }
 
-mpfr::real<MPFR_BITS_PRECISION> *Utils::shapeRegularityQualityMesh(Mesh &m)
+realNumber *Utils::shapeRegularityQualityMesh(Mesh &m)
 {   
-    mpfr::real<MPFR_BITS_PRECISION> *SRQ = NULL, *minSQR = NULL;
+    realNumber *SRQ = NULL, *minSQR = NULL;
     for(list<Triangle *>::iterator it = m.triangleList.begin(); it != m.triangleList.end(); it++)  
     {    
         SRQ = Utils::shapeRegularityQuality(*it);
@@ -1182,9 +1193,9 @@ mpfr::real<MPFR_BITS_PRECISION> *Utils::shapeRegularityQualityMesh(Mesh &m)
     return minSQR;
 }
 
-mpfr::real<MPFR_BITS_PRECISION> *Utils::shapeRegularityQuality(Triangle *triangle)
+realNumber *Utils::shapeRegularityQuality(Triangle *triangle)
 { 
-    mpfr::real<MPFR_BITS_PRECISION> *quality = new mpfr::real<MPFR_BITS_PRECISION>(0), *l1 = NULL, *l2 = NULL, *l3 = NULL, t = 0;
+    realNumber *quality = new realNumber(0), *l1 = NULL, *l2 = NULL, *l3 = NULL, t = 0;
     // Counter Clockwise t < 0; Clockwise t > 0;
     Vertex *v1 = triangle->getVertex(TRIANGLE_VERTEX_ONE);
     Vertex *v2 = triangle->getVertex(TRIANGLE_VERTEX_TWO);
@@ -1200,10 +1211,10 @@ mpfr::real<MPFR_BITS_PRECISION> *Utils::shapeRegularityQuality(Triangle *triangl
     return quality;
 }
 
-float *Utils::getInformationQualityMesh(Mesh *m,  mpfr::real<MPFR_BITS_PRECISION> &toleranceCER, mpfr::real<MPFR_BITS_PRECISION> &toleranceSRQ)
+float *Utils::getInformationQualityMesh(Mesh *m,  realNumber &toleranceCER, realNumber &toleranceSRQ)
 {
     float *dataQuality = new float[4], tmpFloat;
-    mpfr::real<MPFR_BITS_PRECISION> *maxCER = new mpfr::real<MPFR_BITS_PRECISION> (0), *SRQ = NULL, *minSRQ = NULL, percentage = 0;
+    realNumber *maxCER = new realNumber (0), *SRQ = NULL, *minSRQ = NULL, percentage = 0;
     int countCER = 0, countSRQ = 0, totalTriangles = 0;
     for(list<Triangle *>::iterator it = m->triangleList.begin(); it != m->triangleList.end(); it++)  
     {    
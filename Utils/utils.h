@@ -1,6 +1,7 @@
 #ifndef UTILS_H_INCLUDED
 #define UTILS_H_INCLUDED
 #include <list>
+#include <vector>
 #include "../Vertex/vertex.h"
 #include <fstream> // file stream
 using namespace std;
@@ -36,7 +37,7 @@ public:
      * @param v3
      * @return 0 if counter-clockwise. <0 if clockwise. 0 if collinear. 
      */    
-    static mpfr::real<MPFR_BITS_PRECISION> *orientation(Vertex *v1, Vertex *v2, Vertex *v3);
+    static realNumber *orientation(Vertex *v1, Vertex *v2, Vertex *v3);
     /**
      * Calculate the orientation of vertices of a triangle.
      * @param ax
@@ -45,21 +46,21 @@ public:
      * @param v3
      * @return >0 if counter-clockwise. <0 if clockwise. 0 if collinear. 
      */
-    static mpfr::real<MPFR_BITS_PRECISION> *orientation(mpfr::real<MPFR_BITS_PRECISION> &ax, mpfr::real<MPFR_BITS_PRECISION> &ay, Vertex *v2, Vertex *v3);
+    static realNumber *orientation(realNumber &ax, realNumber &ay, Vertex *v2, Vertex *v3);
     /**
      * Calculate the gradient between v1 and v2.
      * @param v1
      * @param v2
      * @return gradient between v1 and v2.
      */
-    static mpfr::real<MPFR_BITS_PRECISION> *gradient(Vertex *v1, Vertex *v2);
+    static realNumber *gradient(Vertex *v1, Vertex *v2);
     /**
      * Calculate the distance between v1 and v2. 
      * @param v1
      * @param v2
      * @return 
      */
-    static mpfr::real<MPFR_BITS_PRECISION> *distance(Vertex *v1, Vertex *v2);    
+    static realNumber *distance(Vertex *v1, Vertex *v2);    
     /**
      * Calculate the distance between the point (px, py) and v.
      * @param px
@@ -68,7 +69,7 @@ public:
      * @return distance between the point.
      */
     
-    static mpfr::real<MPFR_BITS_PRECISION> *distance(mpfr::real<MPFR_BITS_PRECISION> &px, mpfr::real<MPFR_BITS_PRECISION> &py, Vertex *v);
+    static realNumber *distance(realNumber &px, realNumber &py, Vertex *v);
     /**
      * Calculate the distance between the point (p1x, p1y) and the point (p2x, p2y).
      * @param p1x
@@ -77,14 +78,14 @@ public:
      * @param p2y
      * @return distance between two points.
      */
-    static mpfr::real<MPFR_BITS_PRECISION> *distance(mpfr::real<MPFR_BITS_PRECISION> &p1x, mpfr::real<MPFR_BITS_PRECISION> &p1y, mpfr::real<MPFR_BITS_PRECISION> &p2x, mpfr::real<MPFR_BITS_PRECISION> &p2y);
+    static realNumber *distance(realNumber &p1x, realNumber &p1y, realNumber &p2x, realNumber &p2y);
     /**
      * Calculate the square of the distance between v1 and v2.
      * @param v1
      * @param v2
      * @return square of the distance.
      */
-    static mpfr::real<MPFR_BITS_PRECISION> *distanceSQR(Vertex *v1, Vertex *v2);
+    static realNumber *distanceSQR(Vertex *v1, Vertex *v2);
     /**
      * Calculate the square of the distance between the point (px, py) and v.
      * @param px
@@ -92,7 +93,7 @@ public:
      * @param v
      * @return square of the distance.
      */
-    static mpfr::real<MPFR_BITS_PRECISION> *distanceSQR(mpfr::real<MPFR_BITS_PRECISION> &px, mpfr::real<MPFR_BITS_PRECISION> &py, Vertex *v);
+    static realNumber *distanceSQR(realNumber &px, realNumber &py, Vertex *v);
     /**
      * Calculate the square of the distance between the point (p1x, p1y) and the point (p2x, p2y).
      * @param p1x
@@ -101,7 +102,7 @@ public:
      * @param p2y
      * @return square of the distance.
      */
-    static mpfr::real<MPFR_BITS_PRECISION> *distanceSQR(mpfr::real<MPFR_BITS_PRECISION> &p1x, mpfr::real<MPFR_BITS_PRECISION> &p1y, mpfr::real<MPFR_BITS_PRECISION> &p2x, mpfr::real<MPFR_BITS_PRECISION> &p2y);
+    static realNumber *distanceSQR(realNumber &p1x, realNumber &p1y, realNumber &p2x, realNumber &p2y);
     /**
      * Checks if the point (px,py) is inside (not on) the diametral circle of
        the edge with endpoints v1 and v2.
@@ -112,49 +113,49 @@ public:
      * @return true if the point (px,py) is inside (not on) the diametral circle of
        the edge with endpoints v1 and v2; returns false, otherwise.
      */
-    static bool inDiametralCircle(Vertex *v1, Vertex *v2, mpfr::real<MPFR_BITS_PRECISION> &px, mpfr::real<MPFR_BITS_PRECISION> &py);
+    static bool inDiametralCircle(Vertex *v1, Vertex *v2, realNumber &px, realNumber &py);
     /**
      * Get the value of the smaller and bigtger gradient in the list of triangles.
      * @param l list of adjacencies.
      * @return gradient_max - gradient_min
      */    
-    static mpfr::real<MPFR_BITS_PRECISION> *getDiferenceGradient(list<Adjacency *> &l);    
+    static realNumber *getDiferenceGradient(list<Adjacency *> &l);    
     /**
      * Get the value of the smaller gradient in the list of triangles.
      * @param l list of triangles.
      * @return lower value of gradient on mesh
      */
-    static mpfr::real<MPFR_BITS_PRECISION> *getSmallestGradient(list<Triangle *> &l);
+    static realNumber *getSmallestGradient(list<Triangle *> &l);
     /**
      * Get the value of the smaller gradient in the list of edges.
      * @param l list of adjacencies.
      * @return lower value of gradient on mesh
      */    
-    static mpfr::real<MPFR_BITS_PRECISION> *getSmallestGradient(list<Adjacency *> &l);
+    static realNumber *getSmallestGradient(list<Adjacency *> &l);
     /**
      * Get the value of the bigger gradient in the list of triangles.
      * @param l list of triangles.
      * @return higher value of gradient on mesh
      */
-    static mpfr::real<MPFR_BITS_PRECISION> *getBiggerGradient(list<Triangle *> &l);    
+    static realNumber *getBiggerGradient(list<Triangle *> &l);    
     /**
      * Get the value of the bigger gradient in the list of edges.
      * @param l list of adjacencies.
      * @return higher value of gradient on mesh
      */    
-    static mpfr::real<MPFR_BITS_PRECISION> *getBiggerGradient(list<Adjacency *> &l);    
+    static realNumber *getBiggerGradient(list<Adjacency *> &l);    
     /**
      * Get the value of the media of gradients in the list of edges.
      * @param l list of adjacencies.
      * @return media value of gradient on mesh
      */    
-    static mpfr::real<MPFR_BITS_PRECISION> *getMediaGradient(list<Adjacency *> &l);        
+    static realNumber *getMediaGradient(list<Adjacency *> &l);        
     /**
      * Get the value of the bigger distance in the list of triangles.
      * @param l list of triangles.
      * @return higher value of distance of adjacency on mesh
      */
-    static mpfr::real<MPFR_BITS_PRECISION> *getBiggerDistance(list<Triangle *> &l);   
+    static realNumber *getBiggerDistance(list<Triangle *> &l);   
     /**
      * Print the value of the higher, lower and media gradient.
      * @param l list of adjacencies
@@ -172,7 +173,7 @@ public:
      * @param diferenceTime delta_t
      * @param s output file
      */     
-    static void printLinearSystem(Vertex *firstVertex, mpfr::real<MPFR_BITS_PRECISION> *diferenceTime, string s);
+    static void printLinearSystem(Vertex *firstVertex, realNumber *diferenceTime, string s);
     /**
      * Print to file vertices values
      * @param v first vertex of list of vertices
@@ -198,7 +199,7 @@ public:
      * @param newY new value of Y of vertex v
      * @param s output file
      */    
-    static void printVertexMovement(Vertex *v, mpfr::real<MPFR_BITS_PRECISION> &newX, mpfr::real<MPFR_BITS_PRECISION> &newY, string s);
+    static void printVertexMovement(Vertex *v, realNumber &newX, realNumber &newY, string s);
      /**
      * Verify if a file exist
      * @param filename name of file to verify
@@ -209,7 +210,7 @@ public:
      * @param v vertex to calculate area of voronoi diagram
      * @return area of voronoi diagram
      */               
-    static mpfr::real<MPFR_BITS_PRECISION> *areaPolygon(Vertex *v);   
+    static realNumber *areaPolygon(Vertex *v);   
     /**
      * Get incident triangles of Vertex v, like to incList, but triangles are ordened in clockwise or Counter Clockwise
      * @param listTriangles triangles list to put triangles incidents
@@ -221,32 +222,32 @@ public:
      * @param listVertices vertices list form a polygon to calculate area
      * @return area of polygon formed by vertices on listVertices
      */                 
-    static mpfr::real<MPFR_BITS_PRECISION> *areaVertices(list<mpfr::real<MPFR_BITS_PRECISION> *> &listVertices);
+    static realNumber *areaVertices(list<realNumber *> &listVertices);
     /**
      * Get cincuncenters of triangles on listTriangles and put on listVertices
      * @param listVertices vertices list to put circuncenters of triangles list
      * @param listTriangles triangles list to find circuncenters
      */                
-    static void getCcentersTriangles(list<mpfr::real<MPFR_BITS_PRECISION> *> &listVertices, list<Triangle *> &listTriangles);
+    static void getCcentersTriangles(list<realNumber *> &listVertices, list<Triangle *> &listTriangles);
     /**
      * Get higher polygon (voronoi diagram) area found on list of vertices
      * @param v first vertex of list of vertices
      * @return higher area of polygon (voronoi diagram)
      */   
-    static mpfr::real<MPFR_BITS_PRECISION> *getBiggerAreaPolygon(Vertex *v);
+    static realNumber *getBiggerAreaPolygon(Vertex *v);
     /**
      * Get lower polygon (voronoi diagram) area found on list of vertices
      * @param v first vertex of list of vertices
      * @return lower area of polygon (voronoi diagram)
      */ 
-    static mpfr::real<MPFR_BITS_PRECISION> *getSmallestAreaPolygon(Vertex *v);
+    static realNumber *getSmallestAreaPolygon(Vertex *v);
     /**
      * Calculates the euclidian distance of cincuncenters of triangles adjacents which share the edge with vertices v1 and v2.
      * @param v1 vertice of edge shared.
      * @param v2 vertice of edge shared.
      * @return euclidian distance of cincuncenters of triangles.
      */   
-    static mpfr::real<MPFR_BITS_PRECISION> *distanceCircuncenterTrianglesShareInterface( Vertex *v1, Vertex *v2 );    
+    static realNumber *distanceCircuncenterTrianglesShareInterface( Vertex *v1, Vertex *v2 );    
     /**
      * Solve mesh of laplace equation by Method Finite Volume .
      * @param firstVertex first vertice of mesh.
@@ -260,27 +261,51 @@ public:
      */      
     static bool compare(Vertex *first, Vertex *second);
     /**
-     * Reordenates the vertices list to pseudoperipherical vertex be the first
+     * Pseudo-peripheral vertex of the graph of the internal vertices (George and Liu algorithm): starting from the first internal
+       vertex, the rooted level structure is built from the vertex of minimum degree of the last level while the eccentricity grows.
+       Each round is a breadth-first search of an indexed copy of the graph, O(rounds x edges). The vertices list is not changed;
+       Vertex::levelStructure is left with the level of each internal vertex in the structure of the returned vertex.
      * @param mesh mesh to find pseudoperipherial vertex
+     * @return pseudoperipherial vertex, NULL if the mesh has no internal vertex.
      */     
-    static void findPseudoPeripheral(Mesh &mesh);
+    static Vertex *findPseudoPeripheral(Mesh &mesh);
+    /**
+     * Indexed copy of the graph of the internal vertices, in the order of the vertices list. Vertex::levelStructure is set to
+       the index of each internal vertex.
+     * @param mesh mesh of the graph.
+     * @param vertices internal vertices.
+     * @param rowStart internal neighbors of vertices[i] are neighbor[rowStart[i]] to neighbor[rowStart[i + 1] - 1].
+     * @param neighbor indices of the internal neighbors.
+     */
+    static void getInternalGraph(Mesh &mesh, vector<Vertex *> &vertices, vector<int> &rowStart, vector<int> &neighbor);
+    /**
+     * Statistics of the matrix of the internal vertices in the order of the vertices list.
+     * @param mesh mesh of the matrix.
+     * @param bytesPerValue bytes of an entry of the vector of the product by the matrix; 0 skips the estimate of cacheLines.
+     * @param bandwidth largest distance |i - j| between the rows of two adjacent internal vertices.
+     * @param profile sum over the rows i of i - (first column of the row i).
+     * @param averageDistance mean of |i - j| over the off-diagonal entries.
+     * @param cacheLines estimate of the cache lines of the vector loaded by one product by the matrix (rows in order, x[i] and then
+                         x[j] of the row), with a fully associative LRU cache of MESH_ORDERING_CACHE_BYTES.
+     */
+    static void getOrderingStatistics(Mesh &mesh, int bytesPerValue, long &bandwidth, long &profile, double &averageDistance, long &cacheLines);
     /**
      * Get maximum value of CircunradiusToShortestEdgeRatio in Mesh
      * @param mesh mesh to find max value of circunradiusToShortestEdgeRatio
      */     
-    static mpfr::real<MPFR_BITS_PRECISION> *circunradiusToShortestEdgeRatioMesh(Mesh &m);
+    static realNumber *circunradiusToShortestEdgeRatioMesh(Mesh &m);
     /**
      * Get minimal value of ShapeRegularityQuality in Mesh
      * @param mesh mesh to find minimal value of ShapeRegularityQuality
      * @return minimal value of ShapeRegularityQuality in Mesh
      */      
-    static mpfr::real<MPFR_BITS_PRECISION> *shapeRegularityQualityMesh(Mesh &m);
+    static realNumber *shapeRegularityQualityMesh(Mesh &m);
     /**
      * Get ShapeRegularityQuality of triangle
      * @param triangle to get ShapeRegularityQuality
      * @return value of ShapeRegularityQuality of triangle
      */        
-    static mpfr::real<MPFR_BITS_PRECISION> *shapeRegularityQuality(Triangle *triangle);
+    static realNumber *shapeRegularityQuality(Triangle *triangle);
     /**
      * Print string to file and display
      * @param stringToPrint string to print to output file
@@ -294,7 +319,19 @@ public:
      * @param toleranceSRQ minimal tolerance value of SRQ
      * @return array r with r[0] = maximum value of CER, r[1] = mininal value of SRQ, r[2] = percentage of triangles with CER bigger then maximum tolerance, r[3] = percentage of triangles with SRQ lower then minimal tolerance
      */       
-    static float *getInformationQualityMesh(Mesh *m,  mpfr::real<MPFR_BITS_PRECISION> &toleranceCER, mpfr::real<MPFR_BITS_PRECISION> &toleranceSRQ);
+    static float *getInformationQualityMesh(Mesh *m,  realNumber &toleranceCER, realNumber &toleranceSRQ);
+
+private:
+    /**
+     * Rooted level structure of a graph in compressed rows: breadth-first search from root.
+     * @param rowStart neighbors of the vertex i are neighbor[rowStart[i]] to neighbor[rowStart[i + 1] - 1].
+     * @param neighbor indices of the neighbors.
+     * @param root first vertex of the search.
+     * @param level level of each vertex (-1 if not reached), resized to the number of vertices.
+     * @param order vertices in the order of the search; the last level is at the end.
+     * @return eccentricity of root (number of levels - 1).
+     */
+    static int rootedLevelStructure(const vector<int> &rowStart, const vector<int> &neighbor, int root, vector<int> &level, vector<int> &order);
 };
 
 #endif // UTILS_H_INCLUDED
\ No newline at end of file
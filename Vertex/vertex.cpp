@@ -3,16 +3,18 @@
 #include "vertex.h"
 #include "../Adjacency/adjacency.h"
 
-Vertex::Vertex(mpfr::real<MPFR_BITS_PRECISION> &x, mpfr::real<MPFR_BITS_PRECISION> &y, int isBorder)
+Vertex::Vertex(realNumber &x, realNumber &y, int isBorder)
 {
     setXY(x, y);
     this->next           = NULL;
     this->label          = -1;         /**< Label of vertex. -1 is a invalid label. */     
+    this->id             = -1;         /**< Not created by a mesh */
     /**< Variables used in Cuthill–McKee algorithm */
     this->visited        = false;
     this->levelStructure = 0;
     this->eccentricity   = 0;          
     this->isBorder       = isBorder;   /**< FALSE vertex is internal, TRUE vertex is located at border*/
+    this->refinementLevel = 0;         /**< Vertex of the initial mesh */
     this->u              = 0;          /**< Value of temperature */
     this->previews_u     = 0;          /**< Value of temperature in previews timestep*/
     /**< Conjugate gradient variable */
@@ -24,7 +26,7 @@ Vertex::Vertex(mpfr::real<MPFR_BITS_PRECISION> &x, mpfr::real<MPFR_BITS_PRECISIO
     this->Ad             = 0;
 }
 
-void Vertex::setXY(mpfr::real<MPFR_BITS_PRECISION> &x, mpfr::real<MPFR_BITS_PRECISION> &y)
+void Vertex::setXY(realNumber &x, realNumber &y)
 {
     this->x = x;
     this->y = y;
@@ -5,7 +5,7 @@
 #define VERTEX_H_INCLUDED
 #include "../Utils/constants.h"
 #include <list>
-#include "real.hpp"
+#include "../Real/realNumber.h"
 using namespace std;
 class Adjacency; // A forward declaration is therefore needed to avoid circular dependencies.
 class Triangle;  // A forward declaration is therefore needed to avoid circular dependencies.
@@ -19,14 +19,17 @@ public:
     list<Triangle *> incList;    /**< List to the incident triangles */
     Vertex *next;                /**< Pointer used to create a list of vertices */
     int label;                   /**< Vertex label. */
+    int id;                      /**< Identifier of the vertex in its mesh, assigned by Mesh::createVertex() and kept by the copies
+                                      of Mesh::renumberVertices() (-1 = not created by a mesh) */
     int levelStructure;          /**< Used in Cuthill–McKee algorithm */
     int eccentricity;            /**< Used in Cuthill–McKee algorithm */
     bool visited;                /**< Used in Cuthill–McKee algorithm */
     bool isBorder;               /**< 0 or false vertex is internal, otherwise (true) vertex is border*/
+    int refinementLevel;         /**< Refinement stage that created the vertex (0 = initial mesh), used by the multigrid levels */
     /** Data members utilized in the Finite Volume Method and Conjugate Gradient Method **/
-    mpfr::real<MPFR_BITS_PRECISION> u, previews_u, b, coefficient, r, d, Au, Ad;    
+    realNumber u, previews_u, b, coefficient, r, d, Au, Ad;    
     /** Vertex coordinates **/
-    mpfr::real<MPFR_BITS_PRECISION> x, y;
+    realNumber x, y;
     //
     // Methods
     //
@@ -36,13 +39,13 @@ public:
      * @param y coordinate.
      * @param isBorder isBorder.
      */
-    Vertex(mpfr::real<MPFR_BITS_PRECISION> &x, mpfr::real<MPFR_BITS_PRECISION> &y, int isBorder); 
+    Vertex(realNumber &x, realNumber &y, int isBorder); 
     /**
      * Changes the coordinates x and y.
      * @param x coordinate
      * @param y coordinate
      */
-    void setXY(mpfr::real<MPFR_BITS_PRECISION> &x, mpfr::real<MPFR_BITS_PRECISION> &y); 
+    void setXY(realNumber &x, realNumber &y); 
     /**
      * Get the Adjacency object with vertex v. If there is no
        such adjacency, then returns null.
@@ -26,6 +26,7 @@
 #include "Adjacency/adjacency.h"
 #include "FiniteVolumeMethod/FiniteVolume.h"
 #include "ConjugateGradient/ConjugateGradient.h"
+#include "Utils/andersonMixing.h"
 //
 // Auxiliar data structures
 //
@@ -86,18 +87,56 @@ public:
     }
 };
 /** 
- * Data structure information about moved vertices
+ * Data structure information about a solve of the linear system
  */
-class InfoMovingVertex
-{ 
-    public:
-        mpfr::real<MPFR_BITS_PRECISION> *coordinates;
-        Vertex * v;
-        ~InfoMovingVertex() 
-        {
-            delete[] coordinates;
-            v = NULL;
-        }
+class InfoSolver
+{
+public:
+    int temporalIteration;
+    string stage;
+    int numberOfVertices;
+    int numberOfUnknowns;
+    long numberOfNonzeros;
+    int method;
+    int bitsPrecision;
+    int numberOfIterations;
+    bool converged;
+    bool setupReused;
+    long double initialResidual;
+    long double finalResidual;
+    double wallTime;
+    double cpuTime;
+    double flops;
+    double bytes;
+    long long cycles;
+    long long instructions;
+    long long cacheReferences;
+    long long cacheMisses;
+    vector<long double> residualNorm; /**< Residual of each iteration recorded by the solve (see ConjugateGradientHistory::residualNorm) */
+    InfoSolver(int temporalIteration, string stage, int numberOfVertices, ConjugateGradientParameters *parameters, ConjugateGradientHistory *history)
+    {
+        this->temporalIteration  = temporalIteration;
+	this->stage              = stage;
+	this->numberOfVertices   = numberOfVertices;
+	this->numberOfUnknowns   = history->numberOfUnknowns;
+	this->numberOfNonzeros   = history->numberOfNonzeros;
+	this->method             = parameters->method;
+	this->bitsPrecision      = history->bitsPrecision; // Precision used, not the requested one
+	this->numberOfIterations = history->numberOfIterations;
+	this->converged          = history->converged;
+	this->setupReused        = history->setupReused;
+	this->initialResidual    = history->getInitialResidual();
+	this->finalResidual      = history->getFinalResidual();
+	this->wallTime           = history->wallTime;
+	this->cpuTime            = history->cpuTime;
+	this->flops              = history->flops;
+	this->bytes              = history->bytes;
+	this->cycles             = history->cycles;
+	this->instructions       = history->instructions;
+	this->cacheReferences    = history->cacheReferences;
+	this->cacheMisses        = history->cacheMisses;
+	this->residualNorm       = history->residualNorm;
+    }
 };
 /** 
  * Data structure used as a function parameter of advanceTimeAndMovingMesh()
@@ -139,13 +178,27 @@ static int
     CONFIG_MONITOR_FUNCTION_THREAD_C		 = 2,
     CONFIG_MONITOR_FUNCTION_THREAD_D		 = 3,
     CONFIG_MONITOR_FUNCTION_THREAD_E		 = 4,
-    CONFIG_NUM_THREADS				 = 5;
+    CONFIG_NUM_THREADS				 = 5,
+    CONFIG_PRECISION_SOLVER                      = 0,    /**< Bits of precision of the conjugate gradient (0 = precision of realNumber) */
+    CONFIG_CG_METHOD                             = CG_METHOD_CLASSIC, /**< CG_METHOD_CLASSIC, CG_METHOD_FUSED, CG_METHOD_PIPELINED, CG_METHOD_MULTIGRID_PCG, CG_METHOD_MULTIGRID, CG_METHOD_CHOLESKY, CG_METHOD_DEFLATED, CG_METHOD_CHEBYSHEV or CG_METHOD_CHEBYSHEV_PCG */
+    CONFIG_CG_THREADS                            = 1,    /**< Threads of each conjugate gradient (CG_METHOD_PIPELINED, CG_METHOD_CHEBYSHEV) */
+    CONFIG_MOVING_MESH_THREADS                   = 1,    /**< Threads of each sweep of the monitor functions over the vertices of a mesh */
+    CONFIG_MOVING_MESH_ANDERSON_DEPTH            = 0,    /**< Movements of the history of the Anderson acceleration of the moving mesh, in a time step (0 = no acceleration) */
+    CONFIG_MOVING_MESH_LAGGED_MOVEMENTS          = 0,    /**< Consecutive movements of the moving mesh that reuse the interpolated solution instead of solving (0 = solve after each movement) */
+    CONFIG_CG_CRITERION                          = CG_CRITERION_UPDATE, /**< CG_CRITERION_UPDATE, CG_CRITERION_RELATIVE_RESIDUAL or CG_CRITERION_ABSOLUTE_RESIDUAL */
+    CONFIG_MULTIGRID_CYCLE                       = MULTIGRID_V_CYCLE, /**< MULTIGRID_V_CYCLE or MULTIGRID_W_CYCLE */
+    CONFIG_MULTIGRID_COARSENING                  = MULTIGRID_COARSENING_REFINEMENT, /**< MULTIGRID_COARSENING_REFINEMENT or MULTIGRID_COARSENING_AGGREGATION */
+    CONFIG_MULTIGRID_SMOOTHER                    = MULTIGRID_SMOOTHER_GAUSS_SEIDEL, /**< MULTIGRID_SMOOTHER_GAUSS_SEIDEL or MULTIGRID_SMOOTHER_CHEBYSHEV */
+    CONFIG_CG_DEFLATION_VECTORS                  = 8,    /**< Approximate eigenvectors recycled between solves (CG_METHOD_DEFLATED) */
+    CONFIG_MESH_ORDERING                         = MESH_ORDERING_CUTHILL_MCKEE; /**< MESH_ORDERING_CUTHILL_MCKEE, MESH_ORDERING_HILBERT, MESH_ORDERING_MORTON or MESH_ORDERING_NESTED_DISSECTION */
 static float
     CONFIG_TIME_VARIATION                        = 0.1, // \Delta_t
     CONFIG_MONITOR_FUNCTION_BETA                 = 0.1,
     CONFIG_MONITOR_FUNCTION_MU                   = 0.1,
     CONFIG_LAPLACIAN_SMOOTHING_KAPA		 = 0.1,
     CONFIG_MOVING_MESH_ETA                       = 0.5,
+    CONFIG_MOVING_MESH_SOLVE_DISPLACEMENT        = 0,    /**< Displacement since the last solve above which a lagged movement solves (0 = only CONFIG_MOVING_MESH_LAGGED_MOVEMENTS) */
+    CONFIG_MOVING_MESH_FIXED_POINT_TOLERANCE     = 0,    /**< Largest displacement of a movement below which the moving mesh has converged and stops (0 = only CONFIG_MOVING_MESH_ETA) */
     CONFIG_MESH_MINIMUM_ANGLE_ALPHA              = 30,    
     // Boundary conditions        
     CONFIG_DOMAIN_DIMENSION                      = 50,
@@ -160,8 +213,11 @@ static long double
     CONFIG_PERC_INCREASE_GRADIENT_THETA          = 1e-10;
 static bool
     CONFIG_EXEC_FLIP_OFF_CENTER                  = false, /**<  false to execute off_center (Ungor), true to execute flip (Lawson) */
+    CONFIG_CHOLESKY_KEEP_FACTOR                  = false, /**< true to precondition the conjugate gradient with an outdated Cholesky factor (CG_METHOD_CHOLESKY) */
     CONFIG_EXEC_CUTHILL_MCKEE_ALG                = true,
     CONFIG_CUTHILL_MCKEE_REVERSE                 = true,  /**<  true to reverse cuthill_mckee, false to cuthill_mckee */
+    CONFIG_RENUMBER_VERTICES                     = true,  /**<  true to move the vertices to contiguous memory in the order of the list after the reordering */
+    CONFIG_MOVING_MESH_ROLLBACK                  = true,  /**<  true to damp or revert the displacements that invert triangles (Mesh::repairMovedTriangles()), false to stop the thread */
     CONFIG_DISPLAY_MESH                          = true,      
     CONFIG_SHOW_TRIANGLE                         = true,  /**< Show triangles in mesh display */
     CONFIG_SHOW_CIRCLE                           = true,  /**< Show circuncicles in mesh display */
@@ -171,6 +227,9 @@ static bool
     CONFIG_PRINT_TRIANGLE_VALUE                  = true,  /**< Print to CONFIG_OUTPUT_FILE_TRIANGLE_VALUE triangles informations */  
     CONFIG_PRINT_ADJACENCY_VALUE		 = true,  /**< Print to CONFIG_OUTPUT_FILE_ADJACENCY_VALUE adjacencies informations */  
     CONFIG_PRINT_CLOCKS_VALUES			 = true,  /**< Print to CONFIG_OUTPUT_FILE_CLOCK_* execution clocks */  
+    CONFIG_PRINT_SOLVER_STATISTICS               = false, /**< Print to CONFIG_OUTPUT_FILE_SOLVER_CSV and CONFIG_OUTPUT_FILE_SOLVER_JSON statistics of each solve */
+    CONFIG_PRINT_HARDWARE_COUNTERS               = false, /**< Count cycles, instructions and cache references and misses of each solve (perf_event_open), printed with the solver statistics */
+    CONFIG_PRINT_ORDERING_STATISTICS             = false, /**< Print after each reordering the average distance between neighbors and the cache lines per product by the matrix */
     CONFIG_PRINT_VERTEX_MOVIMENT                 = true,  /**< Print to CONFIG_OUTPUT_FILE_VERTEX_MOVIMENT movement information of vertices */  
     CONFIG_PRINT_MATRIX_A_B                      = true,  /**< TODO Funcao precisa da biblioteca eigen */
     CONFIG_PRINT_INFO_MESSAGES                   = true,  /**< Information messages will print during execution */ 
@@ -193,6 +252,8 @@ static string
     CONFIG_OUTPUT_FILE_CLOCK_FV                  = "Clocks_fv.csv",
     CONFIG_OUTPUT_FILE_CLOCK_CG                  = "Clocks_cg.txt",
     CONFIG_OUTPUT_FILE_CLOCK_MM                  = "Clocks_mm.txt",
+    CONFIG_OUTPUT_FILE_SOLVER_CSV                = "Solver.csv",
+    CONFIG_OUTPUT_FILE_SOLVER_JSON               = "Solver.json",
     CONFIG_OUTPUT_MAIN_FILE                      = "saida.txt",
     CONFIG_OUTPUT_FILE_THREAD_A                  = "saida_thread_A.txt",    
     CONFIG_OUTPUT_FILE_THREAD_B                  = "saida_thread_B.txt",
@@ -272,6 +333,42 @@ void printListOfClocks(list<InfoClock *> l, string s);
  * @param l list of InfoClock to clear
  */ 
 void clearListOfClocks(list<InfoClock *> l);
+/**
+ * Print statistics of the solves to a csv file
+ * @param l list of InfoSolver
+ * @param s string with output file
+ */
+void printInformationSolver(list<InfoSolver *> l, string s);
+/**
+ * Print statistics of the solves to a json file (array of objects)
+ * @param l list of InfoSolver
+ * @param s string with output file
+ */
+void printInformationSolverJSON(list<InfoSolver *> l, string s);
+/**
+ * Number written to a json file: JSON has no nan or inf, so a value that is not finite (a diverged solve) is written as null
+ * @param value number to write
+ * @return text of the number, with precision CONFIG_OUTPUT_PRECISION, or null
+ */
+string getJSONNumber(long double value);
+/**
+ * Clear list of solver statistics deleting data
+ * @param l list of InfoSolver to clear
+ */
+void clearListOfSolver(list<InfoSolver *> l);
+/**
+ * Bandwidth and profile of the matrix in the current ordering of the vertices and, with CONFIG_PRINT_ORDERING_STATISTICS,
+ * the average distance between the rows of neighbors and the estimated cache lines of the vector loaded by one product
+ * @param m mesh
+ * @return text to print to the output file
+ */
+string getInformationOrdering(Mesh *m);
+/**
+ * Vertices of the triangles inverted by a movement
+ * @param invertedTriangles triangles found by Mesh::checkMovedTriangles()
+ * @return text to print to the output file
+ */
+string getInformationInvertedTriangles(vector<Triangle *> &invertedTriangles);
 /**
  * Clear list of QualityMesh deleting data
  * @param l list of InfoQualityMesh to clear
@@ -297,7 +394,7 @@ void readConfigurationsFromFile(string inputFileName);
  * @param y y coordinate
  * @return true if is out of domain
  */
-bool isOutOfDomain(mpfr::real<MPFR_BITS_PRECISION> &x, mpfr::real<MPFR_BITS_PRECISION> &y );
+bool isOutOfDomain(realNumber &x, realNumber &y );
 /**
  * Verify if adjacency accord distance and gradient criterion refinement
  * @param adjPtr adjacency to verify
@@ -323,52 +420,42 @@ bool refinementTriangleCriterion(Triangle *t);
  */
 Triangle *getTriangle(Adjacency *adjPtr);
 /**
- * Calculates weight values of sum_x_total, sum_y_total and sum_u_total to monitorFunctionGamma()
- * @param v vertex to calculates weight
- * @param sum_x_total variable to set sum of x
- * @param sum_y_total variable to set sum of y
- * @param sum_u_total variable to set sum of u
- * @see monitorFunctionGamma()
- */
-void calculatesWeightGamma(Vertex *v, mpfr::real<MPFR_BITS_PRECISION> &sum_x_total, mpfr::real<MPFR_BITS_PRECISION> &sum_y_total, mpfr::real<MPFR_BITS_PRECISION> &sum_u_total);
-/**
- * Calculates weight values of sum_x_total, sum_y_total and sum_u_total to monitorFunctionUpsilon()
- * @param v vertex to calculates weight
- * @param sum_x_total variable to set sum of x of the neighbors of vertex v
- * @param sum_y_total variable to set sum of y of the neighbors of vertex v
- * @param sum_u_total variable to set sum of u of the neighbors of vertex v
- * @see monitorFunctionUpsilon()
- */
-void calculatesWeightUpsilon(Vertex *v, mpfr::real<MPFR_BITS_PRECISION> &sum_x_total, mpfr::real<MPFR_BITS_PRECISION> &sum_y_total, mpfr::real<MPFR_BITS_PRECISION> &sum_u_total);
-/**
- * Calculates weight values of sum_x_total and sum_y_total to monitorFunctionLambda()
- * @param v vertex to calculates weight
- * @param sum_x_total variable to set sum of x of the neighbors of vertex v
- * @param sum_y_total variable to set sum of y of the neighbors of vertex v
- * @see monitorFunctionLambda()
+ * Moves the internal vertices by the weighted average of the position of their neighbors (Jacobi sweep): the new
+ * coordinates of all the vertices are computed into a buffer before any vertex moves, so the vertices are split in
+ * CONFIG_MOVING_MESH_THREADS blocks computed and moved by threads. The vertices displaced are appended to m->movedVertices
+ * and their old coordinates to m->previousCoordinates
+ *  x_c = x_c + step * sum_i( w_i (x_i - x_c) ) / weight.normalization( sum_i(w_i) )
+ * @param m mesh to move
+ * @param weight policy of the weight w_i of the edge between the vertex and its neighbor i
+ * @param step coefficient of the displacement, negative to move away from the average (Taubin)
+ * @return true if vertices coordinates has moved. False if vertices coordinates don't change.
  */
-void calculatesWeightLambda(Vertex *v, mpfr::real<MPFR_BITS_PRECISION> &sum_x_total, mpfr::real<MPFR_BITS_PRECISION> &sum_y_total);
+template <class Weight> bool moveByWeight(Mesh *m, const Weight &weight, float step);
 /**
- * Calculates weight values for laplacian smoothing.
- * @param v vertex to calculates weight
- * @param sum_x_total variable to set sum of x of the neighbors of vertex v
- * @param sum_y_total variable to set sum of y of the neighbors of vertex v
- * @return bool if vertex must be moved (if had triangle with bad quality)
- * @see monitorFunctionLambda()
+ * Anderson acceleration of the fixed point of the moving mesh, x = G(x) with G the movement after the solve of u in the
+ * mesh x (the system of a time step is built from previews_u, so G does not change between the solves of the time step):
+ * the positions given by the last movement (m->movedVertices) are replaced by the mixing of the positions of the previous
+ * movements of the time step. A vertex that would leave the domain is not accelerated, the accelerated displacements
+ * that invert triangles are damped or reverted by Mesh::repairMovedTriangles(), and the acceleration is reverted if the
+ * quality of the mesh falls below eta; the history is cleared if the acceleration is reverted
+ * @param m mesh moved by Mesh::movingMesh()
+ * @param anderson history of the movements of the time step
+ * @return number of vertices moved by the acceleration (0 if not applied)
  */
-bool calculatesWeightLaplacianSmoothing(Vertex *v, mpfr::real<MPFR_BITS_PRECISION> &sum_x_total, mpfr::real<MPFR_BITS_PRECISION> &sum_y_total, mpfr::real<MPFR_BITS_PRECISION> &sum_u_total);
+int accelerateMovement(Mesh *m, AndersonMixing &anderson);
 /**
- * Set new values of x and y stored in list of movingVertexData
- * @param verticesToMoveList list of InfoMovingVertex contening vertices to move
+ * Get the largest displacement of a vertex by the last movement (m->movedVertices), from its position before the movement.
+ * @param m mesh moved by Mesh::movingMesh()
+ * @return euclidean norm of the largest displacement
  */
-void moveVertices(list<InfoMovingVertex *> &verticesToMoveList);
+double getMaximumDisplacement(Mesh *m);
 /**
- * Helps to create a InfoMovingVertex
- * @param v vertex to move
- * @param newCoordinates new coordiantes of vertex to move
- * @return InfoMovingVertex created
+ * Thread of moveByWeight(): computes the new coordinates of its block of vertices and, when all the blocks are computed,
+ * moves them
+ * @param arg void pointer to MovingMeshWorkerArgument
+ * @return NULL
  */
-InfoMovingVertex *createInfoMovingVertex(Vertex *v, mpfr::real<MPFR_BITS_PRECISION> *newCoordinates);
+template <class Weight> void *moveByWeightWorker(void *arg);
 /**
  * Verify if triangle is out of domain
  * @param t triangle to check
@@ -441,7 +528,7 @@ void createOutputDirectories();
 static map<int, monitorFunction> monitorFunctions; /**< Map of monitor functions address */
 static map<int, string> monitorFunctionsNames; /**< Map of monitor functions names */
 static clock_t timeClockToCreateAdaptiveMesh; /**< Store clocks to create adaptive mesh */
-static mpfr::real<MPFR_BITS_PRECISION> 
+static realNumber 
     eta                	 = 0, /**< Minimal quality tolerance. Stoped criterion to moving vertices. Setting on createAdaptiveMesh() */
     rho_alpha          	 = 1, /**< Value of circunradiusToShortestEdgeRatio maximus used to refine mesh. Setting on createAdaptiveMesh() */
     limitDistance        = 0, /**< Limit of Distance is used by refinementCriterion() */
@@ -649,6 +736,9 @@ Mesh *createAdaptiveMesh()
     bool refined = true;   
     stringstream tmp, outputFile;
     int countRefinement = 0, numberOfIterationsCG = 0;
+    ConjugateGradientParameters cgParameters(CONFIG_PRECISION_SOLVER, CONFIG_CG_METHOD, CONFIG_CG_THREADS, CONFIG_CG_CRITERION, CONFIG_MULTIGRID_CYCLE, CONFIG_MULTIGRID_COARSENING, CONFIG_MULTIGRID_SMOOTHER, CONFIG_CHOLESKY_KEEP_FACTOR, CONFIG_CG_DEFLATION_VECTORS);
+    ConjugateGradientHistory cgHistory; // Iterations and residuals of the last solve
+    cgHistory.countHardwareEvents = CONFIG_PRINT_HARDWARE_COUNTERS;
     clock_t timeClock;
     // List of clocks information
     list<InfoClock *> 
@@ -660,7 +750,9 @@ Mesh *createAdaptiveMesh()
     list<InfoQualityMesh *> listQualityMesh;
     // List of data gradients mesh
     list<InfoGradientMesh *> listGradients;
-    mpfr::real<MPFR_BITS_PRECISION> 
+    // List of statistics of the solves
+    list<InfoSolver *> listSolver;
+    realNumber 
 	delta_t 	   = 0,
 	*diferenceGradient = NULL, 
         *biggerDistance    = NULL;
@@ -672,8 +764,8 @@ Mesh *createAdaptiveMesh()
     timeClockToCreateAdaptiveMesh = clock(); // Getting initial clocks
     delta_t   = CONFIG_TIME_VARIATION; // Static variable
     eta       = CONFIG_MOVING_MESH_ETA; // Static variable
-    rho_alpha = fabs( 1 / (2*sin( CONFIG_MESH_MINIMUM_ANGLE_ALPHA * (mpfr::const_pi<MPFR_BITS_PRECISION, MPFR_RNDN>()/180) ) ) ); // Static variable   
-    mpfr_free_cache();   // Clear const_pi 	    
+    rho_alpha = fabs( 1 / (2*sin( CONFIG_MESH_MINIMUM_ANGLE_ALPHA * (realNumberPi()/180) ) ) ); // Static variable   
+    realNumberFreeCache();   // Clear const_pi 	    
     // Set vertex function to define initial values of u
     m->setVertexFunction(setInitialBoundaryConditions);
     // Create the initial mesh from a inputfile
@@ -690,6 +782,7 @@ Mesh *createAdaptiveMesh()
     while ( (m->numberOfVertices < CONFIG_MIN_VERTICES) && (refined) )           
     {           
         countRefinement++;    
+        m->refinementLevel = countRefinement; // Level of the vertices created in this stage (multigrid)
 	tmp << "\nETAPA REFINAMENTO: " << countRefinement << endl;
         if (countRefinement == 1) 
         {
@@ -720,18 +813,24 @@ Mesh *createAdaptiveMesh()
         {
             tmp << "Executando CMr.\n";              
             timeClock = clock();
-            m->cuthillMcKee(CONFIG_CUTHILL_MCKEE_REVERSE, UTILS_CM_PSEUDOPERIPHERAL);                
+            bool reordered = m->reorder(CONFIG_MESH_ORDERING, CONFIG_CUTHILL_MCKEE_REVERSE, UTILS_CM_PSEUDOPERIPHERAL);
             timeClock = clock() - timeClock;   
             ic = new InfoClock(m->numberOfVertices, timeClock);
             listClockCMr.push_back(ic);                                  
+            if (reordered)
+                tmp << getInformationOrdering(m);
         }        
+        if (CONFIG_RENUMBER_VERTICES)
+            m->renumberVertices(); // Vertices in contiguous memory in the order of the list
         tmp << "Executando MGC.\n";                               
         timeClock = clock();
-        numberOfIterationsCG = ConjugateGradient::solve( m->first, m->numberOfVertices, &CONFIG_CG_PRESICION_EPSILON); // Solve the mesh by Conjugate Gradient                                    
+        numberOfIterationsCG = ConjugateGradient::solve( m->first, m->numberOfVertices, &CONFIG_CG_PRESICION_EPSILON, &cgParameters, &cgHistory); // Solve the mesh by Conjugate Gradient                                    
         timeClock = clock() - timeClock;
         ic = new InfoClock(m->numberOfVertices, timeClock);
         listClockCG.push_back(ic);       
+        listSolver.push_back(new InfoSolver(0, "refinamento", m->numberOfVertices, &cgParameters, &cgHistory));
         tmp << "Total iteracoes: " << numberOfIterationsCG << endl;                           
+        tmp << "Residuo final: " << cgHistory.getFinalResidual() << endl;
         tmp << "Total vertices: " << m->numberOfVertices << endl;      
 	Utils::printString(tmp.str(), outputFile.str(), CONFIG_PRINT_INFO_MESSAGES);     
 	tmp.str("");
@@ -751,6 +850,16 @@ Mesh *createAdaptiveMesh()
     tmp << CONFIG_OUTPUT_DIRECTORY << "/" << CONFIG_OUTPUT_FILE_GRADIENT_MESH;	
     printInformationGradientsMesh(listGradients, tmp.str());  
     clearListOfGradientsMesh(listGradients);
+    if (CONFIG_PRINT_SOLVER_STATISTICS)
+    {
+	tmp.str("");
+	tmp << CONFIG_OUTPUT_DIRECTORY << "/" << CONFIG_OUTPUT_FILE_SOLVER_CSV;
+	printInformationSolver(listSolver, tmp.str());
+	tmp.str("");
+	tmp << CONFIG_OUTPUT_DIRECTORY << "/" << CONFIG_OUTPUT_FILE_SOLVER_JSON;
+	printInformationSolverJSON(listSolver, tmp.str());
+    }
+    clearListOfSolver(listSolver);
     if (CONFIG_PRINT_CLOCKS_VALUES)
     {    
 	tmp.str(""); // Clear varable
@@ -779,6 +888,11 @@ void *advanceTimeAndMovingMesh(void *arg)
     stringstream outputFile, outputDir, tmp;
     clock_t timeClockToAdvanceTimeAndMovingMesh, timeClock; 
     int timeStep = 1, monitorFunctionId = 0, threadId = 0, numberOfIterationsCG = 0;
+    ConjugateGradientParameters cgParameters(CONFIG_PRECISION_SOLVER, CONFIG_CG_METHOD, CONFIG_CG_THREADS, CONFIG_CG_CRITERION, CONFIG_MULTIGRID_CYCLE, CONFIG_MULTIGRID_COARSENING, CONFIG_MULTIGRID_SMOOTHER, CONFIG_CHOLESKY_KEEP_FACTOR, CONFIG_CG_DEFLATION_VECTORS);
+    ConjugateGradientHistory cgHistory; // Iterations and residuals of the last solve
+    cgHistory.countHardwareEvents = CONFIG_PRINT_HARDWARE_COUNTERS;
+    vector<Triangle *> invertedTriangles; // Triangles inverted by the last movement
+    AndersonMixing anderson(CONFIG_MOVING_MESH_ANDERSON_DEPTH); // Movements of the time step
     list<InfoClock *> 
 	listClockCMr, // Clocks to Cuthill Mckee Reverse
 	listClockFV,  // Clocks to Finite Volume Method
@@ -788,7 +902,9 @@ void *advanceTimeAndMovingMesh(void *arg)
     list<InfoQualityMesh *> listQualityMesh;
     // List of data gradients mesh
     list<InfoGradientMesh *> listGradients;        
-    mpfr::real<MPFR_BITS_PRECISION>
+    // List of statistics of the solves
+    list<InfoSolver *> listSolver;
+    realNumber
 	delta_t = 0, /**< Time variation of heat equation used in finite volume method. */
 	*upsilon = NULL;    
     // Parse void pointer to data pointer
@@ -811,7 +927,10 @@ void *advanceTimeAndMovingMesh(void *arg)
     {
 	delta_t = timeStep*CONFIG_TIME_VARIATION;
 	int countMoviment = 0;
-	bool hasMov = false;
+	bool hasMov = false, converged = false; // converged: the last movement is below CONFIG_MOVING_MESH_FIXED_POINT_TOLERANCE
+	int laggedMovements = 0;           // Movements since the last solve
+	double displacementSinceSolve = 0; // Sum of the largest displacements of the movements since the last solve
+	anderson.clear(); // The movement depends on previews_u of the time step
 	// Get gradients mesh
 	listGradients.push_back(getGradientsMesh(m, timeStep));
 	// Get quality mesh
@@ -827,6 +946,26 @@ void *advanceTimeAndMovingMesh(void *arg)
 		tmp << "Movimentando malha (Funcao "<< monitorFunctionsNames[monitorFunctionId] << "). Etapa: " << timeStep << "/" << CONFIG_TIME_LIMIT << " - " << countMoviment << "\n";     
 		timeClock = clock();            
 		hasMov = m->movingMesh(monitorFunctions[monitorFunctionId]);  // Moving the Mesh    
+		if (CONFIG_MOVING_MESH_ROLLBACK)
+		{
+		    bool displaced = false;
+		    int repaired = m->repairMovedTriangles(displaced); // Damps or reverts the displacements that inverted triangles
+		    hasMov = hasMov && displaced; // A movement reverted entirely would be proposed again with the same u
+		    if (repaired > 0)
+			tmp << "Deslocamentos amortecidos ou desfeitos: " << repaired << endl;
+		}
+		if (CONFIG_MOVING_MESH_FIXED_POINT_TOLERANCE > 0)
+		{
+		    double residual = getMaximumDisplacement(m); // || G(x) - x || of the fixed point of the moving mesh
+		    converged = (residual < CONFIG_MOVING_MESH_FIXED_POINT_TOLERANCE);
+		    tmp << "Residuo do ponto fixo: " << residual << endl;
+		}
+		if ( (CONFIG_MOVING_MESH_ANDERSON_DEPTH > 0) && (!converged) )
+		{
+		    int accelerated = accelerateMovement(m, anderson); // Mixing of the movements of the time step
+		    if (accelerated > 0)
+			tmp << "Aceleracao de Anderson: " << accelerated << " vertices" << endl;
+		}
 		timeClock = clock() - timeClock;
 		ic = new InfoClock(m->numberOfVertices, timeClock);
 		listClockMM.push_back(ic);                      
@@ -838,43 +977,65 @@ void *advanceTimeAndMovingMesh(void *arg)
 	    if (hasMov) tmp << "Movimento OK\n"; else tmp << "Nao Movimentou\n";
 	    countMoviment++;
 	    tmp <<  "Verificando Malha.\n";
-	    // Verify mesh pos moviment  
-	    if (m->smartCheckMesh() )
+	    // Verify mesh pos moviment: orientation of the triangles of the displaced vertices
+	    if (m->checkMovedTriangles(invertedTriangles) )
 		tmp << "Malha OK.\n";	   
 	    else {
 		tmp << "Erro Malha.\n";  
+		tmp << getInformationInvertedTriangles(invertedTriangles);
 		Utils::printString(tmp.str(), outputFile.str(), CONFIG_PRINT_INFO_MESSAGES);
 		pthread_exit(NULL);
 		
 	    }
-	    tmp << "Executando MVF.\n";     
-	    timeClock = clock();
-	    FiniteVolume::solve(m->first, delta_t); // Generates linear system by Finite Volume
-	    timeClock = clock() - timeClock;
-	    ic = new InfoClock(m->numberOfVertices, timeClock);
-	    listClockFV.push_back(ic);           
-	    if (CONFIG_EXEC_CUTHILL_MCKEE_ALG)
+	    // Get mesh quality Shape Regularity Quality (only the coordinates: known before the solve, which ends the loop if it is low)
+	    upsilon = Utils::shapeRegularityQualityMesh(*m);
+	    displacementSinceSolve += getMaximumDisplacement(m);
+	    if ( (hasMov) && (*upsilon > eta) && (!converged) && (laggedMovements < CONFIG_MOVING_MESH_LAGGED_MOVEMENTS) &&
+	         ( (CONFIG_MOVING_MESH_SOLVE_DISPLACEMENT == 0) || (displacementSinceSolve < CONFIG_MOVING_MESH_SOLVE_DISPLACEMENT) ) )
 	    {
-		tmp << "Executando CMr.\n";  
+		// Lagged movement: the next movement reuses the last solution, interpolated to the moved vertices
+		laggedMovements++;
+		int interpolated = m->interpolateMovedVertices();
+		tmp << "Solucao interpolada: " << interpolated << " vertices. Deslocamento desde a ultima solucao: " << displacementSinceSolve << endl;
+		Utils::printString(tmp.str(), outputFile.str(), CONFIG_PRINT_INFO_MESSAGES);
+		tmp.str("");
+	    } else
+	    {
+		laggedMovements = 0;
+		displacementSinceSolve = 0;
+		tmp << "Executando MVF.\n";     
 		timeClock = clock();
-		m->cuthillMcKee(CONFIG_CUTHILL_MCKEE_REVERSE, UTILS_CM_PSEUDOPERIPHERAL);                
-		timeClock = clock() - timeClock;   
+		FiniteVolume::solve(m->first, delta_t); // Generates linear system by Finite Volume
+		timeClock = clock() - timeClock;
 		ic = new InfoClock(m->numberOfVertices, timeClock);
-		listClockCMr.push_back(ic);                                  
-	    }	                
-	    tmp << "Executando MGC.\n"; 
-	    timeClock = clock();
-	    numberOfIterationsCG = ConjugateGradient::solve( m->first, m->numberOfVertices, &CONFIG_CG_PRESICION_EPSILON); // Solve the mesh by Conjugate Gradient                                    
-	    timeClock = clock() - timeClock;
-	    ic = new InfoClock(m->numberOfVertices, timeClock);
-	    listClockCG.push_back(ic);    
-	    timeClock = clock();	    
-	    tmp << "Total iteracoes: " << numberOfIterationsCG << endl;
-	    tmp << "Total vertices: " << m->numberOfVertices << endl;
-	    Utils::printString(tmp.str(), outputFile.str(), CONFIG_PRINT_INFO_MESSAGES);
-	    tmp.str("");	    
-	    // Get mesh quality Shape Regularity Quality
-	    upsilon = Utils::shapeRegularityQualityMesh(*m);	    
+		listClockFV.push_back(ic);           
+		if (CONFIG_EXEC_CUTHILL_MCKEE_ALG)
+		{
+		    tmp << "Executando CMr.\n";  
+		    timeClock = clock();
+		    bool reordered = m->reorder(CONFIG_MESH_ORDERING, CONFIG_CUTHILL_MCKEE_REVERSE, UTILS_CM_PSEUDOPERIPHERAL);
+		    timeClock = clock() - timeClock;   
+		    ic = new InfoClock(m->numberOfVertices, timeClock);
+		    listClockCMr.push_back(ic);                                  
+		    if (reordered)
+			tmp << getInformationOrdering(m);
+		}	                
+		if (CONFIG_RENUMBER_VERTICES)
+		    m->renumberVertices(); // Vertices in contiguous memory in the order of the list
+		tmp << "Executando MGC.\n"; 
+		timeClock = clock();
+		numberOfIterationsCG = ConjugateGradient::solve( m->first, m->numberOfVertices, &CONFIG_CG_PRESICION_EPSILON, &cgParameters, &cgHistory); // Solve the mesh by Conjugate Gradient                                    
+		timeClock = clock() - timeClock;
+		ic = new InfoClock(m->numberOfVertices, timeClock);
+		listClockCG.push_back(ic);    
+		listSolver.push_back(new InfoSolver(timeStep, "movimento", m->numberOfVertices, &cgParameters, &cgHistory));
+		timeClock = clock();	    
+		tmp << "Total iteracoes: " << numberOfIterationsCG << endl;
+		tmp << "Residuo final: " << cgHistory.getFinalResidual() << endl;
+		tmp << "Total vertices: " << m->numberOfVertices << endl;
+		Utils::printString(tmp.str(), outputFile.str(), CONFIG_PRINT_INFO_MESSAGES);
+		tmp.str("");	    
+	    }
  	    if ( *upsilon < eta )
  	    {
 		// Get gradients mesh
@@ -882,7 +1043,7 @@ void *advanceTimeAndMovingMesh(void *arg)
 		// Get quality mesh
 		listQualityMesh.push_back(getQualityMesh(m, timeStep));		
  	    }
-	} while ( (hasMov) && ( *upsilon > eta ) ); // End moving mesh
+	} while ( (hasMov) && ( *upsilon > eta ) && (!converged) ); // End moving mesh
 	if (CONFIG_LAPLACIAN_SMOOTHING_KAPA != 0)
 	{
 	    int count = 0;	  
@@ -924,19 +1085,25 @@ void *advanceTimeAndMovingMesh(void *arg)
 	{            
 	    tmp << "Executando CMr.\n"; 
 	    timeClock = clock();
-	    m->cuthillMcKee(CONFIG_CUTHILL_MCKEE_REVERSE, UTILS_CM_PSEUDOPERIPHERAL);                
+	    bool reordered = m->reorder(CONFIG_MESH_ORDERING, CONFIG_CUTHILL_MCKEE_REVERSE, UTILS_CM_PSEUDOPERIPHERAL);
 	    timeClock = clock() - timeClock;  
 	    ic = new InfoClock(m->numberOfVertices, timeClock);
 	    listClockCMr.push_back(ic);                 
+	    if (reordered)
+	        tmp << getInformationOrdering(m);
 	}
+	if (CONFIG_RENUMBER_VERTICES)
+	    m->renumberVertices(); // Vertices in contiguous memory in the order of the list
 	tmp << "Executando MGC.\n";
 	timeClock = clock();
-	numberOfIterationsCG = ConjugateGradient::solve( m->first, m->numberOfVertices, &CONFIG_CG_PRESICION_EPSILON); // Solve the mesh by Conjugate Gradient                                    
+	numberOfIterationsCG = ConjugateGradient::solve( m->first, m->numberOfVertices, &CONFIG_CG_PRESICION_EPSILON, &cgParameters, &cgHistory); // Solve the mesh by Conjugate Gradient                                    
 	timeClock = clock() - timeClock;
 	ic = new InfoClock(m->numberOfVertices, timeClock);
 	listClockCG.push_back(ic); 
+	listSolver.push_back(new InfoSolver(timeStep, "refinamento", m->numberOfVertices, &cgParameters, &cgHistory));
 	tmp << "Total refinados: " << totalRefined << endl;   	
 	tmp << "Total iteracoes: " << numberOfIterationsCG << endl;      
+	tmp << "Residuo final: " << cgHistory.getFinalResidual() << endl;
 	tmp << "Total vertices: " << m->numberOfVertices << endl; 
 	Utils::printString(tmp.str(), outputFile.str(), CONFIG_PRINT_INFO_MESSAGES);
 	tmp.str("");	
@@ -954,18 +1121,24 @@ void *advanceTimeAndMovingMesh(void *arg)
         {            
             tmp << "Executando CMr.\n";          
             timeClock = clock();
-            m->cuthillMcKee(CONFIG_CUTHILL_MCKEE_REVERSE, UTILS_CM_PSEUDOPERIPHERAL);                
+            bool reordered = m->reorder(CONFIG_MESH_ORDERING, CONFIG_CUTHILL_MCKEE_REVERSE, UTILS_CM_PSEUDOPERIPHERAL);
             timeClock = clock() - timeClock;  
             ic = new InfoClock(m->numberOfVertices, timeClock);
             listClockCMr.push_back(ic);                 
+            if (reordered)
+                tmp << getInformationOrdering(m);
         }
+        if (CONFIG_RENUMBER_VERTICES)
+            m->renumberVertices(); // Vertices in contiguous memory in the order of the list
 	tmp << "Executando MGC.\n";
         timeClock = clock();        
-        numberOfIterationsCG = ConjugateGradient::solve( m->first, m->numberOfVertices, &CONFIG_CG_PRESICION_EPSILON); // Solve the mesh by Conjugate Gradient                                    
-	timeClock = timeClock - clock();
+        numberOfIterationsCG = ConjugateGradient::solve( m->first, m->numberOfVertices, &CONFIG_CG_PRESICION_EPSILON, &cgParameters, &cgHistory); // Solve the mesh by Conjugate Gradient                                    
+        timeClock = clock() - timeClock;
         ic = new InfoClock(m->numberOfVertices, timeClock);
         listClockCG.push_back(ic);   
+        listSolver.push_back(new InfoSolver(timeStep, "etapa temporal", m->numberOfVertices, &cgParameters, &cgHistory));
 	tmp << "Total iteracoes: " << numberOfIterationsCG << endl;
+	tmp << "Residuo final: " << cgHistory.getFinalResidual() << endl;
 	tmp << "Total vertices: " << m->numberOfVertices << endl;
 	Utils::printString(tmp.str(), outputFile.str(), CONFIG_PRINT_INFO_MESSAGES);
 	tmp.str("");	
@@ -990,6 +1163,16 @@ void *advanceTimeAndMovingMesh(void *arg)
     tmp << outputDir.str() << "/" << CONFIG_OUTPUT_FILE_QUALITY_MESH;    
     printInformationQualityMesh(listQualityMesh, tmp.str());  
     clearListOfQualityMesh(listQualityMesh);
+    if (CONFIG_PRINT_SOLVER_STATISTICS)
+    {
+	tmp.str("");
+	tmp << outputDir.str() << "/" << CONFIG_OUTPUT_FILE_SOLVER_CSV;
+	printInformationSolver(listSolver, tmp.str());
+	tmp.str("");
+	tmp << outputDir.str() << "/" << CONFIG_OUTPUT_FILE_SOLVER_JSON;
+	printInformationSolverJSON(listSolver, tmp.str());
+    }
+    clearListOfSolver(listSolver);
     // Print results to files
     if (CONFIG_PRINT_VERTEX_VALUE) 
     {
@@ -1052,7 +1235,7 @@ void nextTimeStep(Mesh *m, int &timeStep) {
 
 bool refinementCriterion(Adjacency *adjPtr)
 {
-    mpfr::real<MPFR_BITS_PRECISION> *distance = NULL, *gradient = NULL;
+    realNumber *distance = NULL, *gradient = NULL;
     Vertex *v0 = adjPtr->getVertex(ADJ_VERTEX_ONE);
     Vertex *v1 = adjPtr->getVertex(ADJ_VERTEX_TWO);
     distance   = Utils::distance(v0, v1);
@@ -1066,7 +1249,7 @@ bool refinementCriterion(Adjacency *adjPtr)
 
 bool refinementTriangleCriterion(Triangle *t)
 {
-    mpfr::real<MPFR_BITS_PRECISION> *distance = NULL, *gradient = NULL;
+    realNumber *distance = NULL, *gradient = NULL;
     Vertex *v0 = t->getVertex(TRIANGLE_VERTEX_ONE);
     Vertex *v1 = t->getVertex(TRIANGLE_VERTEX_TWO);
     Vertex *v2 = t->getVertex(TRIANGLE_VERTEX_THREE);
@@ -1099,7 +1282,7 @@ bool refinementTriangleCriterion(Triangle *t)
 
 bool refinementDistanceCriterion(Adjacency *adjPtr)
 {
-    mpfr::real<MPFR_BITS_PRECISION> *distance = NULL;
+    realNumber *distance = NULL;
     Vertex *v0 = adjPtr->getVertex(ADJ_VERTEX_ONE);
     Vertex *v1 = adjPtr->getVertex(ADJ_VERTEX_TWO);
     distance   = Utils::distance(v0, v1);
@@ -1110,7 +1293,7 @@ bool refinementDistanceCriterion(Adjacency *adjPtr)
 
 Triangle *getTriangle(Adjacency *adjPtr)
 {
-    mpfr::real<MPFR_BITS_PRECISION> diff_t0 = 0, diff_t1 = 0;
+    realNumber diff_t0 = 0, diff_t1 = 0;
     int number_ve0_t0 = 0, number_ve1_t0 = 0, number_ve0_t1 = 0, number_ve1_t1 = 0;
     Triangle *t0 = adjPtr->getTriangle(ADJ_VERTEX_ONE);
     Triangle *t1 = adjPtr->getTriangle(ADJ_VERTEX_TWO);
@@ -1177,417 +1360,386 @@ void setInitialBoundaryConditions(Vertex *vPtr)
     }    
 }
 
-bool isOutOfDomain(mpfr::real<MPFR_BITS_PRECISION> &x, mpfr::real<MPFR_BITS_PRECISION> &y ) 
+bool isOutOfDomain(realNumber &x, realNumber &y ) 
 {
     if ( ( x < 0 ) || ( x > CONFIG_DOMAIN_DIMENSION) || ( y < 0 ) || ( y > CONFIG_DOMAIN_DIMENSION) ) 
 	return true;  
     return false;
 }
 
-bool monitorFunctionUpsilon(Mesh *m) 
-{        
-    // New values
-    list<InfoMovingVertex *> verticesToMoveList;  // List containing data of vertices to move     
-    Vertex *vertexIterator = m->first;
-    bool mov = false;
-    while( vertexIterator != NULL ) 
-    {                    
-        vertexIterator->visited = true;
-        if (!vertexIterator->isBorder) 
-        {            
-            mpfr::real<MPFR_BITS_PRECISION> sum_x_total = 0, sum_y_total = 0, sum_u_total = 0;                           
-            // Calculates weights
-	    calculatesWeightUpsilon(vertexIterator, sum_x_total, sum_y_total, sum_u_total);                      
-            // New coordinates of monitor function
-            mpfr::real<MPFR_BITS_PRECISION> *newCoordinates = new mpfr::real<MPFR_BITS_PRECISION>[2];          
-            newCoordinates[COORDINATE_X] = vertexIterator->x + (CONFIG_MONITOR_FUNCTION_BETA * sum_x_total) /sum_u_total ;
-            newCoordinates[COORDINATE_Y] = vertexIterator->y + (CONFIG_MONITOR_FUNCTION_BETA * sum_y_total) /sum_u_total ;                           
-            if ( !isOutOfDomain( newCoordinates[COORDINATE_X] , newCoordinates[COORDINATE_Y] ) )
-            {
-		if ( (!mov) && (newCoordinates[COORDINATE_X] != vertexIterator->x) && (newCoordinates[COORDINATE_Y] != vertexIterator->y) ) mov = true;
-                // Print vertex movement for analysis
-                if (CONFIG_PRINT_VERTEX_MOVIMENT)
-                    Utils::printVertexMovement(vertexIterator,newCoordinates[COORDINATE_X], newCoordinates[COORDINATE_Y], CONFIG_OUTPUT_FILE_VERTEX_MOVIMENT);            
-                // Creates an object containing Information to move the vertex, and inserts this object in the list of moved vertices.
-                verticesToMoveList.push_back( createInfoMovingVertex(vertexIterator, newCoordinates) );                
-            } else 
-            {
-                delete[] newCoordinates;
-                //cerr << "ERROR - Mesh::movingMesh: new coordinate out of domain. " << endl;                      
-            }
+//
+// Weights of the monitor functions, policies of moveByWeight(). operator()(v, neighbor, edge, w) sets the weight w of the
+// edge between the vertex v and its neighbor and returns true if the edge requires v to move; v moves if any of its edges
+// requires. normalization(sum) is the denominator of the weighted average, given the sum of the weights of v.
+//
+/**
+ * Weight |u_i - u_c|, normalized by the largest difference of u over the edges (monitorFunctionLambda())
+ */
+class WeightLambda
+{
+public:
+    realNumber u_max;
+    bool operator()(Vertex *v, Vertex *neighbor, Adjacency *edge, realNumber &w) const
+    {
+        w = abs( neighbor->u - v->u );
+        return true;
+    }
+    const realNumber &normalization(const realNumber &sum) const
+    {
+        return u_max;
+    }
+};
+/**
+ * Weight |u_i - u_c| (monitorFunctionGamma(), monitorFunctionXi() and monitorFunctionPsi())
+ */
+class WeightGamma
+{
+public:
+    bool operator()(Vertex *v, Vertex *neighbor, Adjacency *edge, realNumber &w) const
+    {
+        w = abs( neighbor->u - v->u );
+        return true;
+    }
+    const realNumber &normalization(const realNumber &sum) const
+    {
+        return sum;
+    }
+};
+/**
+ * Weight |u_i - u_c| / |u_i + u_c| (monitorFunctionUpsilon())
+ */
+class WeightUpsilon
+{
+public:
+    bool operator()(Vertex *v, Vertex *neighbor, Adjacency *edge, realNumber &w) const
+    {
+        w = abs( neighbor->u - v->u ) / abs( neighbor->u + v->u );
+        return true;
+    }
+    const realNumber &normalization(const realNumber &sum) const
+    {
+        return sum;
+    }
+};
+/**
+ * Weight |q_1 + q_2|, the qualities of the triangles of the edge; only the vertices of a triangle of quality above eta
+   move (laplacianSmoothing())
+ */
+class WeightLaplacianSmoothing
+{
+public:
+    bool operator()(Vertex *v, Vertex *neighbor, Adjacency *edge, realNumber &w) const
+    {
+        Triangle *t1 = edge->getTriangle(ADJ_TRIANGLE_ONE);
+        Triangle *t2 = edge->getTriangle(ADJ_TRIANGLE_TWO);
+        w = abs( (t1->shapeRegularityQuality) + (t2->shapeRegularityQuality) );
+        return (t1->shapeRegularityQuality > eta) || (t2->shapeRegularityQuality > eta);
+    }
+    const realNumber &normalization(const realNumber &sum) const
+    {
+        return sum;
+    }
+};
+
+double getMaximumDisplacement(Mesh *m)
+{
+    // Position of each displaced vertex before the movement: the first displacement of a vertex displaced twice
+    map<Vertex *, size_t> origin;
+    for (size_t i = m->movedVertices.size(); i > 0; i--)
+        origin[m->movedVertices[i - 1]] = i - 1;
+    realNumber maximum = 0;
+    for (map<Vertex *, size_t>::iterator it = origin.begin(); it != origin.end(); ++it)
+    {
+        realNumber dx = it->first->x - m->previousCoordinates[2*it->second + COORDINATE_X],
+                   dy = it->first->y - m->previousCoordinates[2*it->second + COORDINATE_Y],
+                   distanceSQR = dx*dx + dy*dy;
+        if (distanceSQR > maximum)
+            maximum = distanceSQR;
+    }
+    double displacement = 0;
+    maximum.conv(displacement);
+    return sqrt(displacement);
+}
+
+int accelerateMovement(Mesh *m, AndersonMixing &anderson)
+{
+    // Position of each displaced vertex before the movement: the first displacement of a vertex displaced twice
+    map<Vertex *, size_t> origin;
+    for (size_t i = m->movedVertices.size(); i > 0; i--)
+        origin[m->movedVertices[i - 1]] = i - 1;
+    // g = G(x), the positions after the movement, and f = G(x) - x, in the order of the internal vertices in the list
+    vector<Vertex *> vertices;
+    vector<double> g, f, correction;
+    for (Vertex *v = m->first; v != NULL; v = v->next)
+    {
+        if (v->isBorder)
+            continue;
+        vertices.push_back(v);
+        double x = 0, y = 0, dx = 0, dy = 0;
+        v->x.conv(x);
+        v->y.conv(y);
+        map<Vertex *, size_t>::iterator it = origin.find(v);
+        if (it != origin.end())
+        {
+            realNumber displacementX = v->x - m->previousCoordinates[2*it->second + COORDINATE_X],
+                       displacementY = v->y - m->previousCoordinates[2*it->second + COORDINATE_Y];
+            displacementX.conv(dx);
+            displacementY.conv(dy);
+        }
+        g.push_back(x);
+        g.push_back(y);
+        f.push_back(dx);
+        f.push_back(dy);
+    }
+    if ( !anderson.mix(g, f, correction) )
+        return 0;
+    // Accelerated positions: a vertex that would leave the domain keeps G(x)
+    vector<Vertex *> accelerated;
+    vector<realNumber> positions; // positions[2*k + COORDINATE_X] and [2*k + COORDINATE_Y] of accelerated[k]
+    for (size_t i = 0; i < vertices.size(); i++)
+    {
+        if ( (correction[2*i + COORDINATE_X] == 0) && (correction[2*i + COORDINATE_Y] == 0) )
+            continue;
+        realNumber x = vertices[i]->x + correction[2*i + COORDINATE_X],
+                   y = vertices[i]->y + correction[2*i + COORDINATE_Y];
+        if ( isOutOfDomain(x, y) )
+            continue;
+        accelerated.push_back(vertices[i]);
+        positions.push_back(x);
+        positions.push_back(y);
+    }
+    // Safeguard: the accelerated displacements that invert triangles are damped or reverted, as the ones of a movement
+    vector<Vertex *> movedVertices;
+    vector<realNumber> previousCoordinates;
+    movedVertices.swap(m->movedVertices);
+    previousCoordinates.swap(m->previousCoordinates);
+    for (size_t k = 0; k < accelerated.size(); k++)
+    {
+        m->movedVertices.push_back(accelerated[k]);
+        m->previousCoordinates.push_back(accelerated[k]->x);
+        m->previousCoordinates.push_back(accelerated[k]->y);
+        accelerated[k]->setXY(positions[2*k + COORDINATE_X], positions[2*k + COORDINATE_Y]);
+    }
+    bool valid = false;
+    if (!accelerated.empty())
+    {
+        m->updateMovedTriangles(false);
+        m->repairMovedTriangles(valid);
+    }
+    if ( (valid) && (eta > 0) )
+    {
+        // Safeguard: the acceleration must not lower the quality of the mesh below eta, which would end the movements
+        realNumber *quality = Utils::shapeRegularityQualityMesh(*m);
+        if (*quality < eta)
+        {
+            for (size_t k = 0; k < m->movedVertices.size(); k++)
+                m->movedVertices[k]->setXY(m->previousCoordinates[2*k + COORDINATE_X], m->previousCoordinates[2*k + COORDINATE_Y]);
+            m->updateMovedTriangles(false);
+            valid = false;
+        }
+        delete quality;
+    }
+    if (!valid)
+        anderson.clear();
+    // Displacements of the movement followed by the ones of the acceleration, if it was not reverted
+    if (valid)
+    {
+        movedVertices.insert(movedVertices.end(), m->movedVertices.begin(), m->movedVertices.end());
+        previousCoordinates.insert(previousCoordinates.end(), m->previousCoordinates.begin(), m->previousCoordinates.end());
+    }
+    movedVertices.swap(m->movedVertices);
+    previousCoordinates.swap(m->previousCoordinates);
+    return valid ? (int) accelerated.size() : 0;
+}
+
+/**
+ * Workspace of a sweep of moveByWeight(), shared by its threads
+ */
+template <class Weight> class MovingMeshSweep
+{
+public:
+    const Weight *weight;
+    float step;
+    int numberOfThreads;
+    vector<Vertex *> vertices;           // Internal vertices, in the order of the list
+    vector<realNumber> newCoordinates;   // newCoordinates[2*k + COORDINATE_X] and [2*k + COORDINATE_Y] of vertices[k], the old ones after the update
+    vector<char> moved;                  // vertices[k] moves: required by its edges, new coordinates inside the domain and different from the old ones
+    vector<char> movPartial;             // Some vertex of the block of the thread changed both coordinates
+    pthread_barrier_t barrier;
+};
+/**
+ * Argument of moveByWeightWorker(): workspace and number of the thread
+ */
+template <class Weight> class MovingMeshWorkerArgument
+{
+public:
+    MovingMeshSweep<Weight> *sweep;
+    int thread;
+};
+
+template <class Weight> void *moveByWeightWorker(void *arg)
+{
+    MovingMeshWorkerArgument<Weight> *argData = (MovingMeshWorkerArgument<Weight> *) arg;
+    MovingMeshSweep<Weight> &sweep = *(argData->sweep);
+    int t = argData->thread, n = (int) sweep.vertices.size(),
+        first = (int) ( ( (long) n * t ) / sweep.numberOfThreads ),
+        last  = (int) ( ( (long) n * (t + 1) ) / sweep.numberOfThreads );
+    realNumber w = 0;
+    for (int k = first; k < last; k++)
+    {
+        Vertex *v = sweep.vertices[k];
+        realNumber sum_x_total = 0, sum_y_total = 0, sum_u_total = 0;
+        bool move = false;
+        for (list<Adjacency *>::iterator it = v->adjList.begin(); it != v->adjList.end(); it++)
+        {
+            Vertex *vertexAdj = (*it)->getVertex( ( (*it)->getVertex(ADJ_VERTEX_ONE) == v ) ? ADJ_VERTEX_TWO : ADJ_VERTEX_ONE );
+            if ((*sweep.weight)(v, vertexAdj, *it, w))
+                move = true;
+            sum_x_total += ( vertexAdj->x - v->x ) * w; // Sum of (x_i - x_c) w_i
+            sum_y_total += ( vertexAdj->y - v->y ) * w; // Sum of (y_i - y_c) w_i
+            sum_u_total += w;
+        }
+        sweep.moved[k] = false;
+        if (!move)
+            continue;
+        // New coordinates of monitor function
+        realNumber &x = sweep.newCoordinates[2*k + COORDINATE_X],
+                   &y = sweep.newCoordinates[2*k + COORDINATE_Y];
+        x = v->x + (sweep.step * sum_x_total) / sweep.weight->normalization(sum_u_total);
+        y = v->y + (sweep.step * sum_y_total) / sweep.weight->normalization(sum_u_total);
+        if ( isOutOfDomain(x, y) || ( (x == v->x) && (y == v->y) ) )
+            continue;
+        sweep.moved[k] = true;
+        if ( (x != v->x) && (y != v->y) ) sweep.movPartial[t] = true;
+    }
+    // All the new coordinates are computed from the old ones
+    pthread_barrier_wait(&sweep.barrier);
+    if (CONFIG_PRINT_VERTEX_MOVIMENT)
+    {
+        // Print vertex movement for analysis, in the order of the list
+        if (t == 0)
+        {
+            for (int k = 0; k < n; k++)
+                if (sweep.moved[k])
+                    Utils::printVertexMovement(sweep.vertices[k], sweep.newCoordinates[2*k + COORDINATE_X], sweep.newCoordinates[2*k + COORDINATE_Y], CONFIG_OUTPUT_FILE_VERTEX_MOVIMENT);
+        }
+        pthread_barrier_wait(&sweep.barrier);
+    }
+    // Update vertices coordinates, keeping the old ones
+    for (int k = first; k < last; k++)
+    {
+        if (sweep.moved[k])
+        {
+            Vertex *v = sweep.vertices[k];
+            realNumber x = v->x, y = v->y;
+            v->setXY( sweep.newCoordinates[2*k + COORDINATE_X], sweep.newCoordinates[2*k + COORDINATE_Y] );
+            sweep.newCoordinates[2*k + COORDINATE_X] = x;
+            sweep.newCoordinates[2*k + COORDINATE_Y] = y;
+        }
+    }
+    return NULL;
+}
+
+template <class Weight> bool moveByWeight(Mesh *m, const Weight &weight, float step)
+{
+    MovingMeshSweep<Weight> sweep;
+    sweep.weight = &weight;
+    sweep.step   = step;
+    sweep.vertices.reserve(m->numberOfVertices);
+    for (Vertex *v = m->first; v != NULL; v = v->next)
+        if (!v->isBorder)
+            sweep.vertices.push_back(v);
+    sweep.numberOfThreads = max(1, min(CONFIG_MOVING_MESH_THREADS, (int) sweep.vertices.size()));
+    sweep.newCoordinates.resize(2 * sweep.vertices.size());
+    sweep.moved.resize(sweep.vertices.size());
+    sweep.movPartial.assign(sweep.numberOfThreads, false);
+    pthread_barrier_init(&sweep.barrier, NULL, sweep.numberOfThreads);
+    vector< MovingMeshWorkerArgument<Weight> > arguments(sweep.numberOfThreads);
+    vector<pthread_t> threads(sweep.numberOfThreads);
+    for (int t = 0; t < sweep.numberOfThreads; t++)
+    {
+        arguments[t].sweep  = &sweep;
+        arguments[t].thread = t;
+    }
+    for (int t = 1; t < sweep.numberOfThreads; t++)
+    {
+        if (pthread_create(&threads[t], NULL, &moveByWeightWorker<Weight>, (void *) &arguments[t]) != 0)
+        {
+            cerr << "ERROR - moveByWeight - could not create thread " << t << "." << endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+    moveByWeightWorker<Weight>( (void *) &arguments[0] );
+    for (int t = 1; t < sweep.numberOfThreads; t++)
+        pthread_join(threads[t], NULL);
+    pthread_barrier_destroy(&sweep.barrier);
+    // Displaced vertices, whose triangles are updated, and their positions before the sweep
+    for (size_t k = 0; k < sweep.vertices.size(); k++)
+    {
+        if (sweep.moved[k])
+        {
+            m->movedVertices.push_back(sweep.vertices[k]);
+            m->previousCoordinates.push_back(sweep.newCoordinates[2*k + COORDINATE_X]);
+            m->previousCoordinates.push_back(sweep.newCoordinates[2*k + COORDINATE_Y]);
         }
-        vertexIterator = vertexIterator->next;        
-    }             
-    moveVertices(verticesToMoveList);        
+    }
+    // Reduction of the threads
+    bool mov = false;
+    for (int t = 0; t < sweep.numberOfThreads; t++)
+        if (sweep.movPartial[t])
+            mov = true;
     return mov;
 }
 
+bool monitorFunctionUpsilon(Mesh *m) 
+{        
+    return moveByWeight(m, WeightUpsilon(), CONFIG_MONITOR_FUNCTION_BETA);
+}
+
 bool monitorFunctionLambda(Mesh *m) 
 {  
-    // New values
-    list<InfoMovingVertex *> verticesToMoveList;  // List containing data of vertices to move         
-    bool mov = false;
-    mpfr::real<MPFR_BITS_PRECISION> u_max = 0;
+    WeightLambda weight;
+    weight.u_max = 0;
     for (list<Adjacency *>::iterator it = m->edges.begin(); it != m->edges.end(); ++it)
     {        
         Vertex *v1 = (*it)->getVertex(ADJ_VERTEX_ONE);
         Vertex *v2 = (*it)->getVertex(ADJ_VERTEX_TWO);	
-	if ( abs(v1->u - v2->u)  > u_max )  
-	  u_max = abs(v1->u - v2->u);
+	if ( abs(v1->u - v2->u)  > weight.u_max )  
+	  weight.u_max = abs(v1->u - v2->u);
     }      
-    Vertex *vertexIterator = m->first;
-    while( vertexIterator != NULL ) 
-    {                    
-        if (!vertexIterator->isBorder) 
-        {                   
-            mpfr::real<MPFR_BITS_PRECISION> sum_x_total = 0, sum_y_total = 0, sum_u_total = 0;                           
-            // Calculates weights
-	    calculatesWeightLambda(vertexIterator, sum_x_total, sum_y_total);                   
-            // New coordinates of monitor function
-            mpfr::real<MPFR_BITS_PRECISION> *newCoordinates = new mpfr::real<MPFR_BITS_PRECISION>[2];          
-            newCoordinates[COORDINATE_X] = vertexIterator->x + (CONFIG_MONITOR_FUNCTION_BETA* sum_x_total)/u_max;
-            newCoordinates[COORDINATE_Y] = vertexIterator->y + (CONFIG_MONITOR_FUNCTION_BETA* sum_y_total)/u_max;               
-            if ( !isOutOfDomain( newCoordinates[COORDINATE_X] , newCoordinates[COORDINATE_Y] ) )
-            {
-	        if ( (!mov) && (newCoordinates[COORDINATE_X] != vertexIterator->x) && (newCoordinates[COORDINATE_Y] != vertexIterator->y) ) mov = true;
-                // Print vertex movement for analysis
-                if (CONFIG_PRINT_VERTEX_MOVIMENT)
-                    Utils::printVertexMovement(vertexIterator,newCoordinates[COORDINATE_X], newCoordinates[COORDINATE_Y], CONFIG_OUTPUT_FILE_VERTEX_MOVIMENT);            
-                // Creates an object containing Information to move the vertex, and inserts this object in the list of moved vertices.
-                verticesToMoveList.push_back( createInfoMovingVertex(vertexIterator, newCoordinates) );                               
-            } else 
-            {
-                delete[] newCoordinates;
-                //cerr << "ERROR - Mesh::movingMesh: new coordinate out of domain. " << endl;                      
-            }
-        }
-        vertexIterator = vertexIterator->next;        
-    }             
-    moveVertices(verticesToMoveList);        
-    return mov;
+    return moveByWeight(m, weight, CONFIG_MONITOR_FUNCTION_BETA);
 }
 
 bool monitorFunctionGamma(Mesh *m) 
 {        
-    // New values
-    list<InfoMovingVertex *> verticesToMoveList;  // List containing data of vertices to move     
-    Vertex *vertexIterator = m->first;
-    bool mov = false;
-    while( vertexIterator != NULL ) 
-    {                    
-        if (!vertexIterator->isBorder) 
-        {            
-            mpfr::real<MPFR_BITS_PRECISION> sum_x_total = 0, sum_y_total = 0, sum_u_total = 0;                           
-            // Calculates weights
-	    calculatesWeightGamma(vertexIterator, sum_x_total, sum_y_total, sum_u_total);                                                         
-            // New coordinates of monitor function
-            mpfr::real<MPFR_BITS_PRECISION> *newCoordinates = new mpfr::real<MPFR_BITS_PRECISION>[2];          
-            newCoordinates[COORDINATE_X] = vertexIterator->x + (CONFIG_MONITOR_FUNCTION_BETA * sum_x_total) /sum_u_total ;
-            newCoordinates[COORDINATE_Y] = vertexIterator->y + (CONFIG_MONITOR_FUNCTION_BETA * sum_y_total) /sum_u_total ;                           
-	    if ( !isOutOfDomain( newCoordinates[COORDINATE_X] , newCoordinates[COORDINATE_Y] ) )
-	    {
-	        if ( (!mov) && (newCoordinates[COORDINATE_X] != vertexIterator->x) && (newCoordinates[COORDINATE_Y] != vertexIterator->y) ) mov = true;
-                // Print vertex movement for analysis
-                if (CONFIG_PRINT_VERTEX_MOVIMENT)
-                    Utils::printVertexMovement(vertexIterator,newCoordinates[COORDINATE_X], newCoordinates[COORDINATE_Y], CONFIG_OUTPUT_FILE_VERTEX_MOVIMENT);            
-                // Creates an object containing Information to move the vertex, and inserts this object in the list of moved vertices.
-                verticesToMoveList.push_back( createInfoMovingVertex(vertexIterator, newCoordinates) );                
-            } else 
-            {
-                delete[] newCoordinates;
-                //cerr << "ERROR - Mesh::movingMesh: new coordinate out of domain. " << endl;                      
-            }
-        }
-        vertexIterator = vertexIterator->next;        
-    }             
-    moveVertices(verticesToMoveList); 
-    return mov;
+    return moveByWeight(m, WeightGamma(), CONFIG_MONITOR_FUNCTION_BETA);
 }
 //
 // Laplacian Smoothing called Xi defined by Taubin
 //
 bool monitorFunctionXi(Mesh *m) 
 {        
-    // New values
-    list<InfoMovingVertex *> verticesToMoveList;  // List containing data of vertices to move     
-    Vertex *vertexIterator = m->first;
-    bool movBeta = false, movMu = false;
-    mpfr::real<MPFR_BITS_PRECISION> *newCoordinates = NULL;
-    while( vertexIterator != NULL ) 
-    {                    
-        if (!vertexIterator->isBorder) 
-        {            
-            mpfr::real<MPFR_BITS_PRECISION> sum_x_total = 0, sum_y_total = 0, sum_u_total = 0;                           
-            // Calculates weights
-	    calculatesWeightGamma(vertexIterator, sum_x_total, sum_y_total, sum_u_total);                             
-            // New coordinates of monitor function
-            newCoordinates = new mpfr::real<MPFR_BITS_PRECISION>[2];          
-            newCoordinates[COORDINATE_X] = vertexIterator->x + (CONFIG_MONITOR_FUNCTION_BETA * sum_x_total) /sum_u_total ;
-            newCoordinates[COORDINATE_Y] = vertexIterator->y + (CONFIG_MONITOR_FUNCTION_BETA * sum_y_total) /sum_u_total ;                           
-            if ( !isOutOfDomain( newCoordinates[COORDINATE_X] , newCoordinates[COORDINATE_Y] ) )
-            {
-	        if ( (!movBeta) && (newCoordinates[COORDINATE_X] != vertexIterator->x) && (newCoordinates[COORDINATE_Y] != vertexIterator->y) ) movBeta = true;
-                // Print vertex movement for analysis
-                if (CONFIG_PRINT_VERTEX_MOVIMENT)
-                    Utils::printVertexMovement(vertexIterator,newCoordinates[COORDINATE_X], newCoordinates[COORDINATE_Y], CONFIG_OUTPUT_FILE_VERTEX_MOVIMENT);            
-                // Creates an object containing Information to move the vertex, and inserts this object in the list of moved vertices.
-                verticesToMoveList.push_back( createInfoMovingVertex(vertexIterator, newCoordinates) );                
-            } else 
-            {
-                delete[] newCoordinates;
-                //cerr << "ERROR - Mesh::movingMesh: new coordinate out of domain. " << endl;                      
-            }
-        }
-        vertexIterator = vertexIterator->next;        
-    }     
-    moveVertices(verticesToMoveList);   
-    vertexIterator = m->first;
-    while( vertexIterator != NULL ) 
-    {                    
-        if (!vertexIterator->isBorder) 
-        {            
-            mpfr::real<MPFR_BITS_PRECISION> sum_x_total = 0, sum_y_total = 0, sum_u_total = 0;                           
-            // Calculates weights
-	    calculatesWeightGamma(vertexIterator, sum_x_total, sum_y_total, sum_u_total);                             
-            // New coordinates of monitor function
-            newCoordinates = new mpfr::real<MPFR_BITS_PRECISION>[2];          
-            newCoordinates[COORDINATE_X] = vertexIterator->x - (CONFIG_MONITOR_FUNCTION_MU * sum_x_total) /sum_u_total ;
-            newCoordinates[COORDINATE_Y] = vertexIterator->y - (CONFIG_MONITOR_FUNCTION_MU * sum_y_total) /sum_u_total ;                           
-            if ( !isOutOfDomain( newCoordinates[COORDINATE_X] , newCoordinates[COORDINATE_Y] ) )
-            {
-	        if ( (!movMu) && (newCoordinates[COORDINATE_X] != vertexIterator->x) && (newCoordinates[COORDINATE_Y] != vertexIterator->y) ) movMu = true;
-                // Print vertex movement for analysis
-                if (CONFIG_PRINT_VERTEX_MOVIMENT)
-                    Utils::printVertexMovement(vertexIterator,newCoordinates[COORDINATE_X], newCoordinates[COORDINATE_Y], CONFIG_OUTPUT_FILE_VERTEX_MOVIMENT);            
-                // Creates an object containing Information to move the vertex, and inserts this object in the list of moved vertices.
-                verticesToMoveList.push_back( createInfoMovingVertex(vertexIterator, newCoordinates) );                
-            } else 
-            {
-                delete[] newCoordinates;
-                //cerr << "ERROR - Mesh::movingMesh: new coordinate out of domain. " << endl;                      
-            }
-        }
-        vertexIterator = vertexIterator->next;        
-    }      
-    moveVertices(verticesToMoveList);
+    bool movBeta = moveByWeight(m, WeightGamma(), CONFIG_MONITOR_FUNCTION_BETA);
+    bool movMu   = moveByWeight(m, WeightGamma(), -CONFIG_MONITOR_FUNCTION_MU);
     return movBeta && movMu;
 }
 
 bool monitorFunctionPsi(Mesh *m) 
 {  
-     // New values
-    list<InfoMovingVertex *> verticesToMoveList;  // List containing data of vertices to move     
-    Vertex *vertexIterator = m->first;
-    bool movBeta = false, movMu = false;
-    mpfr::real<MPFR_BITS_PRECISION> *newCoordinates = NULL;
-    while( vertexIterator != NULL ) 
-    {                    
-        if (!vertexIterator->isBorder) 
-        {            
-            mpfr::real<MPFR_BITS_PRECISION> sum_x_total = 0, sum_y_total = 0, sum_u_total = 0;                           
-            // Calculates weights
-	    calculatesWeightGamma(vertexIterator, sum_x_total, sum_y_total, sum_u_total);                             
-            // New coordinates of monitor function
-            newCoordinates = new mpfr::real<MPFR_BITS_PRECISION>[2];          
-            newCoordinates[COORDINATE_X] = vertexIterator->x + (CONFIG_MONITOR_FUNCTION_BETA * sum_x_total) /sum_u_total ;
-            newCoordinates[COORDINATE_Y] = vertexIterator->y + (CONFIG_MONITOR_FUNCTION_BETA * sum_y_total) /sum_u_total ;                           
-            if ( !isOutOfDomain( newCoordinates[COORDINATE_X] , newCoordinates[COORDINATE_Y] ) )
-            {
-	        if ( (!movBeta) && (newCoordinates[COORDINATE_X] != vertexIterator->x) && (newCoordinates[COORDINATE_Y] != vertexIterator->y) ) movBeta = true;
-                // Print vertex movement for analysis
-                if (CONFIG_PRINT_VERTEX_MOVIMENT)
-                    Utils::printVertexMovement(vertexIterator,newCoordinates[COORDINATE_X], newCoordinates[COORDINATE_Y], CONFIG_OUTPUT_FILE_VERTEX_MOVIMENT);            
-                // Creates an object containing Information to move the vertex, and inserts this object in the list of moved vertices.
-                verticesToMoveList.push_back( createInfoMovingVertex(vertexIterator, newCoordinates) );                
-            } else 
-            {
-                delete[] newCoordinates;
-                //cerr << "ERROR - Mesh::movingMesh: new coordinate out of domain. " << endl;                      
-            }
-        }
-        vertexIterator = vertexIterator->next;        
-    }     
-    moveVertices(verticesToMoveList);   
-    vertexIterator = m->first;
-    while( vertexIterator != NULL ) 
-    {                    
-        if (!vertexIterator->isBorder) 
-        {            
-            mpfr::real<MPFR_BITS_PRECISION> sum_x_total = 0, sum_y_total = 0, sum_u_total = 0;                           
-            // Calculates weights
-	    calculatesWeightGamma(vertexIterator, sum_x_total, sum_y_total, sum_u_total);                             
-            // New coordinates of monitor function
-            newCoordinates = new mpfr::real<MPFR_BITS_PRECISION>[2];          
-            newCoordinates[COORDINATE_X] = vertexIterator->x - (CONFIG_MONITOR_FUNCTION_BETA * sum_x_total) /sum_u_total ;
-            newCoordinates[COORDINATE_Y] = vertexIterator->y - (CONFIG_MONITOR_FUNCTION_BETA * sum_y_total) /sum_u_total ;                           
-            if ( !isOutOfDomain( newCoordinates[COORDINATE_X] , newCoordinates[COORDINATE_Y] ) )
-            {
-	        if ( (!movMu) && (newCoordinates[COORDINATE_X] != vertexIterator->x) && (newCoordinates[COORDINATE_Y] != vertexIterator->y) ) movMu = true;
-                // Print vertex movement for analysis
-                if (CONFIG_PRINT_VERTEX_MOVIMENT)
-                    Utils::printVertexMovement(vertexIterator,newCoordinates[COORDINATE_X], newCoordinates[COORDINATE_Y], CONFIG_OUTPUT_FILE_VERTEX_MOVIMENT);            
-                // Creates an object containing Information to move the vertex, and inserts this object in the list of moved vertices.
-                verticesToMoveList.push_back( createInfoMovingVertex(vertexIterator, newCoordinates) );                
-            } else 
-            {
-                delete[] newCoordinates;
-                //cerr << "ERROR - Mesh::movingMesh: new coordinate out of domain. " << endl;                      
-            }
-        }
-        vertexIterator = vertexIterator->next;        
-    }      
-    moveVertices(verticesToMoveList);
+    bool movBeta = moveByWeight(m, WeightGamma(), CONFIG_MONITOR_FUNCTION_BETA);
+    bool movMu   = moveByWeight(m, WeightGamma(), -CONFIG_MONITOR_FUNCTION_BETA);
     return movBeta && movMu;
 }
 
 bool laplacianSmoothing(Mesh *m) 
 {        
-    // New values
-    list<InfoMovingVertex *> verticesToMoveList;  // List containing data of vertices to move     
-    Vertex *vertexIterator = m->first;
-    bool mov = false;
-    while( vertexIterator != NULL ) 
-    {    
-        if (!vertexIterator->isBorder) 
-        {            
-	    bool badQuality = false;
-            mpfr::real<MPFR_BITS_PRECISION> sum_x_total = 0, sum_y_total = 0, sum_u_total = 0;                           
-            // Calculates weights
-	    badQuality = calculatesWeightLaplacianSmoothing(vertexIterator, sum_x_total, sum_y_total, sum_u_total);                                                         
-	    if (badQuality) 
-	    {
-		// New coordinates of monitor function
-		mpfr::real<MPFR_BITS_PRECISION> *newCoordinates = new mpfr::real<MPFR_BITS_PRECISION>[2];          
-		newCoordinates[COORDINATE_X] = vertexIterator->x + (CONFIG_LAPLACIAN_SMOOTHING_KAPA * sum_x_total) /sum_u_total ;
-		newCoordinates[COORDINATE_Y] = vertexIterator->y + (CONFIG_LAPLACIAN_SMOOTHING_KAPA * sum_y_total) /sum_u_total ;                           
-		if ( !isOutOfDomain( newCoordinates[COORDINATE_X] , newCoordinates[COORDINATE_Y] ) )
-		{
-		    if ( (!mov) && (newCoordinates[COORDINATE_X] != vertexIterator->x) && (newCoordinates[COORDINATE_Y] != vertexIterator->y) ) mov = true;
-		    // Print vertex movement for analysis
-		    if (CONFIG_PRINT_VERTEX_MOVIMENT)
-			Utils::printVertexMovement(vertexIterator,newCoordinates[COORDINATE_X], newCoordinates[COORDINATE_Y], CONFIG_OUTPUT_FILE_VERTEX_MOVIMENT);            
-		    // Creates an object containing Information to move the vertex, and inserts this object in the list of moved vertices.
-		    verticesToMoveList.push_back( createInfoMovingVertex(vertexIterator, newCoordinates) );                
-		} else 
-		{
-		    delete[] newCoordinates;
-		    //cerr << "ERROR - Mesh::movingMesh: new coordinate out of domain. " << endl;                      
-		}	   	      
-	    }   
-        }
-        vertexIterator = vertexIterator->next;        
-    }             
-    moveVertices(verticesToMoveList); 
-    for( list<Triangle *>::iterator it = m->triangleList.begin(); it != m->triangleList.end(); ++it )   
-        (*it)->update();       
+    m->movedVertices.clear();
+    m->previousCoordinates.clear();
+    bool mov = moveByWeight(m, WeightLaplacianSmoothing(), CONFIG_LAPLACIAN_SMOOTHING_KAPA);
+    m->updateMovedTriangles(true);
     return mov;
 }
 
-void calculatesWeightLambda(Vertex *v, mpfr::real<MPFR_BITS_PRECISION> &sum_x_total, mpfr::real<MPFR_BITS_PRECISION> &sum_y_total) 
-{
-    sum_x_total = 0;
-    sum_y_total = 0;
-    mpfr::real<MPFR_BITS_PRECISION> sub_xi_xc = 0, sub_yi_yc = 0, sub_ui_uc = 0, sum_ui_uc = 0;                    
-    // Calc new coordinates
-    for( list<Adjacency *>::iterator it = v->adjList.begin(); it != v->adjList.end(); it++ )
-    {  
-	int vertexNumber = ADJ_VERTEX_ONE;
-	vertexNumber = ( (*it)->getVertex(ADJ_VERTEX_ONE) == v ) ? ADJ_VERTEX_TWO : ADJ_VERTEX_ONE;                
-	sub_xi_xc = ((*it)->getVertex(vertexNumber)->x - v->x );
-	sub_yi_yc = ((*it)->getVertex(vertexNumber)->y - v->y );
-	sub_ui_uc = abs((*it)->getVertex(vertexNumber)->u - v->u );       
-	sum_ui_uc = abs((*it)->getVertex(vertexNumber)->u + v->u );       
-	sum_x_total += sub_xi_xc * sub_ui_uc ;
-	sum_y_total += sub_yi_yc * sub_ui_uc ;
-    }  
-}
-
-void calculatesWeightGamma(Vertex *v, mpfr::real<MPFR_BITS_PRECISION> &sum_x_total, mpfr::real<MPFR_BITS_PRECISION> &sum_y_total, mpfr::real<MPFR_BITS_PRECISION> &sum_u_total) 
-{
-    sum_x_total = 0;
-    sum_x_total = 0;
-    sum_u_total = 0;
-    mpfr::real<MPFR_BITS_PRECISION> sub_xi_xc = 0, sub_yi_yc = 0, sub_ui_uc = 0, sum_ui_uc = 0;
-    for( list<Adjacency *>::iterator it = v->adjList.begin(); it != v->adjList.end(); it++ )
-    {   
-	int vertexNumber = ( (*it)->getVertex(ADJ_VERTEX_ONE) == v ) ? ADJ_VERTEX_TWO : ADJ_VERTEX_ONE;                
-	Vertex *vertexAdj = (*it)->getVertex(vertexNumber);
-	sub_xi_xc = ( vertexAdj->x - v->x ); // Get sum of (x_i - x_c)       
-	sub_yi_yc = ( vertexAdj->y - v->y ); // Get sum of (y_i - y_c)    
-	sub_ui_uc = abs( vertexAdj->u - v->u );// Get sum of (u_i - u_c)        
-	sum_ui_uc = abs( vertexAdj->u + v->u );// Get sum of (u_i - u_c)        
-	sum_x_total += sub_xi_xc * ( sub_ui_uc ) ;
-	sum_y_total += sub_yi_yc * ( sub_ui_uc ) ;
-	sum_u_total += sub_ui_uc;                     
-    }         
-}
-
-void calculatesWeightUpsilon(Vertex *v, mpfr::real<MPFR_BITS_PRECISION> &sum_x_total, mpfr::real<MPFR_BITS_PRECISION> &sum_y_total, mpfr::real<MPFR_BITS_PRECISION> &sum_u_total) 
-{
-    sum_x_total = 0;
-    sum_x_total = 0;
-    sum_u_total = 0;
-    mpfr::real<MPFR_BITS_PRECISION> sub_xi_xc = 0, sub_yi_yc = 0, sub_ui_uc = 0, sum_ui_uc = 0;
-    // Calc new coordinates
-    for( list<Adjacency *>::iterator it = v->adjList.begin(); it != v->adjList.end(); it++ )
-    {   
-	int vertexNumber = ( (*it)->getVertex(ADJ_VERTEX_ONE) == v ) ? ADJ_VERTEX_TWO : ADJ_VERTEX_ONE;                
-	Vertex *vertexAdj = (*it)->getVertex(vertexNumber);
-	sub_xi_xc = ( vertexAdj->x - v->x ); // Get sum of (x_i - x_c)       
-	sub_yi_yc = ( vertexAdj->y - v->y ); // Get sum of (y_i - y_c)    
-	sub_ui_uc = abs( vertexAdj->u - v->u );// Get sum of (u_i - u_c)        
-	sum_ui_uc = abs( vertexAdj->u + v->u );// Get sum of (u_i - u_c)        
-	sum_x_total += sub_xi_xc * ( sub_ui_uc/sum_ui_uc ) ;
-	sum_y_total += sub_yi_yc * ( sub_ui_uc/sum_ui_uc ) ;
-	sum_u_total += sub_ui_uc / sum_ui_uc;                    
-    }     
-}
-
-bool calculatesWeightLaplacianSmoothing(Vertex *v, mpfr::real<MPFR_BITS_PRECISION> &sum_x_total, mpfr::real<MPFR_BITS_PRECISION> &sum_y_total, mpfr::real<MPFR_BITS_PRECISION> &sum_u_total) 
-{
-    sum_x_total = 0;
-    sum_x_total = 0;
-    sum_u_total = 0;
-    mpfr::real<MPFR_BITS_PRECISION> sub_xi_xc = 0, sub_yi_yc = 0, sum_cer_i_cer_c = 0;
-    bool badQuality = false;
-    for( list<Adjacency *>::iterator it = v->adjList.begin(); it != v->adjList.end(); it++ )
-    {   
-	int vertexNumber = ( (*it)->getVertex(ADJ_VERTEX_ONE) == v ) ? ADJ_VERTEX_TWO : ADJ_VERTEX_ONE;                
-	Vertex *vertexAdj = (*it)->getVertex(vertexNumber);
-	Triangle *t1 = (*it)->getTriangle(ADJ_TRIANGLE_ONE);
-	Triangle *t2 = (*it)->getTriangle(ADJ_TRIANGLE_TWO);
-	if ( (t1->shapeRegularityQuality > eta) || (t2->shapeRegularityQuality > eta) ) 
-	  badQuality = true;
-	sub_xi_xc = ( vertexAdj->x - v->x ); // Get sum of (x_i - x_c)       
-	sub_yi_yc = ( vertexAdj->y - v->y ); // Get sum of (y_i - y_c)    
-	sum_cer_i_cer_c = abs( (t1->shapeRegularityQuality) + (t2->shapeRegularityQuality) );// Get sum of (cer_i + cer_c)        
-	sum_x_total += sub_xi_xc * ( sum_cer_i_cer_c ) ;
-	sum_y_total += sub_yi_yc * ( sum_cer_i_cer_c ) ;
-	sum_u_total += sum_cer_i_cer_c;                     
-    }         
-    return badQuality;
-}
-void moveVertices(list<InfoMovingVertex *> &verticesToMoveList) 
-{
-    // Update vertices coordinates        
-    while (!verticesToMoveList.empty()) 
-    {
-	InfoMovingVertex *it = verticesToMoveList.front();    
-	verticesToMoveList.pop_front(); 
-	Vertex *vAux = it->v;
-	vAux->setXY( it->coordinates[COORDINATE_X], it->coordinates[COORDINATE_Y] ); 
-	delete it;
-    }    
-}
-
-InfoMovingVertex *createInfoMovingVertex(Vertex *v, mpfr::real<MPFR_BITS_PRECISION> *newCoordinates) 
-{
-    InfoMovingVertex *mv = new InfoMovingVertex();
-    mv->coordinates = newCoordinates;
-    mv->v = v;  
-    return mv;
-}
-
 void setZero(Mesh *m) 
 {
     Vertex *vertexIterator = m->first;
@@ -1622,6 +1774,12 @@ void clearListOfClocks(list<InfoClock *> l)
         delete (*it);
 }
 
+void clearListOfSolver(list<InfoSolver *> l) 
+{
+    for( list<InfoSolver *>::iterator it = l.begin(); it != l.end(); it++ )
+        delete (*it);
+}
+
 void clearListOfQualityMesh(list<InfoQualityMesh *> l) 
 {
     for( list<InfoQualityMesh *>::iterator it = l.begin(); it != l.end(); it++ )
@@ -1634,6 +1792,35 @@ void clearListOfGradientsMesh(list<InfoGradientMesh *> l)
         delete (*it);
 }
 
+string getInformationOrdering(Mesh *m)
+{
+    long bandwidth = 0, profile = 0, cacheLines = 0;
+    double averageDistance = 0;
+    stringstream information;
+    // The unknowns of the solve in place are the vertices, read through the pointers of the adjacencies
+    Utils::getOrderingStatistics(*m, CONFIG_PRINT_ORDERING_STATISTICS ? sizeof(Vertex) : 0, bandwidth, profile, averageDistance, cacheLines);
+    information << "Largura de banda: " << bandwidth << " Perfil: " << profile << endl;
+    if (CONFIG_PRINT_ORDERING_STATISTICS)
+        information << "Distancia media: " << averageDistance << " Linhas de cache por produto: " << cacheLines << endl;
+    return information.str();
+}
+
+string getInformationInvertedTriangles(vector<Triangle *> &invertedTriangles)
+{
+    stringstream information;
+    information << "Triangulos invertidos: " << invertedTriangles.size() << endl;
+    for (size_t i = 0; i < invertedTriangles.size(); i++)
+    {
+        for (int number = TRIANGLE_VERTEX_ONE; number <= TRIANGLE_VERTEX_THREE; number++)
+        {
+            Vertex *v = invertedTriangles[i]->getVertex(number);
+            information << "(" << v->x << ", " << v->y << ") ";
+        }
+        information << endl;
+    }
+    return information.str();
+}
+
 InfoQualityMesh *getQualityMesh(Mesh *m, int timeStep)
 {
     // Get array of quality
@@ -1690,6 +1877,121 @@ void printInformationQualityMesh(list<InfoQualityMesh *> l, string s)
     outputFile.close();
 }
 
+void printInformationSolver(list<InfoSolver *> l, string s) 
+{
+    bool printHeader = false;
+    if ( !Utils::existingFile(s) ) 
+    {
+        printHeader = true;              
+    }
+    ofstream outputFile;  
+    outputFile.open(s.c_str(), fstream::in | fstream::out | fstream::app);    
+    if (printHeader) 
+    {
+        vector<string> listString;
+        listString.push_back("temporal_iteration");
+        listString.push_back("stage");
+	listString.push_back("number_of_vertices");
+	listString.push_back("number_of_unknowns");
+	listString.push_back("number_of_nonzeros");
+	listString.push_back("method");
+	listString.push_back("bits_precision");
+	listString.push_back("iterations");
+	listString.push_back("converged");
+	listString.push_back("setup_reused");
+	listString.push_back("initial_residual");
+	listString.push_back("final_residual");
+	listString.push_back("wall_time");
+	listString.push_back("cpu_time");
+	listString.push_back("flops");
+	listString.push_back("bytes");
+	listString.push_back("cycles");
+	listString.push_back("instructions");
+	listString.push_back("cache_references");
+	listString.push_back("cache_misses");
+        // Header
+        for( vector<string>::const_iterator it = listString.begin(); it != listString.end(); ++it ) 
+            outputFile << QUOTES << (*it) << QUOTES << COMMA;   
+        outputFile << endl;
+    }
+    // Content
+    outputFile.precision(CONFIG_OUTPUT_PRECISION);   
+    for( list<InfoSolver *>::const_iterator it = l.begin(); it != l.end(); ++it ) 
+    {
+        outputFile << QUOTES << (*it)->temporalIteration << QUOTES << COMMA 
+		   << QUOTES << (*it)->stage << QUOTES << COMMA
+		   << QUOTES << (*it)->numberOfVertices << QUOTES << COMMA
+		   << QUOTES << (*it)->numberOfUnknowns << QUOTES << COMMA
+		   << QUOTES << (*it)->numberOfNonzeros << QUOTES << COMMA
+		   << QUOTES << (*it)->method << QUOTES << COMMA
+		   << QUOTES << (*it)->bitsPrecision << QUOTES << COMMA
+		   << QUOTES << (*it)->numberOfIterations << QUOTES << COMMA
+		   << QUOTES << (*it)->converged << QUOTES << COMMA
+		   << QUOTES << (*it)->setupReused << QUOTES << COMMA
+		   << QUOTES << (*it)->initialResidual << QUOTES << COMMA
+		   << QUOTES << (*it)->finalResidual << QUOTES << COMMA
+		   << QUOTES << (*it)->wallTime << QUOTES << COMMA
+		   << QUOTES << (*it)->cpuTime << QUOTES << COMMA
+		   << QUOTES << (*it)->flops << QUOTES << COMMA
+		   << QUOTES << (*it)->bytes << QUOTES << COMMA
+		   << QUOTES << (*it)->cycles << QUOTES << COMMA
+		   << QUOTES << (*it)->instructions << QUOTES << COMMA
+		   << QUOTES << (*it)->cacheReferences << QUOTES << COMMA
+		   << QUOTES << (*it)->cacheMisses << QUOTES << endl;
+    }
+    outputFile << endl;
+    outputFile.close();
+}
+
+void printInformationSolverJSON(list<InfoSolver *> l, string s) 
+{
+    ofstream outputFile;  
+    outputFile.open(s.c_str(), fstream::out | fstream::trunc);    
+    outputFile.precision(CONFIG_OUTPUT_PRECISION);   
+    outputFile << "[" << endl;
+    for( list<InfoSolver *>::const_iterator it = l.begin(); it != l.end(); ++it ) 
+    {
+        if (it != l.begin())
+            outputFile << "," << endl;
+        outputFile << "  {" 
+		   << QUOTES << "temporal_iteration" << QUOTES << ": " << (*it)->temporalIteration << ", "
+		   << QUOTES << "stage" << QUOTES << ": " << QUOTES << (*it)->stage << QUOTES << ", "
+		   << QUOTES << "number_of_vertices" << QUOTES << ": " << (*it)->numberOfVertices << ", "
+		   << QUOTES << "number_of_unknowns" << QUOTES << ": " << (*it)->numberOfUnknowns << ", "
+		   << QUOTES << "number_of_nonzeros" << QUOTES << ": " << (*it)->numberOfNonzeros << ", "
+		   << QUOTES << "method" << QUOTES << ": " << (*it)->method << ", "
+		   << QUOTES << "bits_precision" << QUOTES << ": " << (*it)->bitsPrecision << ", "
+		   << QUOTES << "iterations" << QUOTES << ": " << (*it)->numberOfIterations << ", "
+		   << QUOTES << "converged" << QUOTES << ": " << ( (*it)->converged ? "true" : "false" ) << ", "
+		   << QUOTES << "setup_reused" << QUOTES << ": " << ( (*it)->setupReused ? "true" : "false" ) << ", "
+		   << QUOTES << "initial_residual" << QUOTES << ": " << getJSONNumber((*it)->initialResidual) << ", "
+		   << QUOTES << "final_residual" << QUOTES << ": " << getJSONNumber((*it)->finalResidual) << ", "
+		   << QUOTES << "wall_time" << QUOTES << ": " << getJSONNumber((*it)->wallTime) << ", "
+		   << QUOTES << "cpu_time" << QUOTES << ": " << getJSONNumber((*it)->cpuTime) << ", "
+		   << QUOTES << "flops" << QUOTES << ": " << getJSONNumber((*it)->flops) << ", "
+		   << QUOTES << "bytes" << QUOTES << ": " << getJSONNumber((*it)->bytes) << ", "
+		   << QUOTES << "cycles" << QUOTES << ": " << (*it)->cycles << ", "
+		   << QUOTES << "instructions" << QUOTES << ": " << (*it)->instructions << ", "
+		   << QUOTES << "cache_references" << QUOTES << ": " << (*it)->cacheReferences << ", "
+		   << QUOTES << "cache_misses" << QUOTES << ": " << (*it)->cacheMisses << ", "
+		   << QUOTES << "residual_history" << QUOTES << ": [";
+        for (size_t i = 0; i < (*it)->residualNorm.size(); i++)
+            outputFile << ( (i > 0) ? ", " : "" ) << getJSONNumber((*it)->residualNorm[i]);
+        outputFile << "]}";
+    }
+    outputFile << endl << "]" << endl;
+    outputFile.close();
+}
+string getJSONNumber(long double value)
+{
+    if ( !isfinite(value) )
+        return "null";
+    stringstream tmp;
+    tmp.precision(CONFIG_OUTPUT_PRECISION);
+    tmp << value;
+    return tmp.str();
+}
+
 void printInformationGradientsMesh(list<InfoGradientMesh *> l, string s) 
 {
     bool printHeader = false;
@@ -1965,6 +2267,22 @@ void readConfigurationsFromFile(string inputFileName)
                 CONFIG_MOVING_MESH_ETA = atof(line.c_str());                 
 		tmp << setw(width) << "CONFIG_MOVING_MESH_ETA: " << setw(width) << CONFIG_MOVING_MESH_ETA << endl;
                 continue;
+            }
+            found_position = line.find("CONFIG_MOVING_MESH_SOLVE_DISPLACEMENT "); 
+            if (found_position != string::npos)
+            {
+                line.erase(found_position, 38);     
+                CONFIG_MOVING_MESH_SOLVE_DISPLACEMENT = atof(line.c_str());                 
+		tmp << setw(width) << "CONFIG_MOVING_MESH_SOLVE_DISPLACEMENT: " << setw(width) << CONFIG_MOVING_MESH_SOLVE_DISPLACEMENT << endl;
+                continue;
+            }    
+            found_position = line.find("CONFIG_MOVING_MESH_FIXED_POINT_TOLERANCE "); 
+            if (found_position != string::npos)
+            {
+                line.erase(found_position, 41);     
+                CONFIG_MOVING_MESH_FIXED_POINT_TOLERANCE = atof(line.c_str());                 
+		tmp << setw(width) << "CONFIG_MOVING_MESH_FIXED_POINT_TOLERANCE: " << setw(width) << CONFIG_MOVING_MESH_FIXED_POINT_TOLERANCE << endl;
+                continue;
             }    
             found_position = line.find("CONFIG_CG_PRESICION_EPSILON "); 
             if (found_position != string::npos)
@@ -1973,6 +2291,102 @@ void readConfigurationsFromFile(string inputFileName)
                 CONFIG_CG_PRESICION_EPSILON = atof(line.c_str());                 
 		tmp << setw(width) << "CONFIG_CG_PRESICION_EPSILON: " << setw(width) << CONFIG_CG_PRESICION_EPSILON << endl;
                 continue;
+            }
+            found_position = line.find("CONFIG_PRECISION_SOLVER "); 
+            if (found_position != string::npos)
+            {
+                line.erase(found_position, 24);     
+                CONFIG_PRECISION_SOLVER = atoi(line.c_str());                 
+		tmp << setw(width) << "CONFIG_PRECISION_SOLVER: " << setw(width) << CONFIG_PRECISION_SOLVER << endl;
+                continue;
+            }
+            found_position = line.find("CONFIG_CG_METHOD "); 
+            if (found_position != string::npos)
+            {
+                line.erase(found_position, 17);     
+                CONFIG_CG_METHOD = atoi(line.c_str());                 
+		tmp << setw(width) << "CONFIG_CG_METHOD: " << setw(width) << CONFIG_CG_METHOD << endl;
+                continue;
+            }
+            found_position = line.find("CONFIG_CG_THREADS "); 
+            if (found_position != string::npos)
+            {
+                line.erase(found_position, 18);     
+                CONFIG_CG_THREADS = atoi(line.c_str());                 
+		tmp << setw(width) << "CONFIG_CG_THREADS: " << setw(width) << CONFIG_CG_THREADS << endl;
+                continue;
+            }
+            found_position = line.find("CONFIG_MOVING_MESH_THREADS "); 
+            if (found_position != string::npos)
+            {
+                line.erase(found_position, 27);     
+                CONFIG_MOVING_MESH_THREADS = atoi(line.c_str());                 
+		tmp << setw(width) << "CONFIG_MOVING_MESH_THREADS: " << setw(width) << CONFIG_MOVING_MESH_THREADS << endl;
+                continue;
+            }
+            found_position = line.find("CONFIG_MOVING_MESH_ANDERSON_DEPTH "); 
+            if (found_position != string::npos)
+            {
+                line.erase(found_position, 34);     
+                CONFIG_MOVING_MESH_ANDERSON_DEPTH = atoi(line.c_str());                 
+		tmp << setw(width) << "CONFIG_MOVING_MESH_ANDERSON_DEPTH: " << setw(width) << CONFIG_MOVING_MESH_ANDERSON_DEPTH << endl;
+                continue;
+            }
+            found_position = line.find("CONFIG_MOVING_MESH_LAGGED_MOVEMENTS "); 
+            if (found_position != string::npos)
+            {
+                line.erase(found_position, 36);     
+                CONFIG_MOVING_MESH_LAGGED_MOVEMENTS = atoi(line.c_str());                 
+		tmp << setw(width) << "CONFIG_MOVING_MESH_LAGGED_MOVEMENTS: " << setw(width) << CONFIG_MOVING_MESH_LAGGED_MOVEMENTS << endl;
+                continue;
+            }
+            found_position = line.find("CONFIG_CG_CRITERION "); 
+            if (found_position != string::npos)
+            {
+                line.erase(found_position, 20);     
+                CONFIG_CG_CRITERION = atoi(line.c_str());                 
+		tmp << setw(width) << "CONFIG_CG_CRITERION: " << setw(width) << CONFIG_CG_CRITERION << endl;
+                continue;
+            }                            
+            found_position = line.find("CONFIG_MULTIGRID_CYCLE "); 
+            if (found_position != string::npos)
+            {
+                line.erase(found_position, 23);     
+                CONFIG_MULTIGRID_CYCLE = atoi(line.c_str());                 
+		tmp << setw(width) << "CONFIG_MULTIGRID_CYCLE: " << setw(width) << CONFIG_MULTIGRID_CYCLE << endl;
+                continue;
+            }                            
+            found_position = line.find("CONFIG_MULTIGRID_COARSENING "); 
+            if (found_position != string::npos)
+            {
+                line.erase(found_position, 28);     
+                CONFIG_MULTIGRID_COARSENING = atoi(line.c_str());                 
+		tmp << setw(width) << "CONFIG_MULTIGRID_COARSENING: " << setw(width) << CONFIG_MULTIGRID_COARSENING << endl;
+                continue;
+            }                            
+            found_position = line.find("CONFIG_MULTIGRID_SMOOTHER "); 
+            if (found_position != string::npos)
+            {
+                line.erase(found_position, 26);     
+                CONFIG_MULTIGRID_SMOOTHER = atoi(line.c_str());                 
+		tmp << setw(width) << "CONFIG_MULTIGRID_SMOOTHER: " << setw(width) << CONFIG_MULTIGRID_SMOOTHER << endl;
+                continue;
+            }                            
+            found_position = line.find("CONFIG_CHOLESKY_KEEP_FACTOR "); 
+            if (found_position != string::npos)
+            {
+                line.erase(found_position, 28);     
+                CONFIG_CHOLESKY_KEEP_FACTOR = !line.compare("true") ? true : false;
+		tmp << setw(width) << "CONFIG_CHOLESKY_KEEP_FACTOR: " << setw(width) << CONFIG_CHOLESKY_KEEP_FACTOR << endl;    
+                continue;                
+            }                        
+            found_position = line.find("CONFIG_CG_DEFLATION_VECTORS "); 
+            if (found_position != string::npos)
+            {
+                line.erase(found_position, 28);     
+                CONFIG_CG_DEFLATION_VECTORS = atoi(line.c_str());                 
+		tmp << setw(width) << "CONFIG_CG_DEFLATION_VECTORS: " << setw(width) << CONFIG_CG_DEFLATION_VECTORS << endl;
+                continue;
             }                            
             // Boundary conditions
             found_position = line.find("CONFIG_BNDR_CONDITION_BOTTOM_CORNERS "); 
@@ -2111,6 +2525,30 @@ void readConfigurationsFromFile(string inputFileName)
                 CONFIG_PRINT_CLOCKS_VALUES = !line.compare("true") ? true : false;
 		tmp << setw(width) << "CONFIG_PRINT_CLOCKS_VALUES: " << setw(width) << CONFIG_PRINT_CLOCKS_VALUES << endl;
                 continue;
+            }
+            found_position = line.find("CONFIG_PRINT_SOLVER_STATISTICS "); 
+            if (found_position != string::npos)
+            {
+                line.erase(found_position, 31);     
+                CONFIG_PRINT_SOLVER_STATISTICS = !line.compare("true") ? true : false;
+		tmp << setw(width) << "CONFIG_PRINT_SOLVER_STATISTICS: " << setw(width) << CONFIG_PRINT_SOLVER_STATISTICS << endl;
+                continue;
+            }
+            found_position = line.find("CONFIG_PRINT_HARDWARE_COUNTERS "); 
+            if (found_position != string::npos)
+            {
+                line.erase(found_position, 31);     
+                CONFIG_PRINT_HARDWARE_COUNTERS = !line.compare("true") ? true : false;
+		tmp << setw(width) << "CONFIG_PRINT_HARDWARE_COUNTERS: " << setw(width) << CONFIG_PRINT_HARDWARE_COUNTERS << endl;
+                continue;
+            }
+            found_position = line.find("CONFIG_PRINT_ORDERING_STATISTICS "); 
+            if (found_position != string::npos)
+            {
+                line.erase(found_position, 33);     
+                CONFIG_PRINT_ORDERING_STATISTICS = !line.compare("true") ? true : false;
+		tmp << setw(width) << "CONFIG_PRINT_ORDERING_STATISTICS: " << setw(width) << CONFIG_PRINT_ORDERING_STATISTICS << endl;
+                continue;
             }                                         
             found_position = line.find("CONFIG_PRINT_VERTEX_VALUE "); 
             if (found_position != string::npos)
@@ -2175,6 +2613,39 @@ void readConfigurationsFromFile(string inputFileName)
                 CONFIG_CUTHILL_MCKEE_REVERSE = !line.compare("true") ? true : false;
 		tmp << setw(width) << "CONFIG_CUTHILL_MCKEE_REVERSE: " << setw(width) << CONFIG_CUTHILL_MCKEE_REVERSE << endl;    
                 continue;                
+            }
+            found_position = line.find("CONFIG_MESH_ORDERING "); 
+            if (found_position != string::npos)
+            {
+                line.erase(found_position, 21);     
+                CONFIG_MESH_ORDERING = atoi(line.c_str());
+		tmp << setw(width) << "CONFIG_MESH_ORDERING: " << setw(width) << CONFIG_MESH_ORDERING << endl;    
+                continue;
+            }
+            found_position = line.find("CONFIG_RENUMBER_VERTICES "); 
+            if (found_position != string::npos)
+            {
+                line.erase(found_position, 25);     
+                CONFIG_RENUMBER_VERTICES = !line.compare("true") ? true : false;
+		tmp << setw(width) << "CONFIG_RENUMBER_VERTICES: " << setw(width) << CONFIG_RENUMBER_VERTICES << endl;    
+                continue;                
+            }                               
+            // string values  
+            found_position = line.find("CONFIG_OUTPUT_MAIN_FILE "); 
+            if (found_position != string::npos)
+            {
+                line.erase(found_position, 24);     
+                CONFIG_OUTPUT_MAIN_FILE = line;
+		tmp << setw(width) << "CONFIG_OUTPUT_MAIN_FILE: " << setw(width) << CONFIG_OUTPUT_MAIN_FILE << endl;
+                continue;
+            }
+            found_position = line.find("CONFIG_MOVING_MESH_ROLLBACK "); 
+            if (found_position != string::npos)
+            {
+                line.erase(found_position, 28);     
+                CONFIG_MOVING_MESH_ROLLBACK = !line.compare("true") ? true : false;
+		tmp << setw(width) << "CONFIG_MOVING_MESH_ROLLBACK: " << setw(width) << CONFIG_MOVING_MESH_ROLLBACK << endl;    
+                continue;                
             }                               
             // string values  
             found_position = line.find("CONFIG_OUTPUT_MAIN_FILE "); 
@@ -2352,6 +2823,22 @@ void readConfigurationsFromFile(string inputFileName)
                 CONFIG_OUTPUT_FILE_CLOCK_MM = line;
 		tmp << setw(width) << "CONFIG_OUTPUT_FILE_CLOCK_MM: " << setw(width) << CONFIG_OUTPUT_FILE_CLOCK_MM << endl;    
                 continue;
+            }
+            found_position = line.find("CONFIG_OUTPUT_FILE_SOLVER_CSV "); 
+            if (found_position != string::npos)
+            {
+                line.erase(found_position, 30);     
+                CONFIG_OUTPUT_FILE_SOLVER_CSV = line;
+		tmp << setw(width) << "CONFIG_OUTPUT_FILE_SOLVER_CSV: " << setw(width) << CONFIG_OUTPUT_FILE_SOLVER_CSV << endl;    
+                continue;
+            }
+            found_position = line.find("CONFIG_OUTPUT_FILE_SOLVER_JSON "); 
+            if (found_position != string::npos)
+            {
+                line.erase(found_position, 31);     
+                CONFIG_OUTPUT_FILE_SOLVER_JSON = line;
+		tmp << setw(width) << "CONFIG_OUTPUT_FILE_SOLVER_JSON: " << setw(width) << CONFIG_OUTPUT_FILE_SOLVER_JSON << endl;    
+                continue;
             }                
             cerr << "ERROR - unknown configuration variable \"" << line << "\"" << endl;
             exit(EXIT_FAILURE);                                   